@@ -3,7 +3,9 @@
 
 #include <http/base/traits.hxx>
 
-#include <string>
+#include <boost/beast/core/string.hpp>
+#include <boost/container/small_vector.hpp>
+
 #include <iterator>
 
 #define BEASTHTTP_DECLARE_STORAGE_TEMPLATE \
@@ -24,6 +26,31 @@ namespace http {
 namespace base {
 namespace cb {
 
+/**
+  @brief State of one request walking a chain of handlers
+
+  Kept by the executor for as long as the chain runs and reached through
+  every copy of the iterator, so a handler continuing the chain from
+  another thread still finds it. The original target is copied here once
+  per request and the iterators walk slices of it. A param::pack route
+  keeps the captures of the request here.
+*/
+struct chain
+{
+    /// Targets up to this length are chained without heap allocation
+    static constexpr std::size_t target_capacity = 128;
+
+    boost::container::small_vector<char, target_capacity> target;
+    void const* owner = nullptr;
+    void* block = nullptr;
+
+}; // struct chain
+
+/// Handed to the last handler of a chain, when it takes the iterator too
+struct last_hop
+{
+};
+
 class executor
 {
 protected:
@@ -50,7 +77,7 @@ struct const_iterator
 
     using request_type = typename session_type::request_type;
 
-    using entry_type = Entry<void (request_type, session_context, self_type)>;
+    using entry_type = Entry<void (request_type&, session_context, self_type)>;
 
     using container_type = Container<entry_type>;
 
@@ -58,6 +85,8 @@ struct const_iterator
 
     using size_type = typename container_type::size_type;
 
+    using string_view_type = boost::beast::string_view;
+
     // iterator_traits
     using iterator_category = std::input_iterator_tag;
 
@@ -72,7 +101,7 @@ struct const_iterator
 
 public:
 
-    const_iterator(const container_type&, request_type&, session_flesh&);
+    const_iterator(const container_type&, request_type&, session_flesh&, cb::chain&);
 
     self_type&
     operator++();
@@ -86,6 +115,13 @@ public:
     inline size_type
     pos() const;
 
+    inline cb::chain&
+    chain() const;
+
+    /// The target of the current handler, stable for the whole chain
+    inline string_view_type
+    target() const;
+
 private:
     void
     skip_target();
@@ -95,7 +131,9 @@ private:
     container_iterator cont_end_iter_;
     request_type& request_;
     session_flesh& session_flesh_;
-    std::string current_target_;
+    cb::chain* chain_;
+    string_view_type target_;
+    std::size_t target_pos_;
 
 }; // struct iterator
 
@@ -118,7 +156,7 @@ public:
 
     using iterator_type = cb::const_iterator<Session, Entry, Container>;
 
-    using entry_type = Entry<void (request_type, session_context, iterator_type)>;
+    using entry_type = Entry<void (request_type&, session_context, iterator_type)>;
 
     using container_type = Container<entry_type>;
 
@@ -135,8 +173,8 @@ public:
              typename = typename std::enable_if<
                  not std::is_same<typename std::decay<F>::type, self_type>::value
                  && traits::TryInvokeConjunction<
-                     sizeof... (Fn), void (request_type, session_context, iterator_type),
-                     void (request_type, session_context), F, Fn...>::value
+                     sizeof... (Fn), void (request_type&, session_context, iterator_type),
+                     void (request_type&, session_context), F, Fn...>::value
                  >::type
              >
     storage(F&&, Fn&&...);
@@ -148,7 +186,7 @@ private:
     prepare(OnRequest&&...);
 
     iterator_type
-    begin_exec(request_type&, session_flesh&);
+    begin_exec(request_type&, session_flesh&, cb::chain&);
 
     container_type container_;
 
@@ -27,6 +27,22 @@
 #ifndef BOOST_NO_CXX17_IF_CONSTEXPR
 #define BEASTHTTP_CXX17_IF_CONSTEXPR
 #endif // BOOST_NO_CXX17_IF_CONSTEXPR
+
+#if __has_include(<charconv>)
+#define BEASTHTTP_CXX17_CHARCONV
+#endif // __has_include(<charconv>)
+
+// std::from_chars for floating point types came later than the integer one
+#if __has_include(<version>)
+#include <version>
+#ifdef __cpp_lib_to_chars
+#define BEASTHTTP_CXX17_FLOATING_CHARCONV
+#endif // __cpp_lib_to_chars
+#endif // __has_include(<version>)
 #endif // __cplusplus >= 201703L
 
+#if defined(__GNUC__) || defined(__clang__)
+#define BEASTHTTP_STRING_LITERAL_TEMPLATE
+#endif // defined(__GNUC__) || defined(__clang__)
+
 #endif // BEASTHTTP_BASE_CONFIG_HXX
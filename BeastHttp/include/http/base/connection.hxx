@@ -31,10 +31,18 @@ public:
     void
     async_write(Serializer&, Function&&);
 
+    template <class Function, class ConstBufferSequence>
+    void
+    async_write_buffers(ConstBufferSequence const&, Function&&);
+
     template <class Function, class Buffer, class Parser>
     void
     async_read(Buffer&, Parser&, Function&&);
 
+    template <class Function, class WaitType>
+    void
+    async_wait(WaitType, Function&&);
+
     template<class Serializer>
     boost::beast::error_code
     write(Serializer&);
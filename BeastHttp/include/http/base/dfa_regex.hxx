@@ -0,0 +1,255 @@
+#ifndef BEASTHTTP_BASE_DFA_REGEX_HXX
+#define BEASTHTTP_BASE_DFA_REGEX_HXX
+
+#include <http/base/regex.hxx>
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+/**
+  @brief Multi-pattern regex backend
+
+  Drop-in replacement for base::regex. Each pattern is parsed into an
+  NFA at compile time. match_all() unions the NFAs of every route in a
+  resource map and runs a lazily built DFA over the target, so all
+  matching routes are found in a single scan. The automaton is cached
+  per thread, by the address of the map, and rebuilt whenever any
+  pattern has been compiled or invalidate() called since.
+  Patterns outside the supported ECMAScript subset (back references,
+  assertions other than ^ and $, POSIX classes, non-ECMAScript grammars)
+  are matched sequentially with std::regex.
+*/
+class dfa_regex
+{
+    using self_type = dfa_regex;
+
+    struct nfa;
+
+    struct node;
+
+    class parser;
+
+    struct automaton;
+
+public:
+
+    using char_type = regex::char_type;
+
+    using traits_type = regex::traits_type;
+
+    using regex_type = regex::regex_type;
+
+    using flag_type = regex::flag_type;
+
+    using string_view_type = regex::string_view_type;
+
+    class compiled_type
+    {
+        friend class dfa_regex;
+
+    public:
+
+        regex_type const&
+        expression() const
+        {
+            return expression_;
+        }
+
+    private:
+
+        regex_type expression_;
+        std::shared_ptr<nfa const> nfa_;
+
+    }; // class compiled_type
+
+    inline dfa_regex(flag_type);
+
+    inline flag_type
+    flags() const;
+
+    inline compiled_type
+    compile(const std::string&) const;
+
+    inline bool
+    match(const std::string&, const std::string&);
+
+    inline bool
+    match(const std::string&, const std::string&, std::smatch&);
+
+    inline bool
+    match(const compiled_type&, string_view_type) const;
+
+    inline bool
+    match(const compiled_type&, const std::string&, std::smatch&) const;
+
+    inline bool
+    match(const compiled_type&, string_view_type, std::cmatch&) const;
+
+    /**
+      @brief Drops the automatons cached on every thread
+
+      A map copied without compiling a pattern, as base::router does when
+      it publishes a snapshot, may take the address of a map freed before;
+      the automaton cached for that one must not be used for it.
+    */
+    static inline void
+    invalidate();
+
+    /// Invokes f(value_type const&) for each route of the map matching target
+    template<class ResourceMap, class F>
+    bool
+    match_all(ResourceMap const&, string_view_type, F&&) const;
+
+private:
+
+    struct nfa
+    {
+        enum kind_type { chars, split, begin, end, accept };
+
+        struct state
+        {
+            kind_type kind;
+            std::bitset<256> set;
+            std::vector<int> out;
+            std::size_t index;
+        };
+
+        std::vector<state> states;
+        int start;
+    };
+
+    struct node
+    {
+        enum kind_type { chars, concat, alternate, repeat, begin, end };
+
+        kind_type kind;
+        std::bitset<256> set;
+        std::vector<node> children;
+        int min;
+        int max;
+    };
+
+    class parser
+    {
+    public:
+
+        inline parser(const std::string&, bool);
+
+        inline bool
+        parse(node&);
+
+    private:
+
+        inline bool
+        parse_alternate(node&);
+
+        inline bool
+        parse_concat(node&);
+
+        inline bool
+        parse_repeat(node&);
+
+        inline bool
+        parse_bounds(int&, int&);
+
+        inline bool
+        parse_atom(node&);
+
+        inline bool
+        parse_class(node&);
+
+        inline bool
+        parse_escape(std::bitset<256>&, bool, int&);
+
+        inline void
+        fold(std::bitset<256>&) const;
+
+        const std::string& pattern_;
+        std::size_t pos_;
+        bool icase_;
+
+    }; // class parser
+
+    struct automaton
+    {
+        struct dstate
+        {
+            std::vector<int> set;
+            std::array<int, 256> next;
+            bool final_ready;
+            std::vector<std::size_t> accepts;
+        };
+
+        inline void
+        build(std::vector<nfa const*> const&);
+
+        inline std::vector<std::size_t> const&
+        run(string_view_type);
+
+        inline void
+        closure(std::vector<int>&, bool, bool, std::vector<int>&) const;
+
+        inline int
+        add(std::vector<int>&&);
+
+        inline void
+        reset();
+
+        inline int
+        transition(int, unsigned char);
+
+        inline std::vector<std::size_t> const&
+        accepts(int);
+
+        std::size_t generation = 0;
+        std::vector<void const*> entries;
+        std::vector<std::size_t> sequential;
+        std::vector<nfa::state> states;
+        std::vector<int> starts;
+        std::vector<dstate> dstates;
+        std::map<std::vector<int>, int> dindex;
+        std::vector<std::size_t> scratch;
+        int start = -1;
+    };
+
+    static constexpr int max_repeat = 256;
+
+    static constexpr std::size_t max_nfa_states = 8192;
+
+    static constexpr std::size_t max_dfa_states = 1024;
+
+    static constexpr std::size_t max_cached_maps = 64;
+
+    static inline std::shared_ptr<nfa const>
+    build(const std::string&, flag_type);
+
+    static inline int
+    emit(node const&, int, std::vector<nfa::state>&);
+
+    static inline std::atomic<std::size_t>&
+    generation();
+
+    static inline automaton&
+    cache(void const*);
+
+    regex sequential_;
+
+}; // class dfa_regex
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/dfa_regex.hxx>
+
+#endif // not defined BEASTHTTP_BASE_DFA_REGEX_HXX
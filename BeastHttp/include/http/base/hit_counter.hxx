@@ -0,0 +1,70 @@
+#ifndef BEASTHTTP_BASE_HIT_COUNTER_HXX
+#define BEASTHTTP_BASE_HIT_COUNTER_HXX
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+/**
+  @brief Hit counter of a route, bumped from many threads
+
+  Every thread adds to a slot of its own, written by that thread only, so
+  counting a hit never bounces a cache line between the I/O threads. The
+  slots are summed by value(), which only reorder() calls. A slot outlives
+  its thread, the hits of a finished thread are kept.
+*/
+class hit_counter
+{
+    using self_type = hit_counter;
+
+public:
+
+    inline
+    hit_counter();
+
+    hit_counter(self_type const&) = delete;
+
+    self_type&
+    operator=(self_type const&) = delete;
+
+    inline void
+    hit() const;
+
+    inline std::size_t
+    value() const;
+
+private:
+
+    // Padded to a cache line of its own
+    struct slot
+    {
+        std::atomic<std::size_t> value{0};
+        char padding[64 - sizeof (std::atomic<std::size_t>)];
+    };
+
+    inline slot&
+    local() const;
+
+    inline static std::uint64_t
+    next_id();
+
+    std::uint64_t const id_;
+    mutable std::mutex mutex_;
+    mutable std::vector<std::shared_ptr<slot>> slots_;
+
+}; // class hit_counter
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/hit_counter.hxx>
+
+#endif // not defined BEASTHTTP_BASE_HIT_COUNTER_HXX
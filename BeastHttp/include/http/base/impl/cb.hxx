@@ -9,6 +9,7 @@ namespace _0xdead4ead {
 namespace http {
 namespace base {
 namespace cb {
+
 namespace detail {
 #ifndef BEASTHTTP_CXX17_IF_CONSTEXPR
 template<std::size_t value>
@@ -74,6 +75,43 @@ for_each(const std::tuple<Elements...>& tpl,
 }
 #endif // BEASTHTTP_CXX17_IF_CONSTEXPR
 
+// The last handler of a chain takes no iterator, unless it reads the
+// state of the chain, as a param::pack handler does
+template<class F>
+struct cb_fin
+{
+    F f_;
+
+    template<class Request, class Context, class Iterator>
+    void
+    operator()(Request& request, Context&& context, Iterator&& it)
+    {
+        call(f_, request, std::forward<Context>(context), it, 0);
+    }
+
+    template<class G, class Request, class Context, class Iterator>
+    static auto
+    call(G& f, Request& request, Context&& context, Iterator& it, int)
+    -> decltype (f(request, std::forward<Context>(context), it, last_hop{}), void())
+    {
+        f(request, std::forward<Context>(context), it, last_hop{});
+    }
+
+    template<class G, class Request, class Context, class Iterator>
+    static void
+    call(G& f, Request& request, Context&& context, Iterator&, long)
+    {
+        f(request, std::forward<Context>(context));
+    }
+}; // struct cb_fin
+
+template<class F>
+cb_fin<F>
+make_cb_fin(const F& f)
+{
+    return cb_fin<F>{f};
+}
+
 #ifndef BEASTHTTP_CXX14_GENERIC_LAMBDAS
 template<class Container>
 struct cb_push_cxx11
@@ -93,13 +131,7 @@ struct cb_push_cxx11
     void
     operator()(const F& value) const
     {
-        l_.push_back(
-                    value_type(
-                        std::bind<void>(
-                            value,
-                            std::placeholders::_1,
-                            std::placeholders::_2,
-                            std::placeholders::_3)));
+        l_.push_back(value_type(value));
     }
 }; // struct cb_push_cxx11
 
@@ -121,12 +153,7 @@ struct cb_push_fin_cxx11
     void
     operator()(const F& value) const
     {
-        l_.push_back(
-                    value_type(
-                        std::bind<void>(
-                            value,
-                            std::placeholders::_1,
-                            std::placeholders::_2)));
+        l_.push_back(value_type(make_cb_fin(value)));
     }
 }; // struct cb_push_fin_cxx11
 
@@ -139,22 +166,29 @@ executor::execute(Request& request,
                   SessionFlesh& session_flesh,
                   Storage& storage)
 {
-    storage.begin_exec(request, session_flesh)();
+    cb::chain chain;
+    storage.begin_exec(request, session_flesh, chain)();
 }
 
 BEASTHTTP_DECLARE_STORAGE_TEMPLATE
 const_iterator<Session, Entry, Container>::const_iterator(
         const container_type& container, request_type& request,
-        session_flesh& flesh)
+        session_flesh& flesh, cb::chain& chain)
     : pos_{0},
       cont_begin_iter_{container.begin()},
       cont_end_iter_{container.end()},
       request_{request},
       session_flesh_{flesh},
-      current_target_{request_.target().to_string()}
+      chain_{&chain},
+      target_pos_{0}
 {
-    if (container.size() > 1)
+    // The request target is rewritten on every hop, so a chain walks the
+    // copy of the original one kept in its state
+    if (container.size() > 1) {
+        const auto target = request_.target();
+        chain.target.assign(target.begin(), target.end());
         skip_target();
+    }
 }
 
 BEASTHTTP_DECLARE_STORAGE_TEMPLATE
@@ -193,16 +227,23 @@ BEASTHTTP_DECLARE_STORAGE_TEMPLATE
 void
 const_iterator<Session, Entry, Container>::skip_target()
 {
-    std::size_t pos = current_target_.find('/', 1);
+    const auto& target = chain_->target;
+    if (target.empty())
+        return;
+
+    const string_view_type current_target{
+        target.data() + target_pos_, target.size() - target_pos_};
 
-    if (pos != std::string::npos) {
-        auto next_target = current_target_.substr(0, pos);
-        current_target_ = current_target_.substr(pos);
+    std::size_t pos = current_target.find('/', 1);
 
-        request_.target(next_target);
+    if (pos != string_view_type::npos) {
+        target_ = current_target.substr(0, pos);
+        target_pos_ += pos;
     }
     else
-        request_.target(current_target_);
+        target_ = current_target;
+
+    request_.target(target_);
 }
 
 BEASTHTTP_DECLARE_STORAGE_TEMPLATE
@@ -212,6 +253,20 @@ const_iterator<Session, Entry, Container>::pos() const
     return pos_;
 }
 
+BEASTHTTP_DECLARE_STORAGE_TEMPLATE
+cb::chain&
+const_iterator<Session, Entry, Container>::chain() const
+{
+    return *chain_;
+}
+
+BEASTHTTP_DECLARE_STORAGE_TEMPLATE
+typename const_iterator<Session, Entry, Container>::string_view_type
+const_iterator<Session, Entry, Container>::target() const
+{
+    return chain_->target.empty() ? request_.target() : target_;
+}
+
 BEASTHTTP_DECLARE_STORAGE_TEMPLATE
 template<class F, class... Fn, typename>
 storage<Session, Entry, Container>::storage(F&& f, Fn&&... fn)
@@ -241,20 +296,9 @@ storage<Session, Entry, Container>::prepare(OnRequest&&... on_request)
 #else
     detail::for_each<0>(tuple_cb,
                         [&_l](const auto& value){
-        _l.push_back(
-                    entry_type(
-                        std::bind<void>(
-                            value,
-                            std::placeholders::_1,
-                            std::placeholders::_2,
-                            std::placeholders::_3)));},
+        _l.push_back(entry_type(value));},
                       [&_l](const auto & value){
-        _l.push_back(
-                    entry_type(
-                        std::bind<void>(
-                            value,
-                            std::placeholders::_1,
-                            std::placeholders::_2)));});
+        _l.push_back(entry_type(detail::make_cb_fin(value)));});
 #endif // BEASTHTTP_CXX14_GENERIC_LAMBDAS
     return _l;
 }
@@ -262,9 +306,9 @@ storage<Session, Entry, Container>::prepare(OnRequest&&... on_request)
 BEASTHTTP_DECLARE_STORAGE_TEMPLATE
 typename storage<Session, Entry, Container>::iterator_type
 storage<Session, Entry, Container>::begin_exec(
-        request_type& request, session_flesh& flesh)
+        request_type& request, session_flesh& flesh, cb::chain& chain)
 {
-    return iterator_type(container_, request, flesh);
+    return iterator_type(container_, request, flesh, chain);
 }
 
 } // namespace cb
@@ -2,6 +2,7 @@
 #define BEASTHTTP_BASE_IMPL_CONNECTION_HXX
 
 #include <boost/asio/bind_executor.hpp>
+#include <boost/asio/write.hpp>
 #include <boost/beast/http/write.hpp>
 #include <boost/beast/http/read.hpp>
 
@@ -25,6 +26,16 @@ connection<Derived, CompletionExecutor>::async_write(Serializer& serializer, Fun
                                        completion_executor_, std::forward<Function>(function)));
 }
 
+template<class Derived, class CompletionExecutor>
+template <class Function, class ConstBufferSequence>
+void
+connection<Derived, CompletionExecutor>::async_write_buffers(ConstBufferSequence const& buffers, Function&& function)
+{
+    boost::asio::async_write(derived().stream(), buffers,
+                             boost::asio::bind_executor(
+                                 completion_executor_, std::forward<Function>(function)));
+}
+
 template<class Derived, class CompletionExecutor>
 template <class Function, class Buffer, class Parser>
 void
@@ -35,6 +46,16 @@ connection<Derived, CompletionExecutor>::async_read(Buffer& buffer, Parser& pars
                                        completion_executor_, std::forward<Function>(function)));
 }
 
+template<class Derived, class CompletionExecutor>
+template <class Function, class WaitType>
+void
+connection<Derived, CompletionExecutor>::async_wait(WaitType type, Function&& function)
+{
+    derived().stream().async_wait(type,
+                                  boost::asio::bind_executor(
+                                      completion_executor_, std::forward<Function>(function)));
+}
+
 template<class Derived, class CompletionExecutor>
 template<class Serializer>
 boost::beast::error_code
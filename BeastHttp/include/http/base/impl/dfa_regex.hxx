@@ -0,0 +1,764 @@
+#ifndef BEASTHTTP_BASE_IMPL_DFA_REGEX_HXX
+#define BEASTHTTP_BASE_IMPL_DFA_REGEX_HXX
+
+#include <algorithm>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+dfa_regex::dfa_regex(flag_type flags)
+    : sequential_{flags}
+{
+}
+
+dfa_regex::flag_type
+dfa_regex::flags() const
+{
+    return sequential_.flags();
+}
+
+dfa_regex::compiled_type
+dfa_regex::compile(const std::string& regx) const
+{
+    const std::string expanded = sequential_.expand(regx);
+
+    compiled_type result;
+    result.expression_ = regex_type(expanded, flags());
+    result.nfa_ = build(expanded, flags());
+
+    generation().fetch_add(1, std::memory_order_release);
+
+    return result;
+}
+
+bool
+dfa_regex::match(const std::string& regx, const std::string& str)
+{
+    return sequential_.match(regx, str);
+}
+
+bool
+dfa_regex::match(const std::string& regx, const std::string& str,
+      std::smatch& results)
+{
+    return sequential_.match(regx, str, results);
+}
+
+bool
+dfa_regex::match(const compiled_type& e, string_view_type str) const
+{
+    return std::regex_match(str.begin(), str.end(), e.expression_);
+}
+
+bool
+dfa_regex::match(const compiled_type& e, const std::string& str,
+      std::smatch& results) const
+{
+    return std::regex_match(str, results, e.expression_);
+}
+
+bool
+dfa_regex::match(const compiled_type& e, string_view_type str,
+      std::cmatch& results) const
+{
+    return std::regex_match(str.begin(), str.end(), results, e.expression_);
+}
+
+void
+dfa_regex::invalidate()
+{
+    generation().fetch_add(1, std::memory_order_release);
+}
+
+template<class ResourceMap, class F>
+bool
+dfa_regex::match_all(ResourceMap const& resource_map,
+                     string_view_type target, F&& f) const
+{
+    using value_type = typename ResourceMap::value_type;
+
+    automaton& a = cache(&resource_map);
+
+    const std::size_t current = generation().load(std::memory_order_acquire);
+    if (a.generation != current or a.entries.size() != resource_map.size()) {
+        std::vector<nfa const*> programs;
+        a.entries.clear();
+        a.sequential.clear();
+
+        for (const auto& value : resource_map) {
+            const auto& compiled = value.second.regex();
+            if (not compiled.nfa_)
+                a.sequential.push_back(a.entries.size());
+
+            a.entries.push_back(&value);
+            programs.push_back(compiled.nfa_.get());
+        }
+
+        a.build(programs);
+        a.generation = current;
+    }
+
+    const auto& accepted = a.run(target);
+
+    // Visit both sets in map order, as the sequential scan does
+    bool invoked = false;
+    auto it_a = accepted.cbegin();
+    auto it_s = a.sequential.cbegin();
+    while (it_a != accepted.cend() or it_s != a.sequential.cend()) {
+        std::size_t index;
+        if (it_s == a.sequential.cend() or
+                (it_a != accepted.cend() and *it_a < *it_s))
+            index = *it_a++;
+        else {
+            index = *it_s++;
+            auto const& value = *static_cast<value_type const*>(a.entries[index]);
+            if (not std::regex_match(target.begin(), target.end(),
+                                     value.second.regex().expression_))
+                continue;
+        }
+
+        f(*static_cast<value_type const*>(a.entries[index]));
+        invoked = true;
+    }
+
+    return invoked;
+}
+
+std::shared_ptr<dfa_regex::nfa const>
+dfa_regex::build(const std::string& regx, flag_type flags)
+{
+    const flag_type supported = std::regex_constants::ECMAScript |
+            std::regex_constants::icase | std::regex_constants::nosubs |
+            std::regex_constants::optimize;
+
+    if ((flags & ~supported) != flag_type{})
+        return nullptr;
+
+    node root;
+    parser p{regx, (flags & std::regex_constants::icase) != flag_type{}};
+    if (not p.parse(root))
+        return nullptr;
+
+    std::shared_ptr<nfa> result = std::make_shared<nfa>();
+
+    result->states.push_back(nfa::state{nfa::accept, {}, {}, 0});
+    result->start = emit(root, 0, result->states);
+
+    if (result->start < 0 or result->states.size() > max_nfa_states)
+        return nullptr;
+
+    return result;
+}
+
+int
+dfa_regex::emit(node const& n, int next, std::vector<nfa::state>& states)
+{
+    if (next < 0 or states.size() > max_nfa_states)
+        return -1;
+
+    switch (n.kind) {
+    case node::chars:
+        states.push_back(nfa::state{nfa::chars, n.set, {next}, 0});
+        return int(states.size() - 1);
+
+    case node::concat:
+        for (auto it = n.children.crbegin(); it != n.children.crend(); ++it)
+            next = emit(*it, next, states);
+        return next;
+
+    case node::alternate: {
+        std::vector<int> out;
+        for (const auto& child : n.children)
+            out.push_back(emit(child, next, states));
+
+        if (std::find(out.cbegin(), out.cend(), -1) != out.cend())
+            return -1;
+
+        states.push_back(nfa::state{nfa::split, {}, std::move(out), 0});
+        return int(states.size() - 1);
+    }
+
+    case node::begin:
+        states.push_back(nfa::state{nfa::begin, {}, {next}, 0});
+        return int(states.size() - 1);
+
+    case node::end:
+        states.push_back(nfa::state{nfa::end, {}, {next}, 0});
+        return int(states.size() - 1);
+
+    case node::repeat: {
+        const node& child = n.children.front();
+        int start = next;
+
+        if (n.max < 0) {
+            states.push_back(nfa::state{nfa::split, {}, {}, 0});
+            const int loop = int(states.size() - 1);
+            const int body = emit(child, loop, states);
+            if (body < 0)
+                return -1;
+
+            states[std::size_t(loop)].out = {body, next};
+            start = loop;
+        }
+        else
+            for (int i = n.min; i < n.max; ++i) {
+                const int body = emit(child, start, states);
+                if (body < 0)
+                    return -1;
+
+                states.push_back(nfa::state{nfa::split, {}, {body, next}, 0});
+                start = int(states.size() - 1);
+            }
+
+        for (int i = 0; i < n.min; ++i)
+            start = emit(child, start, states);
+
+        return start;
+    }
+    }
+
+    return -1;
+}
+
+std::atomic<std::size_t>&
+dfa_regex::generation()
+{
+    static std::atomic<std::size_t> value{1};
+    return value;
+}
+
+dfa_regex::automaton&
+dfa_regex::cache(void const* key)
+{
+    static thread_local std::unordered_map<void const*, automaton> automatons;
+
+    if (automatons.size() >= max_cached_maps and automatons.find(key) == automatons.end())
+        automatons.clear();
+
+    return automatons[key];
+}
+
+dfa_regex::parser::parser(const std::string& pattern, bool icase)
+    : pattern_{pattern},
+      pos_{0},
+      icase_{icase}
+{
+}
+
+bool
+dfa_regex::parser::parse(node& result)
+{
+    return parse_alternate(result) and pos_ == pattern_.size();
+}
+
+bool
+dfa_regex::parser::parse_alternate(node& result)
+{
+    node branch;
+    if (not parse_concat(branch))
+        return false;
+
+    if (pos_ == pattern_.size() or pattern_[pos_] != '|') {
+        result = std::move(branch);
+        return true;
+    }
+
+    result.kind = node::alternate;
+    result.children.push_back(std::move(branch));
+
+    while (pos_ < pattern_.size() and pattern_[pos_] == '|') {
+        ++pos_;
+        node other;
+        if (not parse_concat(other))
+            return false;
+
+        result.children.push_back(std::move(other));
+    }
+
+    return true;
+}
+
+bool
+dfa_regex::parser::parse_concat(node& result)
+{
+    result.kind = node::concat;
+
+    while (pos_ < pattern_.size() and pattern_[pos_] != '|' and pattern_[pos_] != ')') {
+        node item;
+        if (not parse_repeat(item))
+            return false;
+
+        result.children.push_back(std::move(item));
+    }
+
+    return true;
+}
+
+bool
+dfa_regex::parser::parse_repeat(node& result)
+{
+    node atom;
+    if (not parse_atom(atom))
+        return false;
+
+    if (pos_ == pattern_.size()) {
+        result = std::move(atom);
+        return true;
+    }
+
+    int min = 0, max = 0;
+    switch (pattern_[pos_]) {
+    case '*': min = 0; max = -1; ++pos_; break;
+    case '+': min = 1; max = -1; ++pos_; break;
+    case '?': min = 0; max = 1; ++pos_; break;
+    case '{':
+        if (not parse_bounds(min, max))
+            return false;
+        break;
+    default:
+        result = std::move(atom);
+        return true;
+    }
+
+    if (atom.kind == node::begin or atom.kind == node::end)
+        return false;
+
+    // Laziness does not change the outcome of a full match
+    if (pos_ < pattern_.size() and pattern_[pos_] == '?')
+        ++pos_;
+
+    if (pos_ < pattern_.size()) {
+        const char c = pattern_[pos_];
+        if (c == '*' or c == '+' or c == '?' or c == '{')
+            return false;
+    }
+
+    if (min > max_repeat or max > max_repeat)
+        return false;
+
+    result.kind = node::repeat;
+    result.min = min;
+    result.max = max;
+    result.children.push_back(std::move(atom));
+
+    return true;
+}
+
+bool
+dfa_regex::parser::parse_bounds(int& min, int& max)
+{
+    ++pos_;
+
+    auto number = [this](int& value){
+        const std::size_t first = pos_;
+        value = 0;
+        while (pos_ < pattern_.size() and
+               std::isdigit(static_cast<unsigned char>(pattern_[pos_])) and value <= max_repeat)
+            value = value * 10 + (pattern_[pos_++] - '0');
+
+        return pos_ != first;
+    };
+
+    if (not number(min))
+        return false;
+
+    max = min;
+    if (pos_ < pattern_.size() and pattern_[pos_] == ',') {
+        ++pos_;
+        if (not number(max))
+            max = -1;
+    }
+
+    if (pos_ == pattern_.size() or pattern_[pos_] != '}')
+        return false;
+
+    ++pos_;
+
+    return max < 0 or min <= max;
+}
+
+bool
+dfa_regex::parser::parse_atom(node& result)
+{
+    const char c = pattern_[pos_];
+
+    switch (c) {
+    case '(': {
+        ++pos_;
+        if (pos_ < pattern_.size() and pattern_[pos_] == '?') {
+            if (pos_ + 1 < pattern_.size() and pattern_[pos_ + 1] == ':')
+                pos_ += 2;
+            else
+                return false;
+        }
+
+        if (not parse_alternate(result))
+            return false;
+
+        if (pos_ == pattern_.size() or pattern_[pos_] != ')')
+            return false;
+
+        ++pos_;
+        return true;
+    }
+
+    case ')': case '*': case '+': case '?': case '{':
+        return false;
+
+    case '[':
+        return parse_class(result);
+
+    case '.':
+        ++pos_;
+        result.kind = node::chars;
+        result.set.set();
+        result.set.reset('\n');
+        result.set.reset('\r');
+        return true;
+
+    case '^':
+        ++pos_;
+        result.kind = node::begin;
+        return true;
+
+    case '$':
+        ++pos_;
+        result.kind = node::end;
+        return true;
+
+    case '\\': {
+        int single = -1;
+        result.kind = node::chars;
+        if (not parse_escape(result.set, false, single))
+            return false;
+
+        fold(result.set);
+        return true;
+    }
+
+    default:
+        ++pos_;
+        result.kind = node::chars;
+        result.set.set(static_cast<unsigned char>(c));
+        fold(result.set);
+        return true;
+    }
+}
+
+bool
+dfa_regex::parser::parse_class(node& result)
+{
+    ++pos_;
+
+    bool negate = false;
+    if (pos_ < pattern_.size() and pattern_[pos_] == '^') {
+        negate = true;
+        ++pos_;
+    }
+
+    result.kind = node::chars;
+
+    while (true) {
+        if (pos_ == pattern_.size())
+            return false;
+
+        if (pattern_[pos_] == ']') {
+            ++pos_;
+            break;
+        }
+
+        if (pattern_[pos_] == '[' and pos_ + 1 < pattern_.size() and
+                (pattern_[pos_ + 1] == ':' or pattern_[pos_ + 1] == '.' or pattern_[pos_ + 1] == '='))
+            return false;
+
+        int first = -1;
+        if (pattern_[pos_] == '\\') {
+            if (not parse_escape(result.set, true, first))
+                return false;
+        }
+        else
+            first = static_cast<unsigned char>(pattern_[pos_++]);
+
+        if (pos_ + 1 < pattern_.size() and pattern_[pos_] == '-' and pattern_[pos_ + 1] != ']') {
+            ++pos_;
+
+            int last = -1;
+            if (pattern_[pos_] == '\\') {
+                std::bitset<256> dummy;
+                if (not parse_escape(dummy, true, last))
+                    return false;
+            }
+            else
+                last = static_cast<unsigned char>(pattern_[pos_++]);
+
+            if (first < 0 or last < 0 or first > last or last > 127)
+                return false;
+
+            for (int i = first; i <= last; ++i)
+                result.set.set(std::size_t(i));
+        }
+        else if (first >= 0)
+            result.set.set(std::size_t(first));
+    }
+
+    fold(result.set);
+
+    if (negate)
+        result.set.flip();
+
+    return true;
+}
+
+bool
+dfa_regex::parser::parse_escape(std::bitset<256>& set, bool in_class, int& single)
+{
+    ++pos_;
+    if (pos_ == pattern_.size())
+        return false;
+
+    const char c = pattern_[pos_++];
+
+    std::bitset<256> digit, word, space;
+    for (int i = '0'; i <= '9'; ++i)
+        digit.set(std::size_t(i));
+
+    word = digit;
+    for (int i = 'a'; i <= 'z'; ++i) {
+        word.set(std::size_t(i));
+        word.set(std::size_t(i - 'a' + 'A'));
+    }
+    word.set('_');
+
+    for (char s : {' ', '\t', '\n', '\v', '\f', '\r'})
+        space.set(static_cast<unsigned char>(s));
+
+    switch (c) {
+    case 'd': set |= digit; return true;
+    case 'D': set |= ~digit; return true;
+    case 'w': set |= word; return true;
+    case 'W': set |= ~word; return true;
+    case 's': set |= space; return true;
+    case 'S': set |= ~space; return true;
+    case 'n': single = '\n'; break;
+    case 'r': single = '\r'; break;
+    case 't': single = '\t'; break;
+    case 'f': single = '\f'; break;
+    case 'v': single = '\v'; break;
+    case 'b':
+        if (not in_class)
+            return false;
+        single = '\b';
+        break;
+    case '0':
+        if (pos_ < pattern_.size() and std::isdigit(static_cast<unsigned char>(pattern_[pos_])))
+            return false;
+        single = '\0';
+        break;
+    default:
+        if (std::isalnum(static_cast<unsigned char>(c)))
+            return false;
+        single = static_cast<unsigned char>(c);
+        break;
+    }
+
+    if (not in_class)
+        set.set(std::size_t(single));
+
+    return true;
+}
+
+void
+dfa_regex::parser::fold(std::bitset<256>& set) const
+{
+    if (not icase_)
+        return;
+
+    for (std::size_t i = 'a'; i <= 'z'; ++i)
+        if (set[i] or set[i - 'a' + 'A']) {
+            set.set(i);
+            set.set(i - 'a' + 'A');
+        }
+}
+
+void
+dfa_regex::automaton::build(std::vector<nfa const*> const& programs)
+{
+    states.clear();
+    starts.clear();
+
+    for (std::size_t index = 0; index < programs.size(); ++index) {
+        const nfa* program = programs[index];
+        if (program == nullptr)
+            continue;
+
+        const int offset = int(states.size());
+        for (auto value : program->states) {
+            for (auto& out : value.out)
+                out += offset;
+
+            if (value.kind == nfa::accept)
+                value.index = index;
+
+            states.push_back(std::move(value));
+        }
+
+        starts.push_back(program->start + offset);
+    }
+
+    reset();
+}
+
+void
+dfa_regex::automaton::reset()
+{
+    dstates.clear();
+    dindex.clear();
+
+    std::vector<int> set;
+    closure(starts, true, false, set);
+    start = add(std::move(set));
+}
+
+void
+dfa_regex::automaton::closure(std::vector<int>& seeds, bool at_begin, bool at_end,
+                              std::vector<int>& result) const
+{
+    std::vector<char> seen(states.size(), 0);
+    std::vector<int> stack(seeds);
+
+    while (not stack.empty()) {
+        const int s = stack.back();
+        stack.pop_back();
+
+        if (seen[std::size_t(s)])
+            continue;
+
+        seen[std::size_t(s)] = 1;
+
+        const auto& value = states[std::size_t(s)];
+        switch (value.kind) {
+        case nfa::split:
+            stack.insert(stack.end(), value.out.cbegin(), value.out.cend());
+            break;
+        case nfa::begin:
+            if (at_begin)
+                stack.push_back(value.out.front());
+            break;
+        case nfa::end:
+            if (at_end)
+                stack.push_back(value.out.front());
+            else
+                result.push_back(s);
+            break;
+        default:
+            result.push_back(s);
+            break;
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+}
+
+int
+dfa_regex::automaton::add(std::vector<int>&& set)
+{
+    auto pos = dindex.find(set);
+    if (pos != dindex.end())
+        return pos->second;
+
+    const int id = int(dstates.size());
+    dindex.emplace(set, id);
+
+    dstate value;
+    value.set = std::move(set);
+    value.next.fill(-1);
+    value.final_ready = false;
+    dstates.push_back(std::move(value));
+
+    return id;
+}
+
+int
+dfa_regex::automaton::transition(int d, unsigned char c)
+{
+    if (dstates[std::size_t(d)].next[c] >= 0)
+        return dstates[std::size_t(d)].next[c];
+
+    std::vector<int> seeds;
+    for (const int s : dstates[std::size_t(d)].set) {
+        const auto& value = states[std::size_t(s)];
+        if (value.kind == nfa::chars and value.set[c])
+            seeds.push_back(value.out.front());
+    }
+
+    std::vector<int> set;
+    closure(seeds, false, false, set);
+
+    if (dstates.size() >= max_dfa_states) {
+        std::vector<int> current = dstates[std::size_t(d)].set;
+        reset();
+        d = add(std::move(current));
+    }
+
+    const int id = add(std::move(set));
+    dstates[std::size_t(d)].next[c] = id;
+
+    return id;
+}
+
+std::vector<std::size_t> const&
+dfa_regex::automaton::accepts(int d)
+{
+    dstate& value = dstates[std::size_t(d)];
+    if (value.final_ready)
+        return value.accepts;
+
+    std::vector<int> set;
+    closure(value.set, false, true, set);
+
+    for (const int s : set)
+        if (states[std::size_t(s)].kind == nfa::accept)
+            value.accepts.push_back(states[std::size_t(s)].index);
+
+    std::sort(value.accepts.begin(), value.accepts.end());
+    value.accepts.erase(std::unique(value.accepts.begin(), value.accepts.end()),
+                        value.accepts.end());
+    value.final_ready = true;
+
+    return value.accepts;
+}
+
+std::vector<std::size_t> const&
+dfa_regex::automaton::run(string_view_type target)
+{
+    if (target.empty()) {
+        std::vector<int> set;
+        closure(starts, true, true, set);
+
+        scratch.clear();
+        for (const int s : set)
+            if (states[std::size_t(s)].kind == nfa::accept)
+                scratch.push_back(states[std::size_t(s)].index);
+
+        std::sort(scratch.begin(), scratch.end());
+        return scratch;
+    }
+
+    int d = start;
+    for (const char c : target) {
+        d = transition(d, static_cast<unsigned char>(c));
+        if (dstates[std::size_t(d)].set.empty()) {
+            scratch.clear();
+            return scratch;
+        }
+    }
+
+    return accepts(d);
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_DFA_REGEX_HXX
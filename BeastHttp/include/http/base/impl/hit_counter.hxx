@@ -0,0 +1,76 @@
+#ifndef BEASTHTTP_BASE_IMPL_HIT_COUNTER_HXX
+#define BEASTHTTP_BASE_IMPL_HIT_COUNTER_HXX
+
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+hit_counter::hit_counter()
+    : id_{next_id()}
+{
+}
+
+void
+hit_counter::hit() const
+{
+    auto& value = local().value;
+    value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+std::size_t
+hit_counter::value() const
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+
+    std::size_t result = 0;
+    for (const auto& value : slots_)
+        result += value->value.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+hit_counter::slot&
+hit_counter::local() const
+{
+    // Keyed by id rather than address, a counter freed since may have
+    // left its address to a new one
+    static thread_local std::unordered_map<std::uint64_t, std::shared_ptr<slot>> slots;
+    static thread_local std::size_t limit = 64;
+
+    auto pos = slots.find(id_);
+    if (pos != slots.end())
+        return *pos->second;
+
+    // Drops the slots of the counters destroyed since
+    if (slots.size() >= limit) {
+        for (auto it = slots.begin(); it != slots.end();)
+            it = it->second.use_count() == 1 ? slots.erase(it) : std::next(it);
+
+        limit = std::max<std::size_t>(64, slots.size() * 2);
+    }
+
+    auto value = std::make_shared<slot>();
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        slots_.push_back(value);
+    }
+
+    return *slots.emplace(id_, std::move(value)).first->second;
+}
+
+std::uint64_t
+hit_counter::next_id()
+{
+    static std::atomic<std::uint64_t> value{0};
+    return value.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_HIT_COUNTER_HXX
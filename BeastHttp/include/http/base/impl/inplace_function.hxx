@@ -0,0 +1,262 @@
+#ifndef BEASTHTTP_BASE_IMPL_INPLACE_FUNCTION_HXX
+#define BEASTHTTP_BASE_IMPL_INPLACE_FUNCTION_HXX
+
+#include <new>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+template<class F>
+struct BEASTHTTP_INPLACE_FUNCTION_TYPE::target
+{
+    static R
+    invoke(void* p, Args&&... args)
+    {
+        return static_cast<R>((*static_cast<F*>(p))(std::forward<Args>(args)...));
+    }
+
+    static void
+    copy(void* to, void const* from)
+    {
+        ::new (to) F(*static_cast<F const*>(from));
+    }
+
+    static void
+    move(void* to, void* from)
+    {
+        ::new (to) F(std::move(*static_cast<F*>(from)));
+        static_cast<F*>(from)->~F();
+    }
+
+    static void
+    destroy(void* p)
+    {
+        static_cast<F*>(p)->~F();
+    }
+
+    static vtable_type const*
+    vtable()
+    {
+        static const vtable_type value{&invoke, &copy, &move, &destroy};
+        return &value;
+    }
+}; // struct target
+
+// The storage holds a pointer to the target
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+template<class F>
+struct BEASTHTTP_INPLACE_FUNCTION_TYPE::remote
+{
+    static F*&
+    get(void* p)
+    {
+        return *static_cast<F**>(p);
+    }
+
+    static R
+    invoke(void* p, Args&&... args)
+    {
+        return static_cast<R>((*get(p))(std::forward<Args>(args)...));
+    }
+
+    static void
+    copy(void* to, void const* from)
+    {
+        ::new (to) F*(new F(**static_cast<F* const*>(from)));
+    }
+
+    static void
+    move(void* to, void* from)
+    {
+        ::new (to) F*(get(from));
+    }
+
+    static void
+    destroy(void* p)
+    {
+        delete get(p);
+    }
+
+    static vtable_type const*
+    vtable()
+    {
+        static const vtable_type value{&invoke, &copy, &move, &destroy};
+        return &value;
+    }
+}; // struct remote
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+struct BEASTHTTP_INPLACE_FUNCTION_TYPE::empty
+{
+    static R
+    invoke(void*, Args&&...)
+    {
+        throw std::bad_function_call{};
+    }
+
+    static void
+    copy(void*, void const*)
+    {
+    }
+
+    static void
+    move(void*, void*)
+    {
+    }
+
+    static void
+    destroy(void*)
+    {
+    }
+
+    static vtable_type const*
+    vtable()
+    {
+        static const vtable_type value{&invoke, &copy, &move, &destroy};
+        return &value;
+    }
+}; // struct empty
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+constexpr std::size_t BEASTHTTP_INPLACE_FUNCTION_TYPE::capacity;
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+BEASTHTTP_INPLACE_FUNCTION_TYPE::basic_inplace_function() noexcept
+    : vtable_{empty::vtable()}
+{
+}
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+BEASTHTTP_INPLACE_FUNCTION_TYPE::basic_inplace_function(std::nullptr_t) noexcept
+    : vtable_{empty::vtable()}
+{
+}
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+template<class F, typename>
+BEASTHTTP_INPLACE_FUNCTION_TYPE::basic_inplace_function(F&& f)
+    : vtable_{empty::vtable()}
+{
+    using target_type = typename std::decay<F>::type;
+
+    if (is_null(f, 0))
+        return;
+
+    emplace<target_type>(std::forward<F>(f), fits<target_type>{});
+}
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+BEASTHTTP_INPLACE_FUNCTION_TYPE::basic_inplace_function(self_type const& other)
+    : vtable_{empty::vtable()}
+{
+    other.vtable_->copy(&storage_, &other.storage_);
+    vtable_ = other.vtable_;
+}
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+BEASTHTTP_INPLACE_FUNCTION_TYPE::basic_inplace_function(self_type&& other) noexcept
+    : vtable_{other.vtable_}
+{
+    vtable_->move(&storage_, &other.storage_);
+    other.vtable_ = empty::vtable();
+}
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+BEASTHTTP_INPLACE_FUNCTION_TYPE::~basic_inplace_function()
+{
+    vtable_->destroy(&storage_);
+}
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+typename BEASTHTTP_INPLACE_FUNCTION_TYPE::self_type&
+BEASTHTTP_INPLACE_FUNCTION_TYPE::operator=(self_type const& other)
+{
+    if (this != &other) {
+        vtable_->destroy(&storage_);
+        vtable_ = empty::vtable();
+        other.vtable_->copy(&storage_, &other.storage_);
+        vtable_ = other.vtable_;
+    }
+
+    return *this;
+}
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+typename BEASTHTTP_INPLACE_FUNCTION_TYPE::self_type&
+BEASTHTTP_INPLACE_FUNCTION_TYPE::operator=(self_type&& other) noexcept
+{
+    if (this != &other) {
+        vtable_->destroy(&storage_);
+        vtable_ = other.vtable_;
+        vtable_->move(&storage_, &other.storage_);
+        other.vtable_ = empty::vtable();
+    }
+
+    return *this;
+}
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+typename BEASTHTTP_INPLACE_FUNCTION_TYPE::self_type&
+BEASTHTTP_INPLACE_FUNCTION_TYPE::operator=(std::nullptr_t) noexcept
+{
+    vtable_->destroy(&storage_);
+    vtable_ = empty::vtable();
+
+    return *this;
+}
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+BEASTHTTP_INPLACE_FUNCTION_TYPE::operator bool() const noexcept
+{
+    return vtable_ != empty::vtable();
+}
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+R
+BEASTHTTP_INPLACE_FUNCTION_TYPE::operator()(Args... args) const
+{
+    return vtable_->invoke(&storage_, std::forward<Args>(args)...);
+}
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+template<class F>
+auto
+BEASTHTTP_INPLACE_FUNCTION_TYPE::is_null(F const& f, int)
+-> decltype (static_cast<bool>(f == nullptr))
+{
+    return f == nullptr;
+}
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+template<class F>
+bool
+BEASTHTTP_INPLACE_FUNCTION_TYPE::is_null(F const&, long)
+{
+    return false;
+}
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+template<class F, class G>
+void
+BEASTHTTP_INPLACE_FUNCTION_TYPE::emplace(G&& f, std::true_type)
+{
+    ::new (static_cast<void*>(&storage_)) F(std::forward<G>(f));
+    vtable_ = target<F>::vtable();
+}
+
+BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE
+template<class F, class G>
+void
+BEASTHTTP_INPLACE_FUNCTION_TYPE::emplace(G&& f, std::false_type)
+{
+    ::new (static_cast<void*>(&storage_)) F*(new F(std::forward<G>(f)));
+    vtable_ = remote<F>::vtable();
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_INPLACE_FUNCTION_HXX
@@ -0,0 +1,209 @@
+#ifndef BEASTHTTP_BASE_IMPL_ORDERED_MAP_HXX
+#define BEASTHTTP_BASE_IMPL_ORDERED_MAP_HXX
+
+#include <algorithm>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+template<class Key, class Value, class... Args>
+typename ordered_map<Key, Value, Args...>::value_type const&
+ordered_map<Key, Value, Args...>::entry::value() const
+{
+    return *value_;
+}
+
+template<class Key, class Value, class... Args>
+int
+ordered_map<Key, Value, Args...>::entry::priority() const
+{
+    return priority_;
+}
+
+template<class Key, class Value, class... Args>
+std::size_t
+ordered_map<Key, Value, Args...>::entry::hits() const
+{
+    return hits_->value();
+}
+
+template<class Key, class Value, class... Args>
+void
+ordered_map<Key, Value, Args...>::entry::hit() const
+{
+    hits_->hit();
+}
+
+template<class Key, class Value, class... Args>
+hit_counter const&
+ordered_map<Key, Value, Args...>::entry::counter() const
+{
+    return *hits_;
+}
+
+template<class Key, class Value, class... Args>
+ordered_map<Key, Value, Args...>::ordered_map(self_type const& other)
+    : entries_{other.entries_},
+      order_{other.order_},
+      sequence_{other.sequence_}
+{
+    for (auto& value : order_)
+        value.value_ = &*entries_.find(value.value_->first);
+}
+
+template<class Key, class Value, class... Args>
+typename ordered_map<Key, Value, Args...>::self_type&
+ordered_map<Key, Value, Args...>::operator=(self_type const& other)
+{
+    if (this != &other) {
+        self_type copy{other};
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+template<class Key, class Value, class... Args>
+typename ordered_map<Key, Value, Args...>::iterator
+ordered_map<Key, Value, Args...>::begin()
+{
+    return entries_.begin();
+}
+
+template<class Key, class Value, class... Args>
+typename ordered_map<Key, Value, Args...>::iterator
+ordered_map<Key, Value, Args...>::end()
+{
+    return entries_.end();
+}
+
+template<class Key, class Value, class... Args>
+typename ordered_map<Key, Value, Args...>::const_iterator
+ordered_map<Key, Value, Args...>::begin() const
+{
+    return entries_.begin();
+}
+
+template<class Key, class Value, class... Args>
+typename ordered_map<Key, Value, Args...>::const_iterator
+ordered_map<Key, Value, Args...>::end() const
+{
+    return entries_.end();
+}
+
+template<class Key, class Value, class... Args>
+typename ordered_map<Key, Value, Args...>::const_iterator
+ordered_map<Key, Value, Args...>::cbegin() const
+{
+    return entries_.cbegin();
+}
+
+template<class Key, class Value, class... Args>
+typename ordered_map<Key, Value, Args...>::const_iterator
+ordered_map<Key, Value, Args...>::cend() const
+{
+    return entries_.cend();
+}
+
+template<class Key, class Value, class... Args>
+typename ordered_map<Key, Value, Args...>::size_type
+ordered_map<Key, Value, Args...>::size() const
+{
+    return entries_.size();
+}
+
+template<class Key, class Value, class... Args>
+bool
+ordered_map<Key, Value, Args...>::empty() const
+{
+    return entries_.empty();
+}
+
+template<class Key, class Value, class... Args>
+typename ordered_map<Key, Value, Args...>::iterator
+ordered_map<Key, Value, Args...>::find(key_type const& key)
+{
+    return entries_.find(key);
+}
+
+template<class Key, class Value, class... Args>
+typename ordered_map<Key, Value, Args...>::const_iterator
+ordered_map<Key, Value, Args...>::find(key_type const& key) const
+{
+    return entries_.find(key);
+}
+
+template<class Key, class Value, class... Args>
+template<class... Params>
+std::pair<typename ordered_map<Key, Value, Args...>::iterator, bool>
+ordered_map<Key, Value, Args...>::emplace(Params&&... params)
+{
+    auto result = entries_.emplace(std::forward<Params>(params)...);
+    if (result.second) {
+        entry value;
+        value.value_ = &*result.first;
+        value.priority_ = 0;
+        value.rank_ = 0;
+        value.sequence_ = sequence_++;
+        value.hits_ = std::make_shared<hit_counter>();
+
+        order_.push_back(std::move(value));
+        sort();
+    }
+
+    return result;
+}
+
+template<class Key, class Value, class... Args>
+bool
+ordered_map<Key, Value, Args...>::prioritize(key_type const& key, int priority)
+{
+    auto pos = std::find_if(order_.begin(), order_.end(), [&](entry const& value){
+        return value.value_->first == key;
+    });
+
+    if (pos == order_.end())
+        return false;
+
+    pos->priority_ = priority;
+    sort();
+
+    return true;
+}
+
+template<class Key, class Value, class... Args>
+void
+ordered_map<Key, Value, Args...>::reorder()
+{
+    for (auto& value : order_)
+        value.rank_ = value.hits();
+
+    sort();
+}
+
+template<class Key, class Value, class... Args>
+typename ordered_map<Key, Value, Args...>::order_type const&
+ordered_map<Key, Value, Args...>::order() const
+{
+    return order_;
+}
+
+template<class Key, class Value, class... Args>
+void
+ordered_map<Key, Value, Args...>::sort()
+{
+    std::sort(order_.begin(), order_.end(), [](entry const& lhs, entry const& rhs){
+        if (lhs.priority_ != rhs.priority_)
+            return lhs.priority_ > rhs.priority_;
+        if (lhs.rank_ != rhs.rank_)
+            return lhs.rank_ > rhs.rank_;
+        return lhs.sequence_ < rhs.sequence_;
+    });
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_ORDERED_MAP_HXX
@@ -0,0 +1,216 @@
+#ifndef BEASTHTTP_BASE_IMPL_OUTBOX_HXX
+#define BEASTHTTP_BASE_IMPL_OUTBOX_HXX
+
+#include <boost/beast/http/serializer.hpp>
+
+#include <cassert>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+struct outbox::collect
+{
+    std::string& out;
+
+    std::size_t& bytes;
+
+    template<class ConstBufferSequence>
+    void
+    operator()(boost::beast::error_code&, ConstBufferSequence const& buffers) const
+    {
+        bytes = 0;
+
+        for (auto it = boost::asio::buffer_sequence_begin(buffers);
+             it != boost::asio::buffer_sequence_end(buffers); ++it) {
+            boost::asio::const_buffer buffer{*it};
+            out.append(static_cast<const char*>(buffer.data()), buffer.size());
+            bytes += buffer.size();
+        }
+    }
+
+}; // struct collect
+
+template<class Body, class Fields>
+void
+outbox::serialize(boost::beast::http::response<Body, Fields>& response,
+                  std::string& out, boost::beast::error_code& ec)
+{
+    boost::beast::http::response_serializer<Body, Fields> serializer{response};
+
+    std::size_t bytes = 0;
+
+    while (not serializer.is_done()) {
+        serializer.next(ec, collect{out, bytes});
+        if (ec)
+            return;
+
+        serializer.consume(bytes);
+    }
+}
+
+template<class Body, class Fields>
+outbox::shared_message
+outbox::encode(boost::beast::http::response<Body, Fields>& response,
+               boost::beast::error_code& ec)
+{
+    auto message = std::make_shared<std::string>();
+
+    serialize(response, *message, ec);
+    if (ec)
+        return nullptr;
+
+    return message;
+}
+
+template<class Body, class Fields>
+bool
+outbox::push(boost::beast::http::response<Body, Fields>& response, std::size_t limit,
+             overflow policy, boost::beast::error_code& ec)
+{
+    const std::size_t stored = pending_.size();
+
+    serialize(response, pending_, ec);
+
+    if (ec or not admit(pending_.size() - stored, limit, policy)) {
+        pending_.resize(stored);
+        return false;
+    }
+
+    messages_.push_back({pending_.size(), nullptr});
+
+    return true;
+}
+
+inline bool
+outbox::push(shared_message const& message, std::size_t limit,
+             overflow policy, boost::beast::error_code& ec)
+{
+    assert(message);
+
+    ec = {};
+    shared_ += message->size();
+
+    if (not admit(message->size(), limit, policy)) {
+        shared_ -= message->size();
+        return false;
+    }
+
+    messages_.push_back({pending_.size(), message});
+
+    return true;
+}
+
+inline std::size_t
+outbox::size() const
+{
+    return pending_.size() + shared_ + written_;
+}
+
+inline bool
+outbox::pending() const
+{
+    return not messages_.empty();
+}
+
+inline bool
+outbox::writing() const
+{
+    return not buffers_.empty();
+}
+
+inline std::size_t
+outbox::dropped() const
+{
+    return dropped_;
+}
+
+inline outbox::const_buffers_type const&
+outbox::flush()
+{
+    assert(not writing());
+
+    writing_.swap(pending_);
+    pending_.clear();
+
+    // Consecutive serialized messages go in one buffer, each shared one
+    // in its own
+    std::size_t begin = 0;
+    for (auto& message : messages_) {
+        if (not message.shared)
+            continue;
+
+        if (message.end > begin)
+            buffers_.emplace_back(writing_.data() + begin, message.end - begin);
+
+        buffers_.emplace_back(message.shared->data(), message.shared->size());
+        held_.push_back(std::move(message.shared));
+        begin = message.end;
+    }
+
+    if (writing_.size() > begin)
+        buffers_.emplace_back(writing_.data() + begin, writing_.size() - begin);
+
+    written_ = writing_.size() + shared_;
+    shared_ = 0;
+    messages_.clear();
+
+    return buffers_;
+}
+
+inline void
+outbox::consume()
+{
+    writing_.clear();
+    held_.clear();
+    buffers_.clear();
+    written_ = 0;
+}
+
+inline bool
+outbox::admit(std::size_t bytes, std::size_t limit, overflow policy)
+{
+    // The new message is counted by size() already
+    if (size() <= limit)
+        return true;
+
+    // Room is made only from the messages no write has taken yet
+    if (policy != overflow::drop_oldest or written_ + bytes > limit) {
+        ++dropped_;
+        return false;
+    }
+
+    drop_front(size() - limit);
+
+    return true;
+}
+
+inline void
+outbox::drop_front(std::size_t bytes)
+{
+    // Whole messages, from the oldest, until at least bytes are freed
+    std::size_t freed = 0, end = 0;
+    while (freed < bytes) {
+        auto& message = messages_.front();
+        if (message.shared) {
+            freed += message.shared->size();
+            shared_ -= message.shared->size();
+        }
+        else
+            freed += message.end - end;
+
+        end = message.end;
+        messages_.pop_front();
+        ++dropped_;
+    }
+
+    pending_.erase(0, end);
+    for (auto& message : messages_)
+        message.end -= end;
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_OUTBOX_HXX
@@ -0,0 +1,83 @@
+#ifndef BEASTHTTP_BASE_IMPL_PIPELINED_HXX
+#define BEASTHTTP_BASE_IMPL_PIPELINED_HXX
+
+#include <boost/asio/buffers_iterator.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+namespace detail {
+
+template<class Iterator>
+bool
+field_is(Iterator first, Iterator last, const char* name)
+{
+    const std::size_t size = std::strlen(name);
+    if (static_cast<std::size_t>(last - first) != size)
+        return false;
+
+    for (std::size_t i = 0; i < size; ++i, ++first) {
+        char c = *first;
+        if (c >= 'A' and c <= 'Z')
+            c = static_cast<char>(c - 'A' + 'a');
+
+        if (c != name[i])
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace detail
+
+template<class ConstBufferSequence>
+bool
+pipelined(ConstBufferSequence const& buffers)
+{
+    static const char terminator[] = "\r\n\r\n";
+
+    auto const begin = boost::asio::buffers_begin(buffers);
+    auto const end = boost::asio::buffers_end(buffers);
+    auto const header_end = std::search(begin, end, terminator, terminator + 4);
+
+    if (header_end == end)
+        return false;
+
+    std::uint64_t length = 0;
+
+    // One field a line, after the request line
+    auto line = std::find(begin, header_end, '\n');
+    while (line != header_end) {
+        auto const first = line + 1;
+        auto const last = std::find(first, header_end, '\r');
+        auto const colon = std::find(first, last, ':');
+
+        if (detail::field_is(first, colon, "transfer-encoding"))
+            return false;
+
+        if (colon != last and detail::field_is(first, colon, "content-length")) {
+            auto digit = colon + 1;
+            while (digit != last and (*digit == ' ' or *digit == '\t'))
+                ++digit;
+
+            length = 0;
+            for (; digit != last and *digit >= '0' and *digit <= '9'; ++digit)
+                length = length * 10 + static_cast<std::uint64_t>(*digit - '0');
+        }
+
+        line = last == header_end ? header_end : std::find(last, header_end, '\n');
+    }
+
+    return static_cast<std::uint64_t>(end - header_end) - 4 >= length;
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_PIPELINED_HXX
@@ -0,0 +1,151 @@
+#ifndef BEASTHTTP_BASE_IMPL_POOL_HXX
+#define BEASTHTTP_BASE_IMPL_POOL_HXX
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+template<class Tag>
+pool<Tag>::~pool()
+{
+    clear();
+    destroyed() = true;
+}
+
+template<class Tag>
+typename pool<Tag>::self_type&
+pool<Tag>::local()
+{
+    static thread_local self_type value;
+    return value;
+}
+
+template<class Tag>
+bool
+pool<Tag>::available()
+{
+    return not destroyed();
+}
+
+template<class Tag>
+void*
+pool<Tag>::allocate(std::size_t size)
+{
+    if (pooled(size) and head_) {
+        node* const block = head_;
+        head_ = block->next;
+        --size_;
+        ++hits_;
+
+        return block;
+    }
+
+    ++misses_;
+
+    return ::operator new(size);
+}
+
+template<class Tag>
+void
+pool<Tag>::deallocate(void* p, std::size_t size, std::size_t capacity) noexcept
+{
+    if (not pooled(size) or size_ >= capacity)
+        return ::operator delete(p);
+
+    head_ = ::new (p) node{head_};
+    ++size_;
+}
+
+template<class Tag>
+std::size_t
+pool<Tag>::hits() const
+{
+    return hits_;
+}
+
+template<class Tag>
+std::size_t
+pool<Tag>::misses() const
+{
+    return misses_;
+}
+
+template<class Tag>
+std::size_t
+pool<Tag>::size() const
+{
+    return size_;
+}
+
+template<class Tag>
+std::size_t
+pool<Tag>::block_size() const
+{
+    return block_size_;
+}
+
+template<class Tag>
+void
+pool<Tag>::clear()
+{
+    while (head_) {
+        node* const next = head_->next;
+        ::operator delete(head_);
+        head_ = next;
+    }
+
+    size_ = 0;
+}
+
+template<class Tag>
+bool&
+pool<Tag>::destroyed()
+{
+    // Trivially destructible, so that it can be read after the pool is gone
+    static thread_local bool value = false;
+    return value;
+}
+
+template<class Tag>
+bool
+pool<Tag>::pooled(std::size_t size) noexcept
+{
+    if (block_size_ == 0 and size >= sizeof(node))
+        block_size_ = size;
+
+    return size == block_size_;
+}
+
+template<class T, class Tag>
+T*
+pool_allocator<T, Tag>::allocate(std::size_t n)
+{
+    if (pooled(n))
+        return static_cast<T*>(pool_type::local().allocate(sizeof(T)));
+
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+}
+
+template<class T, class Tag>
+void
+pool_allocator<T, Tag>::deallocate(T* p, std::size_t n) noexcept
+{
+    if (pooled(n))
+        return pool_type::local().deallocate(p, sizeof(T), capacity_);
+
+    ::operator delete(p);
+}
+
+template<class T, class Tag>
+bool
+pool_allocator<T, Tag>::pooled(std::size_t n) noexcept
+{
+    return n == 1 and alignof(T) <= alignof(std::max_align_t)
+            and pool_type::available();
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_POOL_HXX
@@ -0,0 +1,226 @@
+#ifndef BEASTHTTP_BASE_IMPL_POOLED_BUFFER_HXX
+#define BEASTHTTP_BASE_IMPL_POOLED_BUFFER_HXX
+
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+template<std::size_t BlockSize>
+pooled_buffer<BlockSize>::pooled_buffer(self_type&& other) noexcept
+    : block_{other.block_},
+      in_{other.in_},
+      out_{other.out_},
+      last_{other.last_}
+{
+    other.block_ = nullptr;
+    other.in_ = other.out_ = other.last_ = 0;
+}
+
+template<std::size_t BlockSize>
+typename pooled_buffer<BlockSize>::self_type&
+pooled_buffer<BlockSize>::operator=(self_type&& other) noexcept
+{
+    if (this != &other) {
+        release();
+
+        block_ = other.block_;
+        in_ = other.in_;
+        out_ = other.out_;
+        last_ = other.last_;
+
+        other.block_ = nullptr;
+        other.in_ = other.out_ = other.last_ = 0;
+    }
+
+    return *this;
+}
+
+template<std::size_t BlockSize>
+pooled_buffer<BlockSize>::~pooled_buffer()
+{
+    release();
+}
+
+template<std::size_t BlockSize>
+std::size_t
+pooled_buffer<BlockSize>::size() const noexcept
+{
+    return out_ - in_;
+}
+
+template<std::size_t BlockSize>
+std::size_t
+pooled_buffer<BlockSize>::max_size() const noexcept
+{
+    return BlockSize;
+}
+
+template<std::size_t BlockSize>
+std::size_t
+pooled_buffer<BlockSize>::capacity() const noexcept
+{
+    return block_ ? BlockSize : 0;
+}
+
+template<std::size_t BlockSize>
+typename pooled_buffer<BlockSize>::const_buffers_type
+pooled_buffer<BlockSize>::data() const noexcept
+{
+    return {block_ + in_, out_ - in_};
+}
+
+template<std::size_t BlockSize>
+typename pooled_buffer<BlockSize>::const_buffers_type
+pooled_buffer<BlockSize>::cdata() const noexcept
+{
+    return data();
+}
+
+template<std::size_t BlockSize>
+typename pooled_buffer<BlockSize>::mutable_buffers_type
+pooled_buffer<BlockSize>::data() noexcept
+{
+    return {block_ + in_, out_ - in_};
+}
+
+template<std::size_t BlockSize>
+typename pooled_buffer<BlockSize>::mutable_buffers_type
+pooled_buffer<BlockSize>::prepare(std::size_t n)
+{
+    if (n > BlockSize - size())
+        BOOST_THROW_EXCEPTION(std::length_error{"pooled_buffer overflow"});
+
+    if (not block_ and pool_type::available()) {
+        const std::size_t idle = pool_type::local().size();
+
+        block_ = static_cast<char*>(pool_type::local().allocate(BlockSize));
+        if (pool_type::local().size() != idle)
+            idle_blocks().fetch_sub(1, std::memory_order_relaxed);
+
+        borrowed_blocks().fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (not block_) {
+        block_ = static_cast<char*>(::operator new(BlockSize));
+        borrowed_blocks().fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (n > BlockSize - out_) {
+        // Moves the pending bytes to the front of the block
+        std::memmove(block_, block_ + in_, size());
+        out_ -= in_;
+        in_ = 0;
+    }
+
+    last_ = out_ + n;
+
+    return {block_ + out_, n};
+}
+
+template<std::size_t BlockSize>
+void
+pooled_buffer<BlockSize>::commit(std::size_t n) noexcept
+{
+    out_ += (std::min)(n, last_ - out_);
+    last_ = out_;
+}
+
+template<std::size_t BlockSize>
+void
+pooled_buffer<BlockSize>::consume(std::size_t n) noexcept
+{
+    if (n < size()) {
+        in_ += n;
+        return;
+    }
+
+    in_ = out_ = last_ = 0;
+
+    release();
+}
+
+template<std::size_t BlockSize>
+bool
+pooled_buffer<BlockSize>::borrowed() const noexcept
+{
+    return block_ != nullptr;
+}
+
+template<std::size_t BlockSize>
+void
+pooled_buffer<BlockSize>::reserve(std::size_t capacity)
+{
+    reserved().store(capacity, std::memory_order_relaxed);
+}
+
+template<std::size_t BlockSize>
+typename pooled_buffer<BlockSize>::stats_type
+pooled_buffer<BlockSize>::stats()
+{
+    return {borrowed_blocks().load(std::memory_order_relaxed) * BlockSize,
+                idle_blocks().load(std::memory_order_relaxed) * BlockSize};
+}
+
+template<std::size_t BlockSize>
+typename pooled_buffer<BlockSize>::pool_type const&
+pooled_buffer<BlockSize>::pool()
+{
+    return pool_type::local();
+}
+
+template<std::size_t BlockSize>
+void
+pooled_buffer<BlockSize>::release() noexcept
+{
+    if (not block_)
+        return;
+
+    borrowed_blocks().fetch_sub(1, std::memory_order_relaxed);
+
+    if (pool_type::available()) {
+        const std::size_t idle = pool_type::local().size();
+
+        pool_type::local().deallocate(block_, BlockSize, reserved().load(std::memory_order_relaxed));
+        if (pool_type::local().size() != idle)
+            idle_blocks().fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+        ::operator delete(block_);
+
+    block_ = nullptr;
+    in_ = out_ = last_ = 0;
+}
+
+template<std::size_t BlockSize>
+std::atomic<std::size_t>&
+pooled_buffer<BlockSize>::reserved()
+{
+    static std::atomic<std::size_t> value{64};
+    return value;
+}
+
+template<std::size_t BlockSize>
+std::atomic<std::size_t>&
+pooled_buffer<BlockSize>::borrowed_blocks()
+{
+    static std::atomic<std::size_t> value{0};
+    return value;
+}
+
+template<std::size_t BlockSize>
+std::atomic<std::size_t>&
+pooled_buffer<BlockSize>::idle_blocks()
+{
+    static std::atomic<std::size_t> value{0};
+    return value;
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_POOLED_BUFFER_HXX
@@ -1,70 +1,241 @@
 #ifndef BEASTHTTP_BASE_IMPL_QUEUE_HXX
 #define BEASTHTTP_BASE_IMPL_QUEUE_HXX
 
+#include <cassert>
+#include <new>
+#include <utility>
+
 namespace _0xdead4ead {
 namespace http {
 namespace base {
 
-template<class Flesh>
-queue<Flesh>::queue(Flesh& impl)
-    : impl_(impl)
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+constexpr std::size_t queue<Flesh, Depth, InlineSize>::depth;
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+queue<Flesh, Depth, InlineSize>::queue(Flesh& impl, std::size_t limit)
+    : impl_(impl),
+      batch_{limit}
+{
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+queue<Flesh, Depth, InlineSize>::~queue()
 {
-    static_assert(limit > 0, "queue limit must be positive");
-    items_.reserve(limit);
+    while (size())
+        pop_front();
 }
 
-template<class Flesh>
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
 bool
-queue<Flesh>::is_full() const
+queue<Flesh, Depth, InlineSize>::is_full() const
 {
-    return items_.size() >= limit;
+    return size() >= Depth;
 }
 
-template<class Flesh>
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+std::size_t
+queue<Flesh, Depth, InlineSize>::size() const
+{
+    return size_ + overflow_.size();
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
 bool
-queue<Flesh>::on_write()
+queue<Flesh, Depth, InlineSize>::on_write()
 {
-    assert(not items_.empty());
+    assert(size() > 0);
     auto const was_full = is_full();
-    items_.erase(items_.begin());
-    if (not items_.empty())
-        (*items_.front())();
+    for (; writing_; --writing_)
+        pop_front();
+    start();
     return was_full;
 }
 
-template<class Flesh>
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+bool
+queue<Flesh, Depth, InlineSize>::coalescing() const
+{
+    return batch_.limit() != 0;
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+void
+queue<Flesh, Depth, InlineSize>::cork()
+{
+    corked_ = true;
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+void
+queue<Flesh, Depth, InlineSize>::uncork()
+{
+    if (not corked_)
+        return;
+
+    corked_ = false;
+    start();
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+bool
+queue<Flesh, Depth, InlineSize>::writing() const
+{
+    return writing_ != 0;
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+void
+queue<Flesh, Depth, InlineSize>::pause()
+{
+    paused_ = true;
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+void
+queue<Flesh, Depth, InlineSize>::resume()
+{
+    paused_ = false;
+    start();
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
 template<class Response>
 void
-queue<Flesh>::operator()(Response& response)
+queue<Flesh, Depth, InlineSize>::operator()(Response& response)
 {
     using response_type = typename std::decay<Response>::type;
 
-    struct work_impl : work
-    {
-        Flesh& impl_;
-        response_type response_;
+    // The ring takes responses only while nothing older waits on the
+    // overflow list, so that they are written in order
+    if (overflow_.empty() and size_ < Depth) {
+        const std::size_t index = (head_ + size_) % Depth;
+        items_[index] = make<response_type>(&storage_[index], response, fits<response_type>{});
+        ++size_;
+    }
+    else
+        overflow_.push_back(make<response_type>(nullptr, response, std::false_type{}));
+
+    start();
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+template<class Response>
+typename queue<Flesh, Depth, InlineSize>::entry
+queue<Flesh, Depth, InlineSize>::make(void* storage, Response& response, std::true_type)
+{
+    return {::new (storage) Response(std::move(response)),
+                &self_type::template write<Response>,
+                &self_type::template append<Response>,
+                &self_type::template destroy_inline<Response>};
+}
 
-        work_impl(Flesh& impl, response_type&& response)
-            : impl_(impl)
-            , response_(std::move(response))
-        {
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+template<class Response>
+typename queue<Flesh, Depth, InlineSize>::entry
+queue<Flesh, Depth, InlineSize>::make(void*, Response& response, std::false_type)
+{
+    return {new Response(std::move(response)),
+                &self_type::template write<Response>,
+                &self_type::template append<Response>,
+                &self_type::template destroy_heap<Response>};
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+template<class Response>
+void
+queue<Flesh, Depth, InlineSize>::write(Flesh& impl, void* object)
+{
+    impl.do_write(*static_cast<Response*>(object));
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+template<class Response>
+bool
+queue<Flesh, Depth, InlineSize>::append(void* object, write_batch& batch)
+{
+    return batch.append(*static_cast<Response*>(object));
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+template<class Response>
+void
+queue<Flesh, Depth, InlineSize>::destroy_inline(void* object)
+{
+    static_cast<Response*>(object)->~Response();
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+template<class Response>
+void
+queue<Flesh, Depth, InlineSize>::destroy_heap(void* object)
+{
+    delete static_cast<Response*>(object);
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+typename queue<Flesh, Depth, InlineSize>::entry&
+queue<Flesh, Depth, InlineSize>::at(std::size_t index)
+{
+    return index < size_ ? items_[(head_ + index) % Depth] : overflow_[index - size_];
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+typename queue<Flesh, Depth, InlineSize>::entry&
+queue<Flesh, Depth, InlineSize>::front()
+{
+    return size_ ? items_[head_] : overflow_.front();
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+void
+queue<Flesh, Depth, InlineSize>::write_front()
+{
+    if (batch_.limit() and size() > 1) {
+        batch_.clear();
+
+        // Stops at a response closing the connection, the ones after it
+        // would not be written anyway
+        for (std::size_t index = 0; index < size() and not batch_.need_eof(); ++index) {
+            auto& item = at(index);
+            if (not item.append(item.object, batch_))
+                break;
         }
 
-        void
-        operator()()
-        {
-            impl_.do_write(response_);
+        writing_ = batch_.size();
+        if (writing_) {
+            impl_.do_write(batch_);
+            return;
         }
-    };
-#ifndef __cpp_lib_make_unique
-    items_.push_back(std::unique_ptr<work_impl>(
-                         new work_impl(impl_, std::move(response))));
-#else
-    items_.push_back(std::make_unique<work_impl>(
-                         impl_, std::move(response)));
-#endif
-    if (items_.size() == 1)
-        (*items_.front())();
+    }
+
+    writing_ = 1;
+
+    auto& item = front();
+    item.write(impl_, item.object);
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+void
+queue<Flesh, Depth, InlineSize>::start()
+{
+    if (size() and not writing_ and not corked_ and not paused_)
+        write_front();
+}
+
+template<class Flesh, std::size_t Depth, std::size_t InlineSize>
+void
+queue<Flesh, Depth, InlineSize>::pop_front()
+{
+    auto& item = front();
+    item.destroy(item.object);
+
+    if (size_) {
+        head_ = (head_ + 1) % Depth;
+        --size_;
+    }
+    else
+        overflow_.pop_front();
 }
 
 } // namespace base
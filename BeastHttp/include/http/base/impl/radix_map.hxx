@@ -0,0 +1,254 @@
+#ifndef BEASTHTTP_BASE_IMPL_RADIX_MAP_HXX
+#define BEASTHTTP_BASE_IMPL_RADIX_MAP_HXX
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+template<class Key, class Value, class... Args>
+radix_map<Key, Value, Args...>::radix_map()
+    : root_{new node}
+{
+}
+
+template<class Key, class Value, class... Args>
+radix_map<Key, Value, Args...>::radix_map(self_type const& other)
+    : entries_{other.entries_},
+      root_{new node}
+{
+    inserted_.reserve(other.inserted_.size());
+    for (const auto& value : other.inserted_)
+        index(*entries_.find(value->first));
+}
+
+template<class Key, class Value, class... Args>
+typename radix_map<Key, Value, Args...>::self_type&
+radix_map<Key, Value, Args...>::operator=(self_type const& other)
+{
+    if (this != &other) {
+        self_type copy{other};
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+template<class Key, class Value, class... Args>
+typename radix_map<Key, Value, Args...>::iterator
+radix_map<Key, Value, Args...>::begin()
+{
+    return entries_.begin();
+}
+
+template<class Key, class Value, class... Args>
+typename radix_map<Key, Value, Args...>::iterator
+radix_map<Key, Value, Args...>::end()
+{
+    return entries_.end();
+}
+
+template<class Key, class Value, class... Args>
+typename radix_map<Key, Value, Args...>::const_iterator
+radix_map<Key, Value, Args...>::begin() const
+{
+    return entries_.begin();
+}
+
+template<class Key, class Value, class... Args>
+typename radix_map<Key, Value, Args...>::const_iterator
+radix_map<Key, Value, Args...>::end() const
+{
+    return entries_.end();
+}
+
+template<class Key, class Value, class... Args>
+typename radix_map<Key, Value, Args...>::const_iterator
+radix_map<Key, Value, Args...>::cbegin() const
+{
+    return entries_.cbegin();
+}
+
+template<class Key, class Value, class... Args>
+typename radix_map<Key, Value, Args...>::const_iterator
+radix_map<Key, Value, Args...>::cend() const
+{
+    return entries_.cend();
+}
+
+template<class Key, class Value, class... Args>
+typename radix_map<Key, Value, Args...>::size_type
+radix_map<Key, Value, Args...>::size() const
+{
+    return entries_.size();
+}
+
+template<class Key, class Value, class... Args>
+bool
+radix_map<Key, Value, Args...>::empty() const
+{
+    return entries_.empty();
+}
+
+template<class Key, class Value, class... Args>
+typename radix_map<Key, Value, Args...>::iterator
+radix_map<Key, Value, Args...>::find(key_type const& key)
+{
+    return entries_.find(key);
+}
+
+template<class Key, class Value, class... Args>
+typename radix_map<Key, Value, Args...>::const_iterator
+radix_map<Key, Value, Args...>::find(key_type const& key) const
+{
+    return entries_.find(key);
+}
+
+template<class Key, class Value, class... Args>
+template<class... Params>
+std::pair<typename radix_map<Key, Value, Args...>::iterator, bool>
+radix_map<Key, Value, Args...>::emplace(Params&&... params)
+{
+    auto result = entries_.emplace(std::forward<Params>(params)...);
+    if (result.second)
+        index(*result.first);
+
+    return result;
+}
+
+template<class Key, class Value, class... Args>
+template<class F>
+bool
+radix_map<Key, Value, Args...>::match(string_view_type target, F&& f) const
+{
+    return match(*root_, target, 0, f);
+}
+
+template<class Key, class Value, class... Args>
+typename radix_map<Key, Value, Args...>::fallback_type const&
+radix_map<Key, Value, Args...>::fallback() const
+{
+    return fallback_;
+}
+
+template<class Key, class Value, class... Args>
+void
+radix_map<Key, Value, Args...>::index(value_type const& value)
+{
+    inserted_.push_back(&value);
+
+    std::vector<token> tokens;
+    if (segment_pattern::parse(value.first, tokens))
+        insert(*root_, tokens, 0, value);
+    else
+        fallback_.push_back(&value);
+}
+
+template<class Key, class Value, class... Args>
+void
+radix_map<Key, Value, Args...>::insert(node& n, std::vector<token> const& tokens,
+                                       std::size_t pos, value_type const& value)
+{
+    if (pos == tokens.size()) {
+        n.values.push_back(&value);
+        return;
+    }
+
+    if (tokens[pos].type == kind::literal)
+        return insert_literal(n, tokens[pos].text, tokens, pos + 1, value);
+
+    for (auto& param : n.params)
+        if (param.first == tokens[pos].type)
+            return insert(*param.second, tokens, pos + 1, value);
+
+    n.params.emplace_back(tokens[pos].type, node_ptr{new node});
+    insert(*n.params.back().second, tokens, pos + 1, value);
+}
+
+template<class Key, class Value, class... Args>
+void
+radix_map<Key, Value, Args...>::insert_literal(node& n, std::string const& literal,
+                                               std::vector<token> const& tokens,
+                                               std::size_t pos, value_type const& value)
+{
+    for (auto& child : n.children) {
+        if (child->prefix.front() != literal.front())
+            continue;
+
+        std::size_t common = 0;
+        while (common < child->prefix.size() and common < literal.size()
+               and child->prefix[common] == literal[common])
+            ++common;
+
+        if (common < child->prefix.size()) {
+            node_ptr split{new node};
+            split->prefix = child->prefix.substr(0, common);
+            child->prefix.erase(0, common);
+            split->children.push_back(std::move(child));
+            child = std::move(split);
+        }
+
+        if (common == literal.size())
+            insert(*child, tokens, pos, value);
+        else
+            insert_literal(*child, literal.substr(common), tokens, pos, value);
+
+        return;
+    }
+
+    node_ptr child{new node};
+    child->prefix = literal;
+    insert(*child, tokens, pos, value);
+    n.children.push_back(std::move(child));
+}
+
+template<class Key, class Value, class... Args>
+template<class F>
+bool
+radix_map<Key, Value, Args...>::match(node const& n, string_view_type target,
+                                      std::size_t pos, F& f)
+{
+    bool matched = false;
+    if (pos == target.size())
+        for (const auto value : n.values) {
+            f(*value);
+            matched = true;
+        }
+
+    // A rest segment takes whatever is left, nothing included
+    for (const auto& param : n.params)
+        if (param.first == kind::rest)
+            for (const auto value : param.second->values) {
+                f(*value);
+                matched = true;
+            }
+
+    if (pos == target.size())
+        return matched;
+
+    for (const auto& child : n.children)
+        if (child->prefix.front() == target[pos]) {
+            if (target.substr(pos, child->prefix.size()) == child->prefix)
+                matched = match(*child, target, pos + child->prefix.size(), f) or matched;
+            break;
+        }
+
+    if (n.params.empty() or target[pos] == '/')
+        return matched;
+
+    auto end = target.find('/', pos);
+    if (end == string_view_type::npos)
+        end = target.size();
+
+    for (const auto& param : n.params)
+        if (param.first != kind::rest
+                and segment_pattern::accepts(param.first, target.substr(pos, end - pos)))
+            matched = match(*param.second, target, end, f) or matched;
+
+    return matched;
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_RADIX_MAP_HXX
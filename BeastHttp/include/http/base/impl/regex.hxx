@@ -10,10 +10,22 @@ regex::regex(flag_type flags)
 {
 }
 
+regex::flag_type
+regex::flags() const
+{
+    return flags_;
+}
+
+regex::compiled_type
+regex::compile(const std::string& regx) const
+{
+    return compiled_type(expand(regx), flags_);
+}
+
 bool
 regex::match(const std::string& regx, const std::string& str)
 {
-    const regex_type e(regx, flags_);
+    const regex_type e(expand(regx), flags_);
     return std::regex_match(str, e);
 }
 
@@ -21,10 +33,56 @@ bool
 regex::match(const std::string& regx, const std::string& str,
       std::smatch& results)
 {
-    const regex_type e(regx, flags_);
+    const regex_type e(expand(regx), flags_);
     return std::regex_match(str, results, e);
 }
 
+bool
+regex::match(const compiled_type& e, string_view_type str) const
+{
+    return std::regex_match(str.begin(), str.end(), e);
+}
+
+bool
+regex::match(const compiled_type& e, const std::string& str,
+      std::smatch& results) const
+{
+    return std::regex_match(str, results, e);
+}
+
+bool
+regex::match(const compiled_type& e, string_view_type str,
+      std::cmatch& results) const
+{
+    return std::regex_match(str.begin(), str.end(), results, e);
+}
+
+std::string
+regex::expand(const std::string& regx) const
+{
+    if (flags_ & (std::regex_constants::basic | std::regex_constants::grep))
+        return regx;
+
+    // Only a path made of literal and named segments is rewritten, a
+    // regular expression is kept as written, "/:x" or "/{x}" in it included
+    segment_pattern::parts_type parts;
+    if (not segment_pattern::parse(regx, parts))
+        return regx;
+
+    const bool begin = not regx.empty() and regx.front() == '^';
+    const bool end = regx.size() > (begin ? 1u : 0u) and regx.back() == '$';
+
+    std::string result = begin ? "^" : "";
+    for (const auto& part : parts)
+        result += part.type == segment_pattern::kind::literal
+                ? part.text : segment_pattern::expression(part.type);
+
+    if (end)
+        result.push_back('$');
+
+    return result;
+}
+
 } // namespace base
 } // namespace http
 } // namespace _0xdead4ead
@@ -16,6 +16,63 @@ request_processor<Session>::request_processor(
 {
 }
 
+template<class Session>
+request_processor<Session>::request_processor(
+        std::shared_ptr<resource_map_type> const& resource_map,
+        std::shared_ptr<method_map_type> const& method_map,
+        typename regex_type::flag_type flags,
+        std::shared_ptr<snapshot_type const> const& snapshot)
+    : resource_map_{resource_map},
+      method_map_{method_map},
+      snapshot_{snapshot},
+      regex_{flags}
+{
+}
+
+template<class Session>
+bool
+request_processor<Session>::lock_free() const
+{
+    return static_cast<bool>(snapshot_);
+}
+
+template<class Session>
+void
+request_processor<Session>::enable_cache(std::size_t capacity)
+{
+    cache_capacity().store(capacity, std::memory_order_relaxed);
+}
+
+template<class Session>
+typename request_processor<Session>::cache_type const&
+request_processor<Session>::cache()
+{
+    return local_cache(cache_capacity().load(std::memory_order_relaxed));
+}
+
+template<class Session>
+std::atomic<std::size_t>&
+request_processor<Session>::cache_capacity()
+{
+    static std::atomic<std::size_t> value{0};
+    return value;
+}
+
+template<class Session>
+typename request_processor<Session>::cache_type&
+request_processor<Session>::local_cache(std::size_t capacity)
+{
+    static thread_local std::size_t requested = 0;
+    static thread_local cache_type value;
+
+    if (requested != capacity) {
+        value = cache_type{capacity};
+        requested = capacity;
+    }
+
+    return value;
+}
+
 #ifdef BEASTHTTP_TEST_ROUTER
 template<class Session>
 void
@@ -31,39 +88,233 @@ void
 request_processor<Session>::provide(
         request_type& request, session_flesh& _flesh)
 {
-    resource_type target = request.target();
+    if (not snapshot_) {
+        provide(resource_map_.get(), method_map_.get(), request, _flesh);
+        return;
+    }
+
+    while (snapshot_->stale())
+        snapshot_ = snapshot_->next();
+
+    if (snapshot_->dispatcher() and (*snapshot_->dispatcher())(request, _flesh))
+        return;
+
+    provide(snapshot_->resource_map().get(), snapshot_->method_map().get(),
+            request, _flesh);
+}
+
+template<class Session>
+bool
+request_processor<Session>::provide(
+        resource_map_type const* resource_map, method_map_type const* method_map,
+        request_type& request, session_flesh& _flesh)
+{
+    const string_view_type target = request.target();
     method_type method = request.method();
 
-    bool invoked = false;
-    if (method_map_) {
-        auto method_pos = static_cast<method_map_type const &>(*method_map_).find(method);
-        if (method_pos != method_map_->cend()) {
+    // Every match is found before the first handler runs, because a chain
+    // of handlers rewrites request.target() and frees the buffer viewed here.
+    // The vector is handed back afterwards to keep its capacity; there is
+    // one per level of mounted routers.
+    matches_type matched;
+    if (not matched_.empty()) {
+        matched = std::move(matched_.back());
+        matched_.pop_back();
+        matched.clear();
+    }
 
-            auto& resource_map = method_pos->second;
+    const std::size_t capacity = cache_capacity().load(std::memory_order_relaxed);
+    cache_type* const cache_p = capacity ? &local_cache(capacity) : nullptr;
+    const std::size_t generation = cache_p ? router<Session>::generation() : 0;
+    const typename cache_type::tables_type tables{resource_map, method_map};
 
-            for (auto __it_value = resource_map.cbegin();
-                 __it_value != resource_map.cend(); ++__it_value) {
-                if (regex_.match(__it_value->first, target.to_string())) {
-                    auto& storage = const_cast<storage_type&>(__it_value->second);
+    // A cached entry is copied out, a mounted router may reuse its slot
+    auto const cached = cache_p ? cache_p->find(generation, tables, method, target) : nullptr;
+    if (cached)
+        matched.assign(cached->begin(), cached->end());
+    else {
+        // Mounted routers come first, the routes of this one are tried
+        // only when none of them handles the request
+        if (resource_map)
+            collect_mounts(*resource_map, target, matched);
 
-                    this->execute(request, _flesh, storage);
-                    invoked = true;
-                }
+        const std::size_t mounts = matched.size();
+
+        // Set by a first-match map, so that a cached route is counted too
+        counted_ = nullptr;
+
+        if (method_map) {
+            auto method_pos = method_map->find(method);
+            if (method_pos != method_map->cend())
+                collect(method_pos->second, target, matched, 0);
+        }
+
+        if (resource_map and matched.size() == mounts)
+            collect(*resource_map, target, matched, 0);
+
+        if (cache_p)
+            cache_p->insert(generation, tables, method, target,
+                          typename cache_type::routes_type(matched.begin(), matched.end()),
+                          counted_);
+    }
+
+    bool handled = false;
+    for (const auto route : matched)
+        if (route->mount()) {
+            if (delegate(*route, request, _flesh)) {
+                handled = true;
+                break;
             }
         }
+        else {
+            this->execute(request, _flesh, const_cast<storage_type&>(route->storage()));
+            handled = true;
+        }
+
+    matched_.push_back(std::move(matched));
+
+    return handled;
+}
+
+template<class Session>
+bool
+request_processor<Session>::delegate(
+        route_type const& route, request_type& request, session_flesh& _flesh)
+{
+    auto const& other = *route.mount();
+
+    // The mounted router sees the target without the prefix, and the
+    // routes matched after this one see the original target again
+    const string_view_type target = request.target();
+    boost::container::small_vector<char, 128> original{target.begin(), target.end()};
+
+    request.target(string_view_type{original.data() + route.prefix().size(),
+                                    original.size() - route.prefix().size()});
+
+    bool handled = false;
+    {
+        BEASTHTTP_LOCKABLE_ENTER_TO_READ(other.mutex())
+
+        handled = provide(other.resource_map().get(), other.method_map().get(), request, _flesh);
     }
 
-    if (resource_map_ and not invoked)
-        for (auto __it_value = resource_map_->begin();
-             __it_value != resource_map_->end(); ++__it_value) {
-            if (regex_.match(__it_value->first, target.to_string())) {
-                auto& storage = const_cast<storage_type&>(__it_value->second);
+    request.target(string_view_type{original.data(), original.size()});
 
-                this->execute(request, _flesh, storage);
-            }
+    return handled;
+}
+
+template<class Session>
+bool
+request_processor<Session>::match(
+        route_type const& route, string_view_type target) const
+{
+    // A mount prefix is literal, and cheaper to compare than to match
+    // with its "(/.*)?" tail, unless the router ignores case
+    if (not route.mount() or (regex_.flags() & std::regex_constants::icase))
+        return regex_.match(route.regex(), target);
+
+    auto const& prefix = route.prefix();
+    return target.size() >= prefix.size()
+            and target.compare(0, prefix.size(), prefix) == 0
+            and (target.size() == prefix.size() or target[prefix.size()] == '/');
+}
+
+template<class Session>
+template<class ResourceMap>
+void
+request_processor<Session>::collect_mounts(
+        ResourceMap const& resource_map, string_view_type target,
+        matches_type& matched)
+{
+    for (auto __it_value = resource_map.cbegin();
+         __it_value != resource_map.cend(); ++__it_value)
+        if (__it_value->second.mount() and match(__it_value->second, target))
+            matched.push_back(&__it_value->second);
+}
+
+template<class Session>
+template<class ResourceMap>
+auto
+request_processor<Session>::collect(
+        ResourceMap const& resource_map, string_view_type target,
+        matches_type& matched, int)
+-> decltype (std::declval<ResourceMap const&>().fallback(), void())
+{
+    // The tree is case sensitive, so icase routes go through the regex scan
+    if (regex_.flags() & std::regex_constants::icase)
+        return collect(resource_map, target, matched, 0L);
+
+    resource_map.match(target, [&](typename ResourceMap::value_type const& value){
+        if (not value.second.mount())
+            matched.push_back(&value.second);
+    });
+
+    for (const auto& value : resource_map.fallback())
+        if (not value->second.mount() and match(value->second, target))
+            matched.push_back(&value->second);
+}
+
+template<class Session>
+template<class ResourceMap>
+auto
+request_processor<Session>::collect(
+        ResourceMap const& resource_map, string_view_type target,
+        matches_type& matched, int)
+-> decltype (std::declval<ResourceMap const&>().order(), void())
+{
+    for (const auto& value : resource_map.order())
+        if (not value.value().second.mount() and match(value.value().second, target)) {
+            value.hit();
+            counted_ = &value.counter();
+            matched.push_back(&value.value().second);
+
+            return;
         }
 }
 
+template<class Session>
+template<class ResourceMap>
+void
+request_processor<Session>::collect(
+        ResourceMap const& resource_map, string_view_type target,
+        matches_type& matched, long)
+{
+    scan(resource_map, target, [&](typename ResourceMap::value_type const& value){
+        if (not value.second.mount())
+            matched.push_back(&value.second);
+    }, 0);
+}
+
+template<class Session>
+template<class ResourceMap, class F, class Regex>
+auto
+request_processor<Session>::scan(
+        ResourceMap const& resource_map, string_view_type target, F&& f, int)
+-> decltype (std::declval<Regex const&>().match_all(
+                 std::declval<ResourceMap const&>(),
+                 std::declval<string_view_type>(), std::declval<F>()), bool())
+{
+    return regex_.match_all(resource_map, target, std::forward<F>(f));
+}
+
+template<class Session>
+template<class ResourceMap, class F>
+bool
+request_processor<Session>::scan(
+        ResourceMap const& resource_map, string_view_type target, F&& f, long)
+{
+    bool invoked = false;
+    for (auto __it_value = resource_map.cbegin();
+         __it_value != resource_map.cend(); ++__it_value) {
+        if (match(__it_value->second, target)) {
+            f(*__it_value);
+            invoked = true;
+        }
+    }
+
+    return invoked;
+}
+
 } // namespace base
 } // namespace http
 } // namespace _0xdead4ead
@@ -0,0 +1,65 @@
+#ifndef BEASTHTTP_BASE_IMPL_ROUTE_HXX
+#define BEASTHTTP_BASE_IMPL_ROUTE_HXX
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+template<class Regex, class Storage>
+route<Regex, Storage>::route(compiled_type&& regex, storage_type&& storage)
+    : regex_{std::move(regex)},
+      storage_{std::move(storage)},
+      mount_{nullptr}
+{
+}
+
+template<class Regex, class Storage>
+route<Regex, Storage>::route(compiled_type&& regex, storage_type&& storage,
+                             mount_type const* mount, std::string prefix)
+    : regex_{std::move(regex)},
+      storage_{std::move(storage)},
+      mount_{mount},
+      prefix_{std::move(prefix)}
+{
+}
+
+template<class Regex, class Storage>
+typename route<Regex, Storage>::compiled_type const&
+route<Regex, Storage>::regex() const
+{
+    return regex_;
+}
+
+template<class Regex, class Storage>
+typename route<Regex, Storage>::storage_type&
+route<Regex, Storage>::storage()
+{
+    return storage_;
+}
+
+template<class Regex, class Storage>
+typename route<Regex, Storage>::storage_type const&
+route<Regex, Storage>::storage() const
+{
+    return storage_;
+}
+
+template<class Regex, class Storage>
+typename route<Regex, Storage>::mount_type const*
+route<Regex, Storage>::mount() const
+{
+    return mount_;
+}
+
+template<class Regex, class Storage>
+std::string const&
+route<Regex, Storage>::prefix() const
+{
+    return prefix_;
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_ROUTE_HXX
@@ -0,0 +1,111 @@
+#ifndef BEASTHTTP_BASE_IMPL_ROUTE_CACHE_HXX
+#define BEASTHTTP_BASE_IMPL_ROUTE_CACHE_HXX
+
+#include <boost/functional/hash.hpp>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+template<class Route, class Method>
+constexpr std::size_t route_cache<Route, Method>::max_target;
+
+template<class Route, class Method>
+route_cache<Route, Method>::route_cache(std::size_t capacity)
+    : hits_{0},
+      misses_{0}
+{
+    std::size_t size = capacity ? 1 : 0;
+    while (size < capacity)
+        size <<= 1;
+
+    entries_.resize(size);
+}
+
+template<class Route, class Method>
+std::size_t
+route_cache<Route, Method>::capacity() const
+{
+    return entries_.size();
+}
+
+template<class Route, class Method>
+typename route_cache<Route, Method>::routes_type const*
+route_cache<Route, Method>::find(std::size_t generation, tables_type const& tables,
+                                 method_type method, string_view_type target)
+{
+    if (entries_.empty())
+        return nullptr;
+
+    entry const& e = slot(method, target);
+    if (e.tables == tables and e.generation == generation
+            and e.method == method and target == e.target) {
+        ++hits_;
+        if (e.counter != nullptr)
+            e.counter->hit();
+
+        return &e.routes;
+    }
+
+    ++misses_;
+    return nullptr;
+}
+
+template<class Route, class Method>
+void
+route_cache<Route, Method>::insert(std::size_t generation, tables_type const& tables,
+                                   method_type method, string_view_type target,
+                                   routes_type const& routes,
+                                   hit_counter const* counter)
+{
+    if (entries_.empty() or target.size() > max_target)
+        return;
+
+    entry& e = slot(method, target);
+    e.generation = generation;
+    e.tables = tables;
+    e.method = method;
+    e.target.assign(target.data(), target.size());
+    e.routes = routes;
+    e.counter = counter;
+}
+
+template<class Route, class Method>
+std::size_t
+route_cache<Route, Method>::hits() const
+{
+    return hits_;
+}
+
+template<class Route, class Method>
+std::size_t
+route_cache<Route, Method>::misses() const
+{
+    return misses_;
+}
+
+template<class Route, class Method>
+void
+route_cache<Route, Method>::clear()
+{
+    for (auto& e : entries_)
+        e = entry{};
+
+    hits_ = misses_ = 0;
+}
+
+template<class Route, class Method>
+typename route_cache<Route, Method>::entry&
+route_cache<Route, Method>::slot(method_type method, string_view_type target)
+{
+    std::size_t seed = boost::hash_range(target.begin(), target.end());
+    boost::hash_combine(seed, static_cast<std::size_t>(method));
+
+    return entries_[seed & (entries_.size() - 1)];
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_ROUTE_CACHE_HXX
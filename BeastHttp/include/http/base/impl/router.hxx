@@ -1,16 +1,21 @@
 #ifndef BEASTHTTP_BASE_IMPL_ROUTER_HXX
 #define BEASTHTTP_BASE_IMPL_ROUTER_HXX
 
+#include <stdexcept>
+
 namespace _0xdead4ead {
 namespace http {
 namespace base {
 
 template<class Session>
 router<Session>::router(std::shared_ptr<resource_map_type>& resource_map,
-                        std::shared_ptr<method_map_type>& method_map) noexcept
+                        std::shared_ptr<method_map_type>& method_map,
+                        regex_flag_type flags) noexcept
     : resource_map_{resource_map},
-      method_map_{method_map}
+      method_map_{method_map},
+      regex_{flags}
 {
+    counter().fetch_add(1, std::memory_order_release);
 }
 
 template<class Session>
@@ -27,11 +32,17 @@ router<Session>::add_resource_cb(
     if (not method_map_)
         method_map_ = std::make_shared<method_map_type>();
 
+    route_type route{regex_.compile(path_to_resource), std::move(storage)};
+
     auto& resource_map = method_map_->insert({method, resource_map_type()}).first->second;
 
-    auto _res = resource_map.emplace(path_to_resource, std::move(storage));
-    if (!_res.second)
-        _res.first->second = std::move(storage);
+    auto _pos = resource_map.find(path_to_resource);
+    if (_pos != resource_map.end())
+        _pos->second = std::move(route);
+    else
+        resource_map.emplace(path_to_resource, std::move(route));
+
+    changed();
 }
 
 template<class Session>
@@ -44,12 +55,18 @@ router<Session>::add_resource_cb_without_method(
 
     BEASTHTTP_LOCKABLE_ENTER_TO_WRITE(mutex_)
 
+    route_type route{regex_.compile(path_to_resource), std::move(storage)};
+
     if (not resource_map_)
         resource_map_ = std::make_shared<resource_map_type>();
 
-    auto _res = resource_map_->emplace(path_to_resource, std::move(storage));
-    if (!_res.second)
-        _res.first->second = std::move(storage);
+    auto _pos = resource_map_->find(path_to_resource);
+    if (_pos != resource_map_->end())
+        _pos->second = std::move(route);
+    else
+        resource_map_->emplace(path_to_resource, std::move(route));
+
+    changed();
 }
 
 template<class Session>
@@ -59,9 +76,27 @@ router<Session>::use(resource_regex_type const& path_to_resource,
 {
     BEASTHTTP_LOCKABLE_ENTER_TO_READ(other.mutex())
 
+    // The copied routes are published together
+    const batch_guard guard{*this};
+
+    resource_regex_type prefix;
+    const bool literal = literal_prefix(path_to_resource, prefix);
+
     if (other.resource_map_)
         for (const auto& value : *other.resource_map_) {
-            auto storage = *value.second;
+            // Under a regex prefix, the routes of a mounted router are
+            // copied as well
+            if (value.second.mount()) {
+                if (literal)
+                    add_mount(prefix + value.second.prefix(), *value.second.mount());
+                else
+                    use(concat(path_to_resource, value.second.prefix()),
+                        *value.second.mount());
+
+                continue;
+            }
+
+            auto storage = value.second.storage();
             add_resource_cb_without_method(
                         concat(path_to_resource, value.first),
                         std::move(storage));
@@ -73,13 +108,25 @@ router<Session>::use(resource_regex_type const& path_to_resource,
             const auto& resource_map = value_m.second;
 
             for (const auto& value_r : resource_map) {
-                auto storage = *value_r.second;
+                auto storage = value_r.second.storage();
                 add_resource_cb(concat(path_to_resource, value_r.first),
                                 method, std::move(storage));
             }
         }
 }
 
+template<class Session>
+void
+router<Session>::mount(resource_regex_type const& path_to_resource,
+                       self_type const& other)
+{
+    resource_regex_type prefix;
+    if (not literal_prefix(path_to_resource, prefix))
+        throw std::invalid_argument{"mount: the prefix is not a literal path"};
+
+    add_mount(prefix, other);
+}
+
 template<class Session>
 template<class DerivedRouter, class Pack>
 auto
@@ -111,6 +158,120 @@ router<Session>::mutex() const
     return const_cast<mutex_type&>(mutex_);
 }
 
+template<class Session>
+void
+router<Session>::priority(resource_regex_type const& path_to_resource, int value)
+{
+    BEASTHTTP_LOCKABLE_ENTER_TO_WRITE(mutex_)
+
+    bool found = false;
+    if (resource_map_)
+        found = resource_map_->prioritize(path_to_resource, value);
+
+    if (method_map_)
+        for (auto& value_m : *method_map_)
+            found = value_m.second.prioritize(path_to_resource, value) or found;
+
+    if (found)
+        changed();
+}
+
+template<class Session>
+void
+router<Session>::reorder()
+{
+    BEASTHTTP_LOCKABLE_ENTER_TO_WRITE(mutex_)
+
+    if (resource_map_)
+        resource_map_->reorder();
+
+    if (method_map_)
+        for (auto& value_m : *method_map_)
+            value_m.second.reorder();
+
+    changed();
+}
+
+template<class Session>
+void
+router<Session>::enable_snapshot()
+{
+    BEASTHTTP_LOCKABLE_ENTER_TO_WRITE(mutex_)
+
+    if (not snapshot_)
+        publish();
+}
+
+template<class Session>
+router<Session>::batch_guard::batch_guard(router& owner)
+    : owner_{&owner}
+{
+    BEASTHTTP_LOCKABLE_ENTER_TO_WRITE(owner.mutex_)
+
+    owner.batches_++;
+}
+
+template<class Session>
+router<Session>::batch_guard::batch_guard(self_type&& other) noexcept
+    : owner_{other.owner_}
+{
+    other.owner_ = nullptr;
+}
+
+template<class Session>
+router<Session>::batch_guard::~batch_guard()
+{
+    if (owner_ != nullptr)
+        owner_->end_batch();
+}
+
+template<class Session>
+typename router<Session>::batch_guard
+router<Session>::batch()
+{
+    return batch_guard{*this};
+}
+
+template<class Session>
+void
+router<Session>::end_batch()
+{
+    BEASTHTTP_LOCKABLE_ENTER_TO_WRITE(mutex_)
+
+    if (--batches_ != 0 or not pending_)
+        return;
+
+    pending_ = false;
+
+    // Route caches may hold routes resolved from the previous snapshot
+    counter().fetch_add(1, std::memory_order_release);
+
+    publish();
+}
+
+template<class Session>
+void
+router<Session>::dispatch(dispatcher_type dispatcher)
+{
+    BEASTHTTP_LOCKABLE_ENTER_TO_WRITE(mutex_)
+
+    dispatcher_ = std::make_shared<dispatcher_type const>(std::move(dispatcher));
+
+    changed();
+
+    if (not snapshot_)
+        publish();
+}
+
+template<class Session>
+std::shared_ptr<typename router<Session>::snapshot_type const>
+router<Session>::snapshot() const
+{
+    BEASTHTTP_LOCKABLE_ENTER_TO_READ(mutex())
+
+    return snapshot_;
+}
+
 template<class Session>
 typename router<Session>::resource_regex_type
 router<Session>::concat(const resource_regex_type& resource1,
@@ -130,6 +291,124 @@ router<Session>::concat(const resource_regex_type& resource1,
     return result;
 }
 
+template<class Session>
+bool
+router<Session>::literal_prefix(const resource_regex_type& path_to_resource,
+                                resource_regex_type& result)
+{
+    segment_pattern::parts_type parts;
+    const bool literal = segment_pattern::parse(path_to_resource, parts)
+            and parts.size() <= 1
+            and (parts.empty() or parts.front().type == segment_pattern::kind::literal);
+
+    if (not literal)
+        return false;
+
+    result = parts.empty() ? resource_regex_type{} : parts.front().text;
+    while (not result.empty() and result.back() == '/')
+        result.pop_back();
+
+    return true;
+}
+
+template<class Session>
+void
+router<Session>::add_mount(resource_regex_type const& prefix,
+                           self_type const& other)
+{
+    assert(&other != this);
+
+    const resource_regex_type path_to_resource = "^" + prefix + "(/.*)?$";
+
+    BEASTHTTP_LOCKABLE_ENTER_TO_WRITE(mutex_)
+
+    // The storage is never executed, the request processor hands the
+    // request over to the mounted router instead
+    route_type route{regex_.compile(path_to_resource),
+                storage_type{[](request_type&, context_type){}},
+                &other, prefix};
+
+    if (not resource_map_)
+        resource_map_ = std::make_shared<resource_map_type>();
+
+    auto _pos = resource_map_->find(path_to_resource);
+    if (_pos != resource_map_->end())
+        _pos->second = std::move(route);
+    else
+        resource_map_->emplace(path_to_resource, std::move(route));
+
+    changed();
+}
+
+template<class Session>
+std::size_t
+router<Session>::generation()
+{
+    return counter().load(std::memory_order_acquire);
+}
+
+template<class Session>
+std::atomic<std::size_t>&
+router<Session>::counter()
+{
+    static std::atomic<std::size_t> value{0};
+    return value;
+}
+
+template<class Session>
+void
+router<Session>::changed()
+{
+    counter().fetch_add(1, std::memory_order_release);
+
+    // Maps may have been reordered in place
+    invalidate<regex_type>(0);
+
+    if (snapshot_ and batches_ != 0)
+        pending_ = true;
+    else if (snapshot_)
+        publish();
+}
+
+template<class Session>
+void
+router<Session>::publish()
+{
+    std::shared_ptr<resource_map_type const> resource_map;
+    if (resource_map_)
+        resource_map = std::make_shared<resource_map_type>(*resource_map_);
+
+    std::shared_ptr<method_map_type const> method_map;
+    if (method_map_)
+        method_map = std::make_shared<method_map_type>(*method_map_);
+
+    auto next = std::make_shared<snapshot_type>(
+                std::move(resource_map), std::move(method_map), dispatcher_);
+
+    if (snapshot_)
+        snapshot_->supersede(next);
+
+    snapshot_ = std::move(next);
+
+    // The copies may reuse the addresses of maps freed since
+    invalidate<regex_type>(0);
+}
+
+template<class Session>
+template<class Regex>
+auto
+router<Session>::invalidate(int) -> decltype (Regex::invalidate(), void())
+{
+    Regex::invalidate();
+}
+
+template<class Session>
+template<class Regex>
+void
+router<Session>::invalidate(long)
+{
+}
+
 } // namespace base
 } // namespace http
 } // namespace _0xdead4ead
@@ -0,0 +1,208 @@
+#ifndef BEASTHTTP_BASE_IMPL_SEGMENT_PATTERN_HXX
+#define BEASTHTTP_BASE_IMPL_SEGMENT_PATTERN_HXX
+
+#include <boost/container/small_vector.hpp>
+
+#include <cctype>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+bool
+segment_pattern::parse(const std::string& pattern, parts_type& parts)
+{
+    std::size_t first = 0, last = pattern.size();
+    if (first < last and pattern[first] == '^')
+        ++first;
+    if (first < last and pattern[last - 1] == '$')
+        --last;
+
+    const string_view_type path{pattern.data() + first, last - first};
+
+    parts.clear();
+
+    std::string literal;
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        std::size_t end;
+        kind type;
+        std::string name;
+        if (i > 0 and path[i - 1] == '/' and segment(path, i, end, type, name)) {
+            if (not literal.empty())
+                parts.push_back(part{kind::literal, std::move(literal)});
+            literal.clear();
+            parts.push_back(part{type, std::move(name)});
+            i = end - 1;
+            continue;
+        }
+
+        switch (path[i]) {
+        case '\\': case '.': case '*': case '+': case '?': case '|':
+        case '(': case ')': case '[': case ']': case '{': case '}':
+        case '^': case '$':
+            parts.clear();
+            return false;
+        default:
+            break;
+        }
+
+        literal.push_back(path[i]);
+    }
+
+    if (not literal.empty())
+        parts.push_back(part{kind::literal, std::move(literal)});
+
+    return true;
+}
+
+std::string
+segment_pattern::expression(kind type)
+{
+    switch (type) {
+    case kind::integer:
+        return "([-+]?[0-9]+)";
+    case kind::unsigned_integer:
+        return "([0-9]+)";
+    case kind::rest:
+        return "(.*)";
+    default:
+        return "([^/]+)";
+    }
+}
+
+bool
+segment_pattern::segment(string_view_type text, std::size_t pos,
+                         std::size_t& end, kind& type, std::string& name)
+{
+    const auto is_head = [](char c){
+        return std::isalpha(static_cast<unsigned char>(c)) or c == '_';
+    };
+
+    const auto is_tail = [](char c){
+        return std::isalnum(static_cast<unsigned char>(c)) or c == '_';
+    };
+
+    if (pos + 1 >= text.size() or (text[pos] != '{' and text[pos] != ':')
+            or not is_head(text[pos + 1]))
+        return false;
+
+    std::size_t j = pos + 1;
+    while (j < text.size() and is_tail(text[j]))
+        ++j;
+
+    name.assign(text.data() + pos + 1, j - pos - 1);
+    type = kind::string;
+
+    if (text[pos] == '{') {
+        if (j < text.size() and text[j] == ':') {
+            const std::size_t close = text.find('}', j);
+            if (close == string_view_type::npos)
+                return false;
+
+            const string_view_type spec = text.substr(j + 1, close - j - 1);
+            if (spec == "int")
+                type = kind::integer;
+            else if (spec == "uint")
+                type = kind::unsigned_integer;
+            else if (spec == "*")
+                type = kind::rest;
+            else if (spec != "str")
+                return false;
+
+            j = close;
+        }
+
+        if (j == text.size() or text[j] != '}')
+            return false;
+
+        ++j;
+    }
+
+    if (type == kind::rest ? j != text.size() : (j != text.size() and text[j] != '/'))
+        return false;
+
+    end = j;
+    return true;
+}
+
+bool
+segment_pattern::accepts(kind type, string_view_type value)
+{
+    std::size_t i = 0;
+    switch (type) {
+    case kind::rest:
+        return true;
+    case kind::integer:
+        if (not value.empty() and (value[0] == '-' or value[0] == '+'))
+            i = 1;
+        // fallthrough
+    case kind::unsigned_integer:
+        if (i == value.size())
+            return false;
+        for (; i < value.size(); ++i)
+            if (value[i] < '0' or value[i] > '9')
+                return false;
+        return true;
+    default:
+        return not value.empty() and value.find('/') == string_view_type::npos;
+    }
+}
+
+bool
+segment_pattern::assign(const std::string& pattern)
+{
+    return parse(pattern, parts_);
+}
+
+segment_pattern::parts_type const&
+segment_pattern::parts() const
+{
+    return parts_;
+}
+
+template<class F>
+bool
+segment_pattern::match(string_view_type target, F&& f) const
+{
+    // Captures are handed out only once the whole target matched
+    boost::container::small_vector<string_view_type, 8> captures;
+
+    std::size_t pos = 0;
+    for (const auto& p : parts_) {
+        if (p.type == kind::literal) {
+            if (target.substr(pos, p.text.size()) != p.text)
+                return false;
+
+            pos += p.text.size();
+            continue;
+        }
+
+        std::size_t end = target.size();
+        if (p.type != kind::rest) {
+            end = target.find('/', pos);
+            if (end == string_view_type::npos)
+                end = target.size();
+        }
+
+        const string_view_type value = target.substr(pos, end - pos);
+        if (not accepts(p.type, value))
+            return false;
+
+        captures.push_back(value);
+        pos = end;
+    }
+
+    if (pos != target.size())
+        return false;
+
+    for (const auto& value : captures)
+        f(value);
+
+    return true;
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_SEGMENT_PATTERN_HXX
@@ -0,0 +1,67 @@
+#ifndef BEASTHTTP_BASE_IMPL_SNAPSHOT_HXX
+#define BEASTHTTP_BASE_IMPL_SNAPSHOT_HXX
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+template<class ResourceMap, class MethodMap, class Dispatcher>
+snapshot<ResourceMap, MethodMap, Dispatcher>::snapshot(
+        std::shared_ptr<resource_map_type const> resource_map,
+        std::shared_ptr<method_map_type const> method_map,
+        std::shared_ptr<dispatcher_type const> dispatcher)
+    : resource_map_{std::move(resource_map)},
+      method_map_{std::move(method_map)},
+      dispatcher_{std::move(dispatcher)},
+      stale_{false}
+{
+}
+
+template<class ResourceMap, class MethodMap, class Dispatcher>
+std::shared_ptr<typename snapshot<ResourceMap, MethodMap, Dispatcher>::resource_map_type const> const&
+snapshot<ResourceMap, MethodMap, Dispatcher>::resource_map() const
+{
+    return resource_map_;
+}
+
+template<class ResourceMap, class MethodMap, class Dispatcher>
+std::shared_ptr<typename snapshot<ResourceMap, MethodMap, Dispatcher>::method_map_type const> const&
+snapshot<ResourceMap, MethodMap, Dispatcher>::method_map() const
+{
+    return method_map_;
+}
+
+template<class ResourceMap, class MethodMap, class Dispatcher>
+std::shared_ptr<typename snapshot<ResourceMap, MethodMap, Dispatcher>::dispatcher_type const> const&
+snapshot<ResourceMap, MethodMap, Dispatcher>::dispatcher() const
+{
+    return dispatcher_;
+}
+
+template<class ResourceMap, class MethodMap, class Dispatcher>
+bool
+snapshot<ResourceMap, MethodMap, Dispatcher>::stale() const
+{
+    return stale_.load(std::memory_order_acquire);
+}
+
+template<class ResourceMap, class MethodMap, class Dispatcher>
+std::shared_ptr<typename snapshot<ResourceMap, MethodMap, Dispatcher>::self_type const> const&
+snapshot<ResourceMap, MethodMap, Dispatcher>::next() const
+{
+    return next_;
+}
+
+template<class ResourceMap, class MethodMap, class Dispatcher>
+void
+snapshot<ResourceMap, MethodMap, Dispatcher>::supersede(std::shared_ptr<self_type const> const& next)
+{
+    next_ = next;
+    stale_.store(true, std::memory_order_release);
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_SNAPSHOT_HXX
@@ -0,0 +1,79 @@
+#ifndef BEASTHTTP_BASE_IMPL_STATIC_REGEX_HXX
+#define BEASTHTTP_BASE_IMPL_STATIC_REGEX_HXX
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+static_regex::static_regex(flag_type flags)
+    : regex_{flags}
+{
+}
+
+static_regex::flag_type
+static_regex::flags() const
+{
+    return regex_.flags();
+}
+
+static_regex::compiled_type
+static_regex::compile(const std::string& regx) const
+{
+    compiled_type result;
+
+    // The generated code knows nothing of flags other than ECMAScript ones
+    if (not (flags() & (std::regex_constants::icase | std::regex_constants::basic
+                        | std::regex_constants::extended | std::regex_constants::awk
+                        | std::regex_constants::grep | std::regex_constants::egrep)))
+        result.matcher_ = find(regx);
+
+    if (not result.matcher_)
+        result.expression_ = regex_.compile(regx);
+
+    return result;
+}
+
+bool
+static_regex::match(const compiled_type& e, string_view_type str) const
+{
+    if (e.matcher_)
+        return e.matcher_(str.data(), str.data() + str.size());
+
+    return regex_.match(e.expression_, str);
+}
+
+void
+static_regex::define(const std::string& regx, matcher_type matcher)
+{
+    std::lock_guard<std::mutex> lock{mutex()};
+    registry()[regx] = matcher;
+}
+
+static_regex::matcher_type
+static_regex::find(const std::string& regx)
+{
+    std::lock_guard<std::mutex> lock{mutex()};
+
+    auto const pos = registry().find(regx);
+    return pos != registry().end() ? pos->second : nullptr;
+}
+
+std::unordered_map<std::string, static_regex::matcher_type>&
+static_regex::registry()
+{
+    static std::unordered_map<std::string, matcher_type> value;
+    return value;
+}
+
+std::mutex&
+static_regex::mutex()
+{
+    static std::mutex value;
+    return value;
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_STATIC_REGEX_HXX
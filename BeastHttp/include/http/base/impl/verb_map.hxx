@@ -0,0 +1,216 @@
+#ifndef BEASTHTTP_BASE_IMPL_VERB_MAP_HXX
+#define BEASTHTTP_BASE_IMPL_VERB_MAP_HXX
+
+#include <stdexcept>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+template<class Key, class Value, class... Args>
+constexpr typename verb_map<Key, Value, Args...>::size_type
+verb_map<Key, Value, Args...>::capacity;
+
+template<class Key, class Value, class... Args>
+verb_map<Key, Value, Args...>::verb_map(self_type const& other)
+    : mask_{other.mask_},
+      size_{other.size_}
+{
+    for (size_type i = 0; i < capacity; ++i)
+        if (other.slots_[i])
+            slots_[i].reset(new value_type(*other.slots_[i]));
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::self_type&
+verb_map<Key, Value, Args...>::operator=(self_type const& other)
+{
+    if (this != &other) {
+        self_type copy{other};
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::iterator
+verb_map<Key, Value, Args...>::begin()
+{
+    return iterator{this, next(0)};
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::iterator
+verb_map<Key, Value, Args...>::end()
+{
+    return iterator{this, capacity};
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::const_iterator
+verb_map<Key, Value, Args...>::begin() const
+{
+    return const_iterator{this, next(0)};
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::const_iterator
+verb_map<Key, Value, Args...>::end() const
+{
+    return const_iterator{this, capacity};
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::const_iterator
+verb_map<Key, Value, Args...>::cbegin() const
+{
+    return begin();
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::const_iterator
+verb_map<Key, Value, Args...>::cend() const
+{
+    return end();
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::size_type
+verb_map<Key, Value, Args...>::size() const
+{
+    return size_;
+}
+
+template<class Key, class Value, class... Args>
+bool
+verb_map<Key, Value, Args...>::empty() const
+{
+    return mask_ == 0;
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::iterator
+verb_map<Key, Value, Args...>::find(key_type const& key)
+{
+    auto const pos = index(key);
+    return iterator{this, contains(pos) ? pos : capacity};
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::const_iterator
+verb_map<Key, Value, Args...>::find(key_type const& key) const
+{
+    auto const pos = index(key);
+    return const_iterator{this, contains(pos) ? pos : capacity};
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::mapped_type&
+verb_map<Key, Value, Args...>::at(key_type const& key)
+{
+    auto const pos = index(key);
+    if (not contains(pos))
+        throw std::out_of_range{"verb_map::at"};
+
+    return slots_[pos]->second;
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::mapped_type const&
+verb_map<Key, Value, Args...>::at(key_type const& key) const
+{
+    auto const pos = index(key);
+    if (not contains(pos))
+        throw std::out_of_range{"verb_map::at"};
+
+    return slots_[pos]->second;
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::mapped_type&
+verb_map<Key, Value, Args...>::operator[](key_type const& key)
+{
+    return emplace(key, mapped_type{}).first->second;
+}
+
+template<class Key, class Value, class... Args>
+std::pair<typename verb_map<Key, Value, Args...>::iterator, bool>
+verb_map<Key, Value, Args...>::insert(value_type const& value)
+{
+    auto const pos = index(value.first);
+    if (contains(pos))
+        return {iterator{this, pos}, false};
+
+    return assign(std::unique_ptr<value_type>{new value_type(value)});
+}
+
+template<class Key, class Value, class... Args>
+std::pair<typename verb_map<Key, Value, Args...>::iterator, bool>
+verb_map<Key, Value, Args...>::insert(value_type&& value)
+{
+    auto const pos = index(value.first);
+    if (contains(pos))
+        return {iterator{this, pos}, false};
+
+    return assign(std::unique_ptr<value_type>{new value_type(std::move(value))});
+}
+
+template<class Key, class Value, class... Args>
+template<class... Params>
+std::pair<typename verb_map<Key, Value, Args...>::iterator, bool>
+verb_map<Key, Value, Args...>::emplace(Params&&... params)
+{
+    std::unique_ptr<value_type> value{new value_type(std::forward<Params>(params)...)};
+
+    auto const pos = index(value->first);
+    if (contains(pos))
+        return {iterator{this, pos}, false};
+
+    return assign(std::move(value));
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::size_type
+verb_map<Key, Value, Args...>::index(key_type const& key)
+{
+    return static_cast<size_type>(key);
+}
+
+template<class Key, class Value, class... Args>
+bool
+verb_map<Key, Value, Args...>::contains(size_type pos) const
+{
+    return pos < capacity and (mask_ >> pos) & 1;
+}
+
+template<class Key, class Value, class... Args>
+typename verb_map<Key, Value, Args...>::size_type
+verb_map<Key, Value, Args...>::next(size_type pos) const
+{
+    while (pos < capacity and not contains(pos))
+        ++pos;
+
+    return pos;
+}
+
+template<class Key, class Value, class... Args>
+std::pair<typename verb_map<Key, Value, Args...>::iterator, bool>
+verb_map<Key, Value, Args...>::assign(std::unique_ptr<value_type>&& value)
+{
+    auto const pos = index(value->first);
+    if (pos >= capacity)
+        throw std::out_of_range{"verb_map: unknown verb"};
+
+    slots_[pos] = std::move(value);
+    mask_ |= std::uint64_t{1} << pos;
+    ++size_;
+
+    return {iterator{this, pos}, true};
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_VERB_MAP_HXX
@@ -0,0 +1,189 @@
+#ifndef BEASTHTTP_BASE_IMPL_WRITE_BATCH_HXX
+#define BEASTHTTP_BASE_IMPL_WRITE_BATCH_HXX
+
+#include <boost/beast/http/empty_body.hpp>
+#include <boost/beast/http/serializer.hpp>
+#include <boost/beast/http/span_body.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/vector_body.hpp>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+template<class Body>
+struct write_batch::references : std::false_type
+{
+};
+
+template<class CharT, class Traits, class Allocator>
+struct write_batch::references<
+        boost::beast::http::basic_string_body<CharT, Traits, Allocator>> : std::true_type
+{
+};
+
+template<class T, class Allocator>
+struct write_batch::references<
+        boost::beast::http::vector_body<T, Allocator>> : std::true_type
+{
+};
+
+template<class T>
+struct write_batch::references<
+        boost::beast::http::span_body<T>> : std::true_type
+{
+};
+
+template<>
+struct write_batch::references<
+        boost::beast::http::empty_body> : std::true_type
+{
+};
+
+struct write_batch::collect
+{
+    write_batch& batch;
+
+    bool reference;
+
+    std::size_t& bytes;
+
+    template<class ConstBufferSequence>
+    void
+    operator()(boost::beast::error_code&, ConstBufferSequence const& buffers) const
+    {
+        bytes = 0;
+
+        for (auto it = boost::asio::buffer_sequence_begin(buffers);
+             it != boost::asio::buffer_sequence_end(buffers); ++it) {
+            boost::asio::const_buffer buffer{*it};
+            if (buffer.size() == 0)
+                continue;
+
+            bytes += buffer.size();
+
+            if (reference) {
+                batch.pieces_.push_back({buffer.data(), 0, buffer.size()});
+                continue;
+            }
+
+            // Copied pieces next to each other are joined in one buffer
+            if (not batch.pieces_.empty() and batch.pieces_.back().data == nullptr
+                    and batch.pieces_.back().offset + batch.pieces_.back().size == batch.storage_.size())
+                batch.pieces_.back().size += buffer.size();
+            else
+                batch.pieces_.push_back({nullptr, batch.storage_.size(), buffer.size()});
+
+            batch.storage_.append(static_cast<const char*>(buffer.data()), buffer.size());
+        }
+    }
+
+}; // struct collect
+
+inline
+write_batch::write_batch(std::size_t limit)
+    : limit_{limit}
+{
+}
+
+inline std::size_t
+write_batch::limit() const
+{
+    return limit_;
+}
+
+inline void
+write_batch::limit(std::size_t limit)
+{
+    limit_ = limit;
+}
+
+template<class Body, class Fields>
+bool
+write_batch::append(boost::beast::http::response<Body, Fields>& response)
+{
+    const bool reference = references<Body>::value and not response.chunked();
+
+    if (not reference) {
+        auto const payload = response.payload_size();
+        if (response.chunked() or not payload or storage_.size() + *payload > limit_)
+            return false;
+    }
+
+    const std::size_t pieces = pieces_.size(), stored = storage_.size();
+
+    boost::beast::http::response_serializer<Body, Fields> serializer{response};
+    serializer.split(true);
+
+    boost::beast::error_code ec;
+    std::size_t bytes = 0;
+
+    while (not serializer.is_done()) {
+        const bool body = serializer.is_header_done();
+
+        serializer.next(ec, collect{*this, body and reference, bytes});
+        if (ec or storage_.size() > limit_) {
+            rollback(pieces, stored);
+            return false;
+        }
+
+        serializer.consume(bytes);
+    }
+
+    ++responses_;
+    need_eof_ = response.need_eof();
+
+    return true;
+}
+
+inline std::size_t
+write_batch::size() const
+{
+    return responses_;
+}
+
+inline bool
+write_batch::need_eof() const
+{
+    return need_eof_;
+}
+
+inline write_batch::const_buffers_type const&
+write_batch::buffers()
+{
+    buffers_.clear();
+
+    // The storage grows while responses are appended, so copied pieces
+    // keep an offset until then
+    for (auto const& item : pieces_)
+        buffers_.emplace_back(item.data ? item.data : &storage_[item.offset], item.size);
+
+    return buffers_;
+}
+
+inline void
+write_batch::clear()
+{
+    responses_ = 0;
+    need_eof_ = false;
+    storage_.clear();
+    pieces_.clear();
+    buffers_.clear();
+}
+
+inline void
+write_batch::rollback(std::size_t pieces, std::size_t stored)
+{
+    pieces_.resize(pieces);
+    storage_.resize(stored);
+
+    // A copied piece joined with the rejected response is cut back
+    if (not pieces_.empty() and pieces_.back().data == nullptr)
+        pieces_.back().size = stored - pieces_.back().offset;
+}
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_BASE_IMPL_WRITE_BATCH_HXX
@@ -0,0 +1,142 @@
+#ifndef BEASTHTTP_BASE_INPLACE_FUNCTION_HXX
+#define BEASTHTTP_BASE_INPLACE_FUNCTION_HXX
+
+#include <http/base/traits.hxx>
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#ifndef BEASTHTTP_INPLACE_FUNCTION_CAPACITY
+#define BEASTHTTP_INPLACE_FUNCTION_CAPACITY (8 * sizeof (void*))
+#endif // BEASTHTTP_INPLACE_FUNCTION_CAPACITY
+
+#define BEASTHTTP_DECLARE_INPLACE_FUNCTION_TEMPLATE \
+    template<class R, class... Args, std::size_t Capacity>
+
+#define BEASTHTTP_INPLACE_FUNCTION_TYPE \
+    basic_inplace_function<R (Args...), Capacity>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+template<class Signature, std::size_t Capacity>
+class basic_inplace_function;
+
+/**
+  @brief Type erased callable stored inside the object itself
+
+  A target that fits in Capacity, and whose move cannot throw, is kept in
+  the object itself; a larger one is moved to the heap, as std::function
+  would do with it. Moving a wrapper therefore never throws. Calls go
+  through a single table of function pointers shared by all wrappers of
+  the same target type. A null function pointer or an empty std::function
+  makes an empty wrapper.
+*/
+template<class R, class... Args, std::size_t Capacity>
+class basic_inplace_function<R (Args...), Capacity>
+{
+    using self_type = basic_inplace_function;
+
+    using storage_type = typename std::aligned_storage<
+        Capacity, alignof (std::max_align_t)>::type;
+
+    static_assert (Capacity >= sizeof (void*), "Capacity is too small!");
+
+    struct vtable_type
+    {
+        R (*invoke)(void*, Args&&...);
+        void (*copy)(void*, void const*);
+        void (*move)(void*, void*);
+        void (*destroy)(void*);
+    };
+
+    template<class F>
+    struct target;
+
+    template<class F>
+    struct remote;
+
+    struct empty;
+
+    template<class F>
+    using fits = std::integral_constant<bool,
+        sizeof (F) <= Capacity
+        && alignof (F) <= alignof (storage_type)
+        && std::is_nothrow_move_constructible<F>::value>;
+
+    template<class F>
+    static auto
+    is_null(F const& f, int) -> decltype (static_cast<bool>(f == nullptr));
+
+    template<class F>
+    static bool
+    is_null(F const&, long);
+
+public:
+
+    using result_type = R;
+
+    static constexpr std::size_t capacity = Capacity;
+
+    basic_inplace_function() noexcept;
+
+    basic_inplace_function(std::nullptr_t) noexcept;
+
+    template<class F,
+             typename = typename std::enable_if<
+                 not std::is_same<typename std::decay<F>::type, self_type>::value
+                 && traits::TryInvoke<typename std::decay<F>::type&, R (Args...)>::value
+                 >::type
+             >
+    basic_inplace_function(F&&);
+
+    basic_inplace_function(self_type const&);
+
+    basic_inplace_function(self_type&&) noexcept;
+
+    ~basic_inplace_function();
+
+    self_type&
+    operator=(self_type const&);
+
+    self_type&
+    operator=(self_type&&) noexcept;
+
+    self_type&
+    operator=(std::nullptr_t) noexcept;
+
+    explicit
+    operator bool() const noexcept;
+
+    R
+    operator()(Args...) const;
+
+private:
+
+    template<class F, class G>
+    void
+    emplace(G&&, std::true_type);
+
+    template<class F, class G>
+    void
+    emplace(G&&, std::false_type);
+
+    vtable_type const* vtable_;
+    mutable storage_type storage_;
+
+}; // class basic_inplace_function
+
+template<class Signature>
+using inplace_function = basic_inplace_function<
+    Signature, BEASTHTTP_INPLACE_FUNCTION_CAPACITY>;
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/inplace_function.hxx>
+
+#endif // not defined BEASTHTTP_BASE_INPLACE_FUNCTION_HXX
@@ -0,0 +1,154 @@
+#ifndef BEASTHTTP_BASE_ORDERED_MAP_HXX
+#define BEASTHTTP_BASE_ORDERED_MAP_HXX
+
+#include <http/base/hit_counter.hxx>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+/**
+  @brief Resource map with first-match-wins dispatch
+
+  Drop-in replacement for the ResourceMap container of a session.
+  Routes are tried in order(), and only the first matching one runs.
+  The order is by explicit priority (higher first), then by traffic as
+  of the last reorder(), then by registration. Hits are counted per
+  thread, by a per-route hit_counter shared between copies of the map,
+  so reorder() works on a router publishing snapshots too.
+*/
+template<class Key, class Value, class... Args>
+class ordered_map
+{
+    using self_type = ordered_map;
+
+    using container_type = std::map<Key, Value>;
+
+public:
+
+    using key_type = Key;
+
+    using mapped_type = Value;
+
+    using value_type = typename container_type::value_type;
+
+    using size_type = typename container_type::size_type;
+
+    using iterator = typename container_type::iterator;
+
+    using const_iterator = typename container_type::const_iterator;
+
+    class entry
+    {
+        friend class ordered_map;
+
+    public:
+
+        value_type const&
+        value() const;
+
+        int
+        priority() const;
+
+        /// Sums the counts of every thread
+        std::size_t
+        hits() const;
+
+        void
+        hit() const;
+
+        hit_counter const&
+        counter() const;
+
+    private:
+
+        value_type const* value_;
+        int priority_;
+        std::size_t rank_;
+        std::size_t sequence_;
+        std::shared_ptr<hit_counter> hits_;
+
+    }; // class entry
+
+    using order_type = std::vector<entry>;
+
+    ordered_map() = default;
+
+    ordered_map(self_type const&);
+
+    ordered_map(self_type&&) = default;
+
+    self_type&
+    operator=(self_type const&);
+
+    self_type&
+    operator=(self_type&&) = default;
+
+    iterator
+    begin();
+
+    iterator
+    end();
+
+    const_iterator
+    begin() const;
+
+    const_iterator
+    end() const;
+
+    const_iterator
+    cbegin() const;
+
+    const_iterator
+    cend() const;
+
+    size_type
+    size() const;
+
+    bool
+    empty() const;
+
+    iterator
+    find(key_type const&);
+
+    const_iterator
+    find(key_type const&) const;
+
+    template<class... Params>
+    std::pair<iterator, bool>
+    emplace(Params&&...);
+
+    /// Sets the priority of a route, returns false if there is no such key
+    bool
+    prioritize(key_type const&, int);
+
+    /// Moves the most frequently hit routes forward within each priority
+    void
+    reorder();
+
+    /// Evaluation order
+    order_type const&
+    order() const;
+
+private:
+
+    void
+    sort();
+
+    container_type entries_;
+    order_type order_;
+    std::size_t sequence_ = 0;
+
+}; // class ordered_map
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/ordered_map.hxx>
+
+#endif // not defined BEASTHTTP_BASE_ORDERED_MAP_HXX
@@ -0,0 +1,142 @@
+#ifndef BEASTHTTP_BASE_OUTBOX_HXX
+#define BEASTHTTP_BASE_OUTBOX_HXX
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/http/message.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+/**
+  @brief Messages pushed to the peer, written in the background
+
+  A message is serialized when pushed, then waits for the write in
+  progress, if any, to complete; all the waiting messages go out in the
+  next write. The bytes held are bounded by a limit, past which the
+  policy decides: the session is closed, the new message is dropped, or
+  the oldest ones not yet being written are dropped to make room.
+
+  A message encoded beforehand, shared by several outboxes, is not
+  copied; the write references it, and it counts towards the limit of
+  each outbox holding it.
+*/
+class outbox
+{
+    using self_type = outbox;
+
+public:
+
+    using shared_message = std::shared_ptr<const std::string>;
+
+    using const_buffers_type = std::vector<boost::asio::const_buffer>;
+
+    enum class overflow { close, drop_newest, drop_oldest };
+
+private:
+
+    struct collect;
+
+    struct message
+    {
+        /// End of the message in pending_, or where a shared one goes
+        std::size_t end;
+        shared_message shared;
+    };
+
+    std::string pending_;
+
+    std::string writing_;
+
+    std::deque<message> messages_;
+
+    /// Bytes of the shared messages waiting
+    std::size_t shared_ = 0;
+
+    /// Bytes of the write in progress
+    std::size_t written_ = 0;
+
+    /// Shared messages kept alive by the write in progress
+    std::vector<shared_message> held_;
+
+    const_buffers_type buffers_;
+
+    std::size_t dropped_ = 0;
+
+    template<class Body, class Fields>
+    static void
+    serialize(boost::beast::http::response<Body, Fields>& response,
+              std::string& out, boost::beast::error_code& ec);
+
+    bool
+    admit(std::size_t bytes, std::size_t limit, overflow policy);
+
+    void
+    drop_front(std::size_t bytes);
+
+public:
+
+    outbox() = default;
+
+    outbox(self_type const&) = delete;
+
+    self_type&
+    operator=(self_type const&) = delete;
+
+    /// Serializes the message once, for outboxes to share
+    template<class Body, class Fields>
+    static shared_message
+    encode(boost::beast::http::response<Body, Fields>& response,
+           boost::beast::error_code& ec);
+
+    /// Serializes the message, false if it is not taken
+    template<class Body, class Fields>
+    bool
+    push(boost::beast::http::response<Body, Fields>& response, std::size_t limit,
+         overflow policy, boost::beast::error_code& ec);
+
+    /// References the encoded message, false if it is not taken
+    bool
+    push(shared_message const& message, std::size_t limit,
+         overflow policy, boost::beast::error_code& ec);
+
+    /// Bytes waiting and being written
+    std::size_t
+    size() const;
+
+    /// True while messages wait for the next write
+    bool
+    pending() const;
+
+    /// True while a write is in progress
+    bool
+    writing() const;
+
+    /// Messages dropped to honour the limit
+    std::size_t
+    dropped() const;
+
+    /// Moves the waiting messages to the write in progress
+    const_buffers_type const&
+    flush();
+
+    /// Ends the write in progress
+    void
+    consume();
+
+}; // class outbox
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/outbox.hxx>
+
+#endif // not defined BEASTHTTP_BASE_OUTBOX_HXX
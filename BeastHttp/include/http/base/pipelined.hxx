@@ -0,0 +1,25 @@
+#ifndef BEASTHTTP_BASE_PIPELINED_HXX
+#define BEASTHTTP_BASE_PIPELINED_HXX
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+/**
+  @brief True when the buffers hold a whole request, header and body
+
+  Only looks for the end of the header and at its Content-Length field,
+  without parsing it: a request with a Transfer-Encoding is never taken
+  as whole, as its end is not known before the body is parsed.
+*/
+template<class ConstBufferSequence>
+bool
+pipelined(ConstBufferSequence const&);
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/pipelined.hxx>
+
+#endif // not defined BEASTHTTP_BASE_PIPELINED_HXX
@@ -0,0 +1,174 @@
+#ifndef BEASTHTTP_BASE_POOL_HXX
+#define BEASTHTTP_BASE_POOL_HXX
+
+#include <cstddef>
+#include <new>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+/**
+  @brief Per-thread free list of equally sized blocks
+
+  Blocks released by a thread are kept on its list, up to the capacity
+  given on release, and handed out again by the next allocations of that
+  thread. Every other request goes to ::operator new. The list of a thread
+  holds blocks of one size, the first one it sees, so a Tag is meant for
+  objects of a single type. The list is not synchronized, and a block may
+  be released by another thread than the one that allocated it.
+*/
+template<class Tag>
+class pool
+{
+    using self_type = pool;
+
+public:
+
+    pool() = default;
+
+    pool(self_type const&) = delete;
+
+    self_type&
+    operator=(self_type const&) = delete;
+
+    ~pool();
+
+    /// Pool of the calling thread
+    static self_type&
+    local();
+
+    /// False once the calling thread has destroyed its pool, at exit
+    static bool
+    available();
+
+    void*
+    allocate(std::size_t size);
+
+    void
+    deallocate(void* p, std::size_t size, std::size_t capacity) noexcept;
+
+    /// Allocations served from the list
+    std::size_t
+    hits() const;
+
+    /// Allocations that went to ::operator new
+    std::size_t
+    misses() const;
+
+    /// Blocks on the list
+    std::size_t
+    size() const;
+
+    std::size_t
+    block_size() const;
+
+    /// Returns the blocks on the list to ::operator delete
+    void
+    clear();
+
+private:
+
+    struct node
+    {
+        node* next;
+    };
+
+    static bool&
+    destroyed();
+
+    bool
+    pooled(std::size_t size) noexcept;
+
+    node* head_ = nullptr;
+
+    std::size_t size_ = 0;
+
+    std::size_t block_size_ = 0;
+
+    std::size_t hits_ = 0;
+
+    std::size_t misses_ = 0;
+
+}; // class pool
+
+/**
+  @brief Allocator drawing single objects from base::pool<Tag>
+
+  Rebinding keeps the Tag, so that std::allocate_shared places the
+  control block and the object in one pooled block. Arrays, over-aligned
+  types and allocations made while the thread exits are not pooled.
+*/
+template<class T, class Tag = T>
+class pool_allocator
+{
+    template<class, class>
+    friend class pool_allocator;
+
+public:
+
+    using value_type = T;
+
+    using pool_type = pool<Tag>;
+
+    template<class U>
+    struct rebind
+    {
+        using other = pool_allocator<U, Tag>;
+    };
+
+    /// Up to capacity released blocks are kept by each thread
+    explicit
+    pool_allocator(std::size_t capacity) noexcept
+        : capacity_{capacity}
+    {
+    }
+
+    template<class U>
+    pool_allocator(pool_allocator<U, Tag> const& other) noexcept
+        : capacity_{other.capacity_}
+    {
+    }
+
+    T*
+    allocate(std::size_t n);
+
+    void
+    deallocate(T* p, std::size_t n) noexcept;
+
+    std::size_t
+    capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    template<class U>
+    bool
+    operator==(pool_allocator<U, Tag> const&) const noexcept
+    {
+        return true;
+    }
+
+    template<class U>
+    bool
+    operator!=(pool_allocator<U, Tag> const&) const noexcept
+    {
+        return false;
+    }
+
+private:
+
+    static bool
+    pooled(std::size_t n) noexcept;
+
+    std::size_t capacity_;
+
+}; // class pool_allocator
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/pool.hxx>
+
+#endif // not defined BEASTHTTP_BASE_POOL_HXX
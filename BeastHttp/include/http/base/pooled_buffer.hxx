@@ -0,0 +1,145 @@
+#ifndef BEASTHTTP_BASE_POOLED_BUFFER_HXX
+#define BEASTHTTP_BASE_POOLED_BUFFER_HXX
+
+#include <http/base/pool.hxx>
+
+#include <boost/asio/buffer.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+/**
+  @brief Flat read buffer borrowed from a per-thread pool
+
+  Takes a block of BlockSize bytes from base::pool when bytes are first
+  prepared, and gives it back as soon as every byte is consumed, so that
+  a connection between two requests holds no memory. BlockSize is also the
+  maximum size: a request header that does not fit fails to read with
+  http::error::buffer_overflow, as with a size-limited flat_buffer.
+*/
+template<std::size_t BlockSize = 16384>
+class pooled_buffer
+{
+    using self_type = pooled_buffer;
+
+public:
+
+    using const_buffers_type = boost::asio::const_buffer;
+
+    using mutable_buffers_type = boost::asio::mutable_buffer;
+
+    using pool_type = base::pool<self_type>;
+
+    /// Bytes of all the buffers of this size, process-wide
+    struct stats_type
+    {
+        /// Held by connections with pending data or an outstanding read
+        std::size_t borrowed;
+
+        /// Kept on the free lists of the threads
+        std::size_t idle;
+    };
+
+    pooled_buffer() = default;
+
+    pooled_buffer(self_type&&) noexcept;
+
+    self_type&
+    operator=(self_type&&) noexcept;
+
+    pooled_buffer(self_type const&) = delete;
+
+    self_type&
+    operator=(self_type const&) = delete;
+
+    ~pooled_buffer();
+
+    std::size_t
+    size() const noexcept;
+
+    std::size_t
+    max_size() const noexcept;
+
+    std::size_t
+    capacity() const noexcept;
+
+    const_buffers_type
+    data() const noexcept;
+
+    const_buffers_type
+    cdata() const noexcept;
+
+    mutable_buffers_type
+    data() noexcept;
+
+    mutable_buffers_type
+    prepare(std::size_t n);
+
+    void
+    commit(std::size_t n) noexcept;
+
+    void
+    consume(std::size_t n) noexcept;
+
+    /// True while the buffer holds a block
+    bool
+    borrowed() const noexcept;
+
+    /// Idle blocks kept by each thread, 64 by default
+    static void
+    reserve(std::size_t capacity);
+
+    /// Idle blocks freed by a thread at exit are still counted as idle
+    static stats_type
+    stats();
+
+    /// Pool of the calling thread, with its hit and miss counters
+    static pool_type const&
+    pool();
+
+private:
+
+    void
+    release() noexcept;
+
+    static std::atomic<std::size_t>&
+    reserved();
+
+    static std::atomic<std::size_t>&
+    borrowed_blocks();
+
+    static std::atomic<std::size_t>&
+    idle_blocks();
+
+    char* block_ = nullptr;
+
+    std::size_t in_ = 0;
+
+    std::size_t out_ = 0;
+
+    std::size_t last_ = 0;
+
+}; // class pooled_buffer
+
+template<class Buffer>
+struct is_pooled_buffer : std::false_type
+{
+};
+
+template<std::size_t BlockSize>
+struct is_pooled_buffer<pooled_buffer<BlockSize>> : std::true_type
+{
+};
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/pooled_buffer.hxx>
+
+#endif // not defined BEASTHTTP_BASE_POOLED_BUFFER_HXX
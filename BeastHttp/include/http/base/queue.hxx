@@ -1,39 +1,161 @@
 #ifndef BEASTHTTP_BASE_QUEUE_HXX
 #define BEASTHTTP_BASE_QUEUE_HXX
 
-#include <vector>
-#include <memory>
+#include <http/base/write_batch.hxx>
+
+#include <cstddef>
+#include <deque>
+#include <type_traits>
 
 namespace _0xdead4ead {
 namespace http {
 namespace base {
 
+/**
+  @brief Responses waiting to be written, in the order of their requests
+
+  A ring of Depth slots. Responses of up to InlineSize bytes are moved
+  into their slot, larger ones to the heap. The session stops reading
+  while Depth responses are pending; the ones sent past that, by handlers
+  answering a request more than once, wait on an overflow list.
+
+  With a coalescing limit, the responses pending when a write starts are
+  serialized into one write_batch and sent by a single gather write. A
+  corked queue starts no write, so that the responses to the requests
+  of a pipeline are gathered before the first one goes out. A paused one
+  leaves the connection to another writer, as the session's pushes.
+*/
 //https://www.boost.org/doc/libs/1_68_0/libs/beast/example/advanced/server/advanced_server.cpp
-template<class Flesh>
+template<class Flesh, std::size_t Depth = 16, std::size_t InlineSize = 128>
 class queue
 {
-    constexpr static size_t limit = 16;
+    using self_type = queue;
+
+    static_assert(Depth > 0, "queue depth must be positive");
+
+    struct entry
+    {
+        void* object;
+        void (*write)(Flesh&, void*);
+        bool (*append)(void*, write_batch&);
+        void (*destroy)(void*);
+    };
 
-    struct work
+    struct storage_type
     {
-        virtual ~work() = default;
-        virtual void operator()() = 0;
+        alignas(std::max_align_t) unsigned char data[InlineSize];
     };
 
+    template<class Response>
+    using fits = std::integral_constant<bool,
+        sizeof(Response) <= InlineSize and alignof(Response) <= alignof(std::max_align_t)>;
+
     Flesh& impl_;
-    std::vector<std::unique_ptr<work>> items_;
+
+    entry items_[Depth];
+
+    storage_type storage_[Depth];
+
+    std::size_t head_ = 0;
+
+    std::size_t size_ = 0;
+
+    std::deque<entry> overflow_;
+
+    write_batch batch_;
+
+    std::size_t writing_ = 0;
+
+    bool corked_ = false;
+
+    bool paused_ = false;
+
+    template<class Response>
+    static entry
+    make(void* storage, Response& response, std::true_type);
+
+    template<class Response>
+    static entry
+    make(void* storage, Response& response, std::false_type);
+
+    template<class Response>
+    static void
+    write(Flesh& impl, void* object);
+
+    template<class Response>
+    static bool
+    append(void* object, write_batch& batch);
+
+    template<class Response>
+    static void
+    destroy_inline(void* object);
+
+    template<class Response>
+    static void
+    destroy_heap(void* object);
+
+    entry&
+    at(std::size_t index);
+
+    entry&
+    front();
+
+    void
+    write_front();
+
+    /// Starts a write, unless one is in progress or held back
+    void
+    start();
+
+    void
+    pop_front();
 
 public:
 
+    static constexpr std::size_t depth = Depth;
+
+    /// Coalesces up to limit copied bytes per write, 0 writes one by one
     explicit
-    queue(Flesh&);
+    queue(Flesh&, std::size_t limit = 0);
+
+    queue(self_type const&) = delete;
+
+    self_type&
+    operator=(self_type const&) = delete;
+
+    ~queue();
 
     bool
     is_full() const;
 
+    /// Responses pending, the one being written included
+    std::size_t
+    size() const;
+
     bool
     on_write();
 
+    /// True with a coalescing limit
+    bool
+    coalescing() const;
+
+    void
+    cork();
+
+    /// Starts writing the responses held back
+    void
+    uncork();
+
+    /// True while a write is in progress
+    bool
+    writing() const;
+
+    void
+    pause();
+
+    void
+    resume();
+
     template<class Response>
     void
     operator()(Response&);
@@ -0,0 +1,155 @@
+#ifndef BEASTHTTP_BASE_RADIX_MAP_HXX
+#define BEASTHTTP_BASE_RADIX_MAP_HXX
+
+#include <http/base/segment_pattern.hxx>
+
+#include <boost/beast/core/string.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+/**
+  @brief Resource map with a compressed radix tree index
+
+  Drop-in replacement for the ResourceMap container of a session.
+  Plain paths (for example "/api/users/:id/orders") are indexed in a
+  radix tree and resolved in O(path length). The named segments of
+  base::segment_pattern (":name", "{id:int}", "{path:*}", ...) are
+  checked by their kind while walking the tree. Everything else is
+  treated as a true regular expression and is left to the caller via
+  fallback().
+*/
+template<class Key, class Value, class... Args>
+class radix_map
+{
+    using self_type = radix_map;
+
+    using container_type = std::map<Key, Value>;
+
+    struct node;
+
+    using node_ptr = std::unique_ptr<node>;
+
+public:
+
+    using key_type = Key;
+
+    using mapped_type = Value;
+
+    using value_type = typename container_type::value_type;
+
+    using size_type = typename container_type::size_type;
+
+    using iterator = typename container_type::iterator;
+
+    using const_iterator = typename container_type::const_iterator;
+
+    using fallback_type = std::vector<value_type const*>;
+
+    using string_view_type = boost::beast::string_view;
+
+    radix_map();
+
+    radix_map(self_type const&);
+
+    radix_map(self_type&&) = default;
+
+    self_type&
+    operator=(self_type const&);
+
+    self_type&
+    operator=(self_type&&) = default;
+
+    iterator
+    begin();
+
+    iterator
+    end();
+
+    const_iterator
+    begin() const;
+
+    const_iterator
+    end() const;
+
+    const_iterator
+    cbegin() const;
+
+    const_iterator
+    cend() const;
+
+    size_type
+    size() const;
+
+    bool
+    empty() const;
+
+    iterator
+    find(key_type const&);
+
+    const_iterator
+    find(key_type const&) const;
+
+    template<class... Params>
+    std::pair<iterator, bool>
+    emplace(Params&&...);
+
+    /// Invokes f(value_type const&) for each indexed entry matching target
+    template<class F>
+    bool
+    match(string_view_type target, F&& f) const;
+
+    /// Entries which are not indexed by the tree, in insertion order
+    fallback_type const&
+    fallback() const;
+
+private:
+
+    using kind = segment_pattern::kind;
+
+    using token = segment_pattern::part;
+
+    struct node
+    {
+        std::string prefix;
+        std::vector<node_ptr> children;
+        std::vector<std::pair<kind, node_ptr>> params;
+        // Routes of the same shape, "/users/:id" and "/users/{name}"
+        // for instance, share the node, in registration order
+        std::vector<value_type const*> values;
+    };
+
+    void
+    index(value_type const&);
+
+    void
+    insert(node&, std::vector<token> const&, std::size_t, value_type const&);
+
+    void
+    insert_literal(node&, std::string const&,
+                   std::vector<token> const&, std::size_t, value_type const&);
+
+    template<class F>
+    static bool
+    match(node const&, string_view_type, std::size_t, F&);
+
+    container_type entries_;
+    node_ptr root_;
+    fallback_type fallback_;
+    std::vector<value_type const*> inserted_;
+
+}; // class radix_map
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/radix_map.hxx>
+
+#endif // not defined BEASTHTTP_BASE_RADIX_MAP_HXX
@@ -1,7 +1,13 @@
 #ifndef BEASTHTTP_BASE_REGEX_HXX
 #define BEASTHTTP_BASE_REGEX_HXX
 
+#include <http/base/segment_pattern.hxx>
+
+#include <boost/beast/core/string.hpp>
+
+#include <cctype>
 #include <regex>
+#include <string>
 
 namespace _0xdead4ead {
 namespace http {
@@ -21,14 +27,39 @@ public:
 
     using flag_type = typename regex_type::flag_type;
 
+    using compiled_type = regex_type;
+
+    using string_view_type = boost::beast::string_view;
+
     inline regex(flag_type);
 
+    inline flag_type
+    flags() const;
+
+    /// Whole path segments of the form ":name" or "{name:type}" compile
+    /// as the groups of base::segment_pattern, e.g. "([^/]+)"
+    inline compiled_type
+    compile(const std::string&) const;
+
     inline bool
     match(const std::string&, const std::string&);
 
     inline bool
     match(const std::string&, const std::string&, std::smatch&);
 
+    inline bool
+    match(const compiled_type&, string_view_type) const;
+
+    inline bool
+    match(const compiled_type&, const std::string&, std::smatch&) const;
+
+    inline bool
+    match(const compiled_type&, string_view_type, std::cmatch&) const;
+
+    /// The regex of a segment path ("/users/{id:int}"), other patterns as is
+    inline std::string
+    expand(const std::string&) const;
+
 private:
 
     flag_type flags_;
@@ -2,8 +2,19 @@
 #define BEASTHTTP_BASE_REQUEST_PROCESSOR_HXX
 
 #include <http/base/traits.hxx>
+#include <http/base/lockable.hxx>
+#include <http/base/router.hxx>
+#include <http/base/route_cache.hxx>
+#include <http/base/snapshot.hxx>
 
+#include <boost/beast/core/string.hpp>
+#include <boost/container/small_vector.hpp>
+
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <regex>
+#include <vector>
 
 namespace _0xdead4ead {
 namespace http {
@@ -22,6 +33,7 @@ class request_processor : private Session::cbexecutor_type
                    traits::HasMethodType<session_type, void>,
                    traits::HasFleshType<session_type, void>,
                    traits::HasRegexType<session_type, void>,
+                   traits::HasRouteType<session_type, void>,
                    traits::HasRequestType<session_type, void>>::value,
                    "Invalid session type!");
 
@@ -43,9 +55,45 @@ public:
 
     using storage_type = typename session_type::storage_type;
 
+    using route_type = typename session_type::route_type;
+
+    using dispatcher_type = std::function<bool (request_type&, session_flesh&)>;
+
+    using snapshot_type = base::snapshot<resource_map_type, method_map_type, dispatcher_type>;
+
+    using cache_type = base::route_cache<route_type, method_type>;
+
+    using string_view_type = boost::beast::string_view;
+
     request_processor(std::shared_ptr<resource_map_type> const&,
                       std::shared_ptr<method_map_type> const&,
                       typename regex_type::flag_type);
+
+    request_processor(std::shared_ptr<resource_map_type> const&,
+                      std::shared_ptr<method_map_type> const&,
+                      typename regex_type::flag_type,
+                      std::shared_ptr<snapshot_type const> const&);
+
+    /// True when routes are read from a published snapshot without locking
+    bool
+    lock_free() const;
+
+    /**
+      @brief Caches resolved routes per thread, for every processor of this session type
+
+      Up to capacity (method, target) pairs are remembered by each thread,
+      together with the routes they resolved to; any change to a router of
+      this session type invalidates them. Param captures are still parsed
+      from the target by their handler; base::ordered_map counts the hits
+      served from the cache too. A capacity of 0 turns the cache off,
+      which is the default.
+    */
+    static void
+    enable_cache(std::size_t capacity);
+
+    /// Cache of the calling thread, with its hit and miss counters
+    static cache_type const&
+    cache();
 #ifdef BEASTHTTP_TEST_ROUTER
     void
     provide(request_type&&, session_flesh&&);
@@ -55,8 +103,60 @@ public:
 
 private:
 
+    using matches_type = std::vector<route_type const*>;
+
+    /// False when no route matched
+    bool
+    provide(resource_map_type const*, method_map_type const*,
+            request_type&, session_flesh&);
+
+    /// False when the mounted router has no route for the request
+    bool
+    delegate(route_type const&, request_type&, session_flesh&);
+
+    bool
+    match(route_type const&, string_view_type) const;
+
+    static std::atomic<std::size_t>&
+    cache_capacity();
+
+    static cache_type&
+    local_cache(std::size_t capacity);
+
+    template<class ResourceMap>
+    void
+    collect_mounts(ResourceMap const&, string_view_type, matches_type&);
+
+    template<class ResourceMap>
+    auto
+    collect(ResourceMap const&, string_view_type, matches_type&, int)
+    -> decltype (std::declval<ResourceMap const&>().fallback(), void());
+
+    template<class ResourceMap>
+    auto
+    collect(ResourceMap const&, string_view_type, matches_type&, int)
+    -> decltype (std::declval<ResourceMap const&>().order(), void());
+
+    template<class ResourceMap>
+    void
+    collect(ResourceMap const&, string_view_type, matches_type&, long);
+
+    template<class ResourceMap, class F, class Regex = regex_type>
+    auto
+    scan(ResourceMap const&, string_view_type, F&&, int)
+    -> decltype (std::declval<Regex const&>().match_all(
+                     std::declval<ResourceMap const&>(),
+                     std::declval<string_view_type>(), std::declval<F>()), bool());
+
+    template<class ResourceMap, class F>
+    bool
+    scan(ResourceMap const&, string_view_type, F&&, long);
+
     std::shared_ptr<resource_map_type> const& resource_map_;
     std::shared_ptr<method_map_type> const& method_map_;
+    std::shared_ptr<snapshot_type const> snapshot_;
+    std::vector<matches_type> matched_;
+    hit_counter const* counted_ = nullptr;
 
     regex_type regex_;
 
@@ -0,0 +1,72 @@
+#ifndef BEASTHTTP_BASE_ROUTE_HXX
+#define BEASTHTTP_BASE_ROUTE_HXX
+
+#include <string>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+template<class>
+class router;
+
+/**
+  @brief Resource map entry
+
+  Keeps the callback storage of a resource together with its regular
+  expression, compiled once at registration time. A route added by
+  router::mount() also refers to the mounted router, which resolves
+  the rest of the target after the prefix.
+*/
+template<class Regex, class Storage>
+class route
+{
+    using self_type = route;
+
+public:
+
+    using regex_type = Regex;
+
+    using compiled_type = typename regex_type::compiled_type;
+
+    using storage_type = Storage;
+
+    using mount_type = router<typename storage_type::session_type>;
+
+    route(compiled_type&&, storage_type&&);
+
+    route(compiled_type&&, storage_type&&, mount_type const*, std::string prefix);
+
+    compiled_type const&
+    regex() const;
+
+    storage_type&
+    storage();
+
+    storage_type const&
+    storage() const;
+
+    /// Mounted router, or null for an ordinary route
+    mount_type const*
+    mount() const;
+
+    /// Literal mount prefix, stripped from the target
+    std::string const&
+    prefix() const;
+
+private:
+
+    compiled_type regex_;
+    storage_type storage_;
+    mount_type const* mount_;
+    std::string prefix_;
+
+}; // class route
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/route.hxx>
+
+#endif // not defined BEASTHTTP_BASE_ROUTE_HXX
@@ -0,0 +1,102 @@
+#ifndef BEASTHTTP_BASE_ROUTE_CACHE_HXX
+#define BEASTHTTP_BASE_ROUTE_CACHE_HXX
+
+#include <http/base/hit_counter.hxx>
+
+#include <boost/beast/core/string.hpp>
+#include <boost/container/small_vector.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+/**
+  @brief Bounded cache of resolved routes
+
+  Remembers which routes a (method, target) pair resolved to, for one
+  set of routing tables at one router generation. Entries are kept in a
+  direct-mapped table: a colliding pair replaces the older entry, so the
+  cache never grows past its capacity. Targets longer than max_target
+  are not cached. A hit is passed on to the hit_counter of the route it
+  resolved to, if one was given. The cache is not synchronized, the
+  request processor keeps one per thread.
+*/
+template<class Route, class Method>
+class route_cache
+{
+    using self_type = route_cache;
+
+public:
+
+    using route_type = Route;
+
+    using method_type = Method;
+
+    using routes_type = boost::container::small_vector<route_type const*, 4>;
+
+    using string_view_type = boost::beast::string_view;
+
+    /// Identity of the routing tables, resource map and method map
+    using tables_type = std::pair<void const*, void const*>;
+
+    static constexpr std::size_t max_target = 256;
+
+    /// The capacity is rounded up to a power of two, 0 disables the cache
+    explicit
+    route_cache(std::size_t capacity = 0);
+
+    std::size_t
+    capacity() const;
+
+    /// Routes cached for the pair, or null; counts a hit or a miss
+    routes_type const*
+    find(std::size_t generation, tables_type const& tables,
+         method_type, string_view_type target);
+
+    void
+    insert(std::size_t generation, tables_type const& tables,
+           method_type, string_view_type target, routes_type const&,
+           hit_counter const* counter = nullptr);
+
+    std::size_t
+    hits() const;
+
+    std::size_t
+    misses() const;
+
+    void
+    clear();
+
+private:
+
+    struct entry
+    {
+        std::size_t generation = 0;
+        tables_type tables{nullptr, nullptr};
+        method_type method = method_type{};
+        std::string target;
+        routes_type routes;
+        hit_counter const* counter = nullptr;
+    };
+
+    entry&
+    slot(method_type, string_view_type);
+
+    std::vector<entry> entries_;
+    std::size_t hits_;
+    std::size_t misses_;
+
+}; // class route_cache
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/route_cache.hxx>
+
+#endif // not defined BEASTHTTP_BASE_ROUTE_CACHE_HXX
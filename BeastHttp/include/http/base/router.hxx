@@ -3,7 +3,13 @@
 
 #include <http/base/traits.hxx>
 #include <http/base/lockable.hxx>
+#include <http/base/snapshot.hxx>
+#include <http/base/segment_pattern.hxx>
 
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <functional>
 #include <memory>
 
 namespace _0xdead4ead {
@@ -29,6 +35,8 @@ protected:
 
     using storage_type = typename session_type::storage_type;
 
+    using route_type = typename session_type::route_type;
+
     using resource_map_type = typename session_type::resource_map_type;
 
     using method_map_type = typename session_type::method_map_type;
@@ -43,8 +51,16 @@ protected:
 
     using request_type = typename session_type::request_type;
 
+    using context_type = typename session_type::context_type;
+
     using regex_flag_type = typename session_type::regex_flag_type;
 
+    using flesh_type = typename session_type::flesh_type;
+
+    using dispatcher_type = std::function<bool (request_type&, flesh_type&)>;
+
+    using snapshot_type = base::snapshot<resource_map_type, method_map_type, dispatcher_type>;
+
     static_assert (base::traits::Conjunction<
                    base::traits::HasStorageType<session_type, void>,
                    base::traits::HasResourceMapType<session_type, void>,
@@ -55,12 +71,13 @@ protected:
                    base::traits::HasRegexType<session_type, void>,
                    base::traits::HasRegexFlagType<session_type, void>,
                    base::traits::HasRequestType<session_type, void>,
-                   base::traits::HasStorageType<session_type, void>>::value,
+                   base::traits::HasRouteType<session_type, void>>::value,
                    "Session type is incorrect!");
 
     explicit
     router(std::shared_ptr<resource_map_type>&,
-           std::shared_ptr<method_map_type>&) noexcept;
+           std::shared_ptr<method_map_type>&,
+           regex_flag_type) noexcept;
 
     void
     add_resource_cb(resource_regex_type const&,
@@ -75,6 +92,10 @@ protected:
     use(resource_regex_type const&,
         self_type const&);
 
+    void
+    mount(resource_regex_type const&,
+          self_type const&);
+
 public:
 
     std::shared_ptr<resource_map_type> const&
@@ -86,6 +107,84 @@ public:
     mutex_type&
     mutex() const;
 
+    /**
+      @brief Switches the router to snapshot publication
+
+      Every later change copies the routing tables and publishes them as an
+      immutable snapshot. Sessions created afterwards resolve requests from
+      the snapshot without taking the router lock. Add many routes inside
+      a batch(), or before this call, to copy the tables only once.
+    */
+    void
+    enable_snapshot();
+
+    /**
+      @brief Defers snapshot publication while it lives
+
+      The changes made meanwhile are published as one snapshot when the
+      last batch of the router ends, so adding N routes copies the tables
+      once instead of N times. Sessions keep the previous snapshot until
+      then. Batches may nest.
+    */
+    class batch_guard
+    {
+        using self_type = batch_guard;
+
+    public:
+
+        explicit
+        batch_guard(router& owner);
+
+        batch_guard(self_type&&) noexcept;
+
+        batch_guard(self_type const&) = delete;
+
+        self_type&
+        operator=(self_type const&) = delete;
+
+        ~batch_guard();
+
+    private:
+
+        router* owner_;
+
+    }; // class batch_guard
+
+    batch_guard
+    batch();
+
+    /**
+      @brief Sets a dispatcher tried before the routes, such as a route_table
+
+      Sessions call it first with each request; the routes resolve the ones
+      it returns false for. The dispatcher is published with the snapshot,
+      so this switches the router to snapshot publication, and only the
+      sessions created afterwards use it.
+    */
+    void
+    dispatch(dispatcher_type);
+
+    /**
+      @brief Sets the priority of a route in every map that holds it
+
+      Only available with a first-match ResourceMap such as base::ordered_map.
+      Higher priorities are tried first, the default is 0.
+    */
+    void
+    priority(resource_regex_type const&, int);
+
+    /// Reorders first-match routes by the traffic they have received so far
+    void
+    reorder();
+
+    /// Current published snapshot, or null unless enable_snapshot() was called
+    std::shared_ptr<snapshot_type const>
+    snapshot() const;
+
+    /// Bumped by every change to the routes of any router of this session type
+    static std::size_t
+    generation();
+
     template<class DerivedRouter, class Pack>
     auto
     param(DerivedRouter& router, typename regex_type::flag_type flags)
@@ -96,10 +195,44 @@ private:
     resource_regex_type
     concat(const resource_regex_type&, const resource_regex_type&);
 
+    /// The path without its trailing '/', false unless it is literal
+    static bool
+    literal_prefix(const resource_regex_type&, resource_regex_type&);
+
+    void
+    add_mount(resource_regex_type const&, self_type const&);
+
+    static std::atomic<std::size_t>&
+    counter();
+
+    void
+    changed();
+
+    void
+    publish();
+
+    template<class Regex>
+    static auto
+    invalidate(int) -> decltype (Regex::invalidate(), void());
+
+    template<class Regex>
+    static void
+    invalidate(long);
+
+    void
+    end_batch();
+
     mutable mutex_type mutex_;
 
+    std::size_t batches_ = 0;
+    bool pending_ = false;
+
     std::shared_ptr<resource_map_type>& resource_map_;
     std::shared_ptr<method_map_type>& method_map_;
+    std::shared_ptr<snapshot_type> snapshot_;
+    std::shared_ptr<dispatcher_type const> dispatcher_;
+
+    regex_type regex_;
 
 }; // class router
 
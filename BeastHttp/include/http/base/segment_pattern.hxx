@@ -0,0 +1,95 @@
+#ifndef BEASTHTTP_BASE_SEGMENT_PATTERN_HXX
+#define BEASTHTTP_BASE_SEGMENT_PATTERN_HXX
+
+#include <boost/beast/core/string.hpp>
+
+#include <string>
+#include <vector>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+/**
+  @brief Route path with named, typed segments
+
+  A whole path segment may be written as
+
+      {name}        any non-empty segment (also ":name" or {name:str})
+      {name:int}    an optionally signed decimal number
+      {name:uint}   an unsigned decimal number
+      {name:*}      the rest of the target, slashes included (last only)
+
+  for example "/users/{id:int}/files/{path:*}". Everything else must be
+  literal, an optional leading '^' and trailing '$' aside. Such a path is
+  matched segment by segment without a regex engine; its captures are
+  handed out as views into the target, in order.
+*/
+class segment_pattern
+{
+    using self_type = segment_pattern;
+
+public:
+
+    enum class kind
+    {
+        literal,
+        string,
+        integer,
+        unsigned_integer,
+        rest
+    };
+
+    struct part
+    {
+        kind type;
+        std::string text; // literal text, or the name of a segment
+    };
+
+    using parts_type = std::vector<part>;
+
+    using string_view_type = boost::beast::string_view;
+
+    segment_pattern() = default;
+
+    /// Parses the path, false when it is a regular expression
+    inline static bool
+    parse(const std::string&, parts_type&);
+
+    /// Equivalent regular expression of a typed segment, e.g. "([0-9]+)"
+    inline static std::string
+    expression(kind);
+
+    /// Kind of a "{name:type}" segment written at text[pos], false if none
+    inline static bool
+    segment(string_view_type text, std::size_t pos,
+            std::size_t& end, kind& type, std::string& name);
+
+    /// True if value is a valid segment of this kind
+    inline static bool
+    accepts(kind, string_view_type value);
+
+    inline bool
+    assign(const std::string&);
+
+    inline parts_type const&
+    parts() const;
+
+    /// Invokes f(string_view_type) for every capture if the target matches
+    template<class F>
+    bool
+    match(string_view_type target, F&& f) const;
+
+private:
+
+    parts_type parts_;
+
+}; // class segment_pattern
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/segment_pattern.hxx>
+
+#endif // not defined BEASTHTTP_BASE_SEGMENT_PATTERN_HXX
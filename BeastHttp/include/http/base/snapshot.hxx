@@ -0,0 +1,76 @@
+#ifndef BEASTHTTP_BASE_SNAPSHOT_HXX
+#define BEASTHTTP_BASE_SNAPSHOT_HXX
+
+#include <atomic>
+#include <memory>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+/**
+  @brief Immutable published copy of the routing tables
+
+  A router publishing a newer snapshot links it through next() before
+  marking this one stale, so a reader holding any snapshot can walk
+  forward to the current one without taking the router lock. The
+  dispatcher set on the router, if any, is published along with the
+  tables.
+*/
+template<class ResourceMap, class MethodMap, class Dispatcher>
+class snapshot
+{
+    using self_type = snapshot;
+
+public:
+
+    using resource_map_type = ResourceMap;
+
+    using method_map_type = MethodMap;
+
+    using dispatcher_type = Dispatcher;
+
+    snapshot(std::shared_ptr<resource_map_type const>,
+             std::shared_ptr<method_map_type const>,
+             std::shared_ptr<dispatcher_type const>);
+
+    snapshot(self_type const&) = delete;
+
+    self_type&
+    operator=(self_type const&) = delete;
+
+    std::shared_ptr<resource_map_type const> const&
+    resource_map() const;
+
+    std::shared_ptr<method_map_type const> const&
+    method_map() const;
+
+    std::shared_ptr<dispatcher_type const> const&
+    dispatcher() const;
+
+    bool
+    stale() const;
+
+    std::shared_ptr<self_type const> const&
+    next() const;
+
+    void
+    supersede(std::shared_ptr<self_type const> const&);
+
+private:
+
+    std::shared_ptr<resource_map_type const> resource_map_;
+    std::shared_ptr<method_map_type const> method_map_;
+    std::shared_ptr<dispatcher_type const> dispatcher_;
+    std::shared_ptr<self_type const> next_;
+    std::atomic<bool> stale_;
+
+}; // class snapshot
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/snapshot.hxx>
+
+#endif // not defined BEASTHTTP_BASE_SNAPSHOT_HXX
@@ -0,0 +1,787 @@
+#ifndef BEASTHTTP_BASE_STATIC_REGEX_HXX
+#define BEASTHTTP_BASE_STATIC_REGEX_HXX
+
+#include <http/base/config.hxx>
+#include <http/base/regex.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+#if defined(BEASTHTTP_CXX17_IF_CONSTEXPR) && defined(BEASTHTTP_STRING_LITERAL_TEMPLATE)
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+namespace detail {
+
+struct static_node
+{
+    enum kind_type : unsigned char { empty, chr, set, seq, alt, repeat, bol, eol };
+
+    kind_type kind = empty;
+    char c = 0;
+    std::uint64_t bits[4] = {0, 0, 0, 0};
+    int child = -1;     // first element of seq/alt, or the repeated node
+    int next = -1;      // next sibling in the parent seq/alt
+    int min = 0;
+    int max = -1;       // -1 for no upper bound
+
+    constexpr bool
+    test(unsigned char ch) const
+    {
+        return (bits[ch >> 6] >> (ch & 63)) & 1;
+    }
+
+    constexpr void
+    add(unsigned char ch)
+    {
+        bits[ch >> 6] |= std::uint64_t{1} << (ch & 63);
+    }
+
+    constexpr void
+    add(unsigned char first, unsigned char last)
+    {
+        for (unsigned ch = first; ch <= last; ++ch)
+            add(static_cast<unsigned char>(ch));
+    }
+
+    constexpr void
+    add(static_node const& other)
+    {
+        for (int i = 0; i < 4; ++i)
+            bits[i] |= other.bits[i];
+    }
+
+    constexpr void
+    invert()
+    {
+        for (int i = 0; i < 4; ++i)
+            bits[i] = ~bits[i];
+    }
+
+}; // struct static_node
+
+template<std::size_t Size>
+struct static_program
+{
+    static constexpr std::size_t capacity = 4 * Size + 16;
+
+    static_node nodes[capacity] = {};
+    int count = 0;
+    int root = -1;
+    bool valid = true;
+
+}; // struct static_program
+
+/// Recursive descent over an ECMAScript subset, run by the compiler
+template<std::size_t Size>
+class static_parser
+{
+public:
+
+    constexpr explicit
+    static_parser(const char* text)
+        : text_{text}
+    {
+    }
+
+    constexpr static_program<Size>
+    parse()
+    {
+        program_.root = alternation();
+        if (pos_ != Size)
+            program_.valid = false;
+
+        return program_;
+    }
+
+private:
+
+    constexpr char
+    peek() const
+    {
+        return pos_ < Size ? text_[pos_] : '\0';
+    }
+
+    constexpr int
+    add(static_node const& n)
+    {
+        if (program_.count == int(static_program<Size>::capacity)) {
+            program_.valid = false;
+            return -1;
+        }
+
+        program_.nodes[program_.count] = n;
+        return program_.count++;
+    }
+
+    constexpr int
+    fail()
+    {
+        program_.valid = false;
+        pos_ = Size;
+        return -1;
+    }
+
+    constexpr int
+    alternation()
+    {
+        const int first = sequence();
+        if (peek() != '|' or not program_.valid)
+            return first;
+
+        static_node n;
+        n.kind = static_node::alt;
+        n.child = first;
+
+        for (int last = first; peek() == '|';) {
+            ++pos_;
+            const int s = sequence();
+            if (not program_.valid)
+                return -1;
+
+            program_.nodes[last].next = s;
+            last = s;
+        }
+
+        return add(n);
+    }
+
+    constexpr int
+    sequence()
+    {
+        static_node n;
+        n.kind = static_node::seq;
+
+        for (int last = -1; pos_ < Size and peek() != '|' and peek() != ')';) {
+            const int a = quantified();
+            if (not program_.valid)
+                return -1;
+
+            if (last < 0)
+                n.child = a;
+            else
+                program_.nodes[last].next = a;
+
+            last = a;
+        }
+
+        return add(n);
+    }
+
+    constexpr bool
+    number(int& value)
+    {
+        if (peek() < '0' or peek() > '9')
+            return false;
+
+        value = 0;
+        while (peek() >= '0' and peek() <= '9')
+            value = value * 10 + (text_[pos_++] - '0');
+
+        return true;
+    }
+
+    constexpr int
+    quantified()
+    {
+        const int a = atom();
+        if (not program_.valid)
+            return -1;
+
+        static_node n;
+        n.kind = static_node::repeat;
+        n.child = a;
+
+        switch (peek()) {
+        case '*':
+            n.max = -1;
+            break;
+        case '+':
+            n.min = 1;
+            break;
+        case '?':
+            n.max = 1;
+            break;
+        case '{':
+            // "/{name}" is a segment, left to the next atom
+            if (pos_ + 1 < Size and is_head(text_[pos_ + 1]))
+                return a;
+            ++pos_;
+            if (not number(n.min))
+                return fail();
+            n.max = n.min;
+            if (peek() == ',') {
+                ++pos_;
+                n.max = -1;
+                if (peek() != '}' and not number(n.max))
+                    return fail();
+            }
+            if (peek() != '}' or (n.max >= 0 and n.max < n.min))
+                return fail();
+            break;
+        default:
+            return a;
+        }
+
+        ++pos_;
+        if (peek() == '?') // lazy, the same for a whole match
+            ++pos_;
+
+        return add(n);
+    }
+
+    constexpr static bool
+    is_head(char c)
+    {
+        return (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or c == '_';
+    }
+
+    constexpr static bool
+    is_tail(char c)
+    {
+        return is_head(c) or (c >= '0' and c <= '9');
+    }
+
+    constexpr int
+    repeat_of(static_node const& element, int min)
+    {
+        static_node n;
+        n.kind = static_node::repeat;
+        n.child = add(element);
+        n.min = min;
+        return add(n);
+    }
+
+    // The typed segments of base::segment_pattern, as expanded by base::regex
+    constexpr int
+    segment()
+    {
+        const std::size_t size = Size > 0 and text_[Size - 1] == '$' ? Size - 1 : Size;
+        const char open = text_[pos_];
+
+        if (pos_ == 0 or text_[pos_ - 1] != '/' or pos_ + 1 >= size
+                or (open != '{' and open != ':') or not is_head(text_[pos_ + 1]))
+            return -1;
+
+        std::size_t j = pos_ + 1;
+        while (j < size and is_tail(text_[j]))
+            ++j;
+
+        char type = 's';
+        if (open == '{') {
+            if (j < size and text_[j] == ':') {
+                std::size_t close = j;
+                while (close < size and text_[close] != '}')
+                    ++close;
+                if (close == size)
+                    return -1;
+
+                const std::size_t length = close - j - 1;
+                const char* spec = text_ + j + 1;
+                if (length == 3 and spec[0] == 'i' and spec[1] == 'n' and spec[2] == 't')
+                    type = 'i';
+                else if (length == 4 and spec[0] == 'u' and spec[1] == 'i'
+                         and spec[2] == 'n' and spec[3] == 't')
+                    type = 'u';
+                else if (length == 1 and spec[0] == '*')
+                    type = '*';
+                else if (not (length == 3 and spec[0] == 's' and spec[1] == 't' and spec[2] == 'r'))
+                    return -1;
+
+                j = close;
+            }
+
+            if (j == size or text_[j] != '}')
+                return -1;
+
+            ++j;
+        }
+
+        if (type == '*' ? j != size : (j != size and text_[j] != '/'))
+            return -1;
+
+        pos_ = j;
+
+        static_node element;
+        element.kind = static_node::set;
+
+        switch (type) {
+        case '*':
+            element.add(0, 255);
+            element.bits[0] &= ~((std::uint64_t{1} << '\n') | (std::uint64_t{1} << '\r'));
+            return repeat_of(element, 0);
+        case 'u':
+            element.add('0', '9');
+            return repeat_of(element, 1);
+        case 'i': {
+            static_node sign;
+            sign.kind = static_node::set;
+            sign.add('-');
+            sign.add('+');
+
+            static_node n;
+            n.kind = static_node::seq;
+            n.child = add(sign);
+
+            static_node optional;
+            optional.kind = static_node::repeat;
+            optional.child = n.child;
+            optional.max = 1;
+            n.child = add(optional);
+
+            element.add('0', '9');
+            program_.nodes[n.child].next = repeat_of(element, 1);
+            return add(n);
+        }
+        default:
+            element.add(0, 255);
+            element.bits['/' >> 6] &= ~(std::uint64_t{1} << ('/' & 63));
+            return repeat_of(element, 1);
+        }
+    }
+
+    // \d, \w, \s and their complements; false for any other escape
+    constexpr static bool
+    class_escape(char c, static_node& n)
+    {
+        static_node s;
+        switch (c) {
+        case 'd': case 'D':
+            s.add('0', '9');
+            break;
+        case 'w': case 'W':
+            s.add('a', 'z');
+            s.add('A', 'Z');
+            s.add('0', '9');
+            s.add('_');
+            break;
+        case 's': case 'S':
+            s.add(' ');
+            s.add('\t', '\r');
+            break;
+        default:
+            return false;
+        }
+
+        if (c == 'D' or c == 'W' or c == 'S')
+            s.invert();
+
+        n.add(s);
+        return true;
+    }
+
+    // A single escaped character, or -1 for an unsupported escape
+    constexpr static int
+    char_escape(char c)
+    {
+        switch (c) {
+        case 'n': return '\n';
+        case 'r': return '\r';
+        case 't': return '\t';
+        case 'f': return '\f';
+        case 'v': return '\v';
+        case '0': return '\0';
+        default:
+            return is_tail(c) ? -1 : static_cast<unsigned char>(c);
+        }
+    }
+
+    constexpr int
+    character_class()
+    {
+        static_node n;
+        n.kind = static_node::set;
+
+        ++pos_;
+        const bool negate = peek() == '^';
+        if (negate)
+            ++pos_;
+
+        while (pos_ < Size and peek() != ']') {
+            int first = static_cast<unsigned char>(text_[pos_++]);
+            if (first == '\\') {
+                if (pos_ == Size)
+                    return fail();
+                if (class_escape(text_[pos_], n)) {
+                    ++pos_;
+                    continue;
+                }
+                if ((first = char_escape(text_[pos_++])) < 0)
+                    return fail();
+            }
+
+            int last = first;
+            if (peek() == '-' and pos_ + 1 < Size and text_[pos_ + 1] != ']') {
+                ++pos_;
+                last = static_cast<unsigned char>(text_[pos_++]);
+                if (last == '\\') {
+                    if (pos_ == Size or (last = char_escape(text_[pos_++])) < 0)
+                        return fail();
+                }
+                if (last < first)
+                    return fail();
+            }
+
+            n.add(static_cast<unsigned char>(first), static_cast<unsigned char>(last));
+        }
+
+        if (peek() != ']')
+            return fail();
+
+        ++pos_;
+        if (negate)
+            n.invert();
+
+        return add(n);
+    }
+
+    constexpr int
+    atom()
+    {
+        const int s = segment();
+        if (s >= 0 or not program_.valid)
+            return s;
+
+        static_node n;
+        const char c = text_[pos_];
+
+        switch (c) {
+        case '(': {
+            ++pos_;
+            if (peek() == '?') {
+                if (pos_ + 1 >= Size or text_[pos_ + 1] != ':')
+                    return fail();
+                pos_ += 2;
+            }
+
+            const int inner = alternation();
+            if (not program_.valid or peek() != ')')
+                return fail();
+
+            ++pos_;
+            return inner;
+        }
+        case '[':
+            return character_class();
+        case '.':
+            n.kind = static_node::set;
+            n.add(0, 255);
+            n.bits[0] &= ~((std::uint64_t{1} << '\n') | (std::uint64_t{1} << '\r'));
+            break;
+        case '^':
+            n.kind = static_node::bol;
+            break;
+        case '$':
+            n.kind = static_node::eol;
+            break;
+        case '\\': {
+            if (++pos_ == Size)
+                return fail();
+
+            n.kind = static_node::set;
+            if (class_escape(text_[pos_], n))
+                break;
+
+            const int e = char_escape(text_[pos_]);
+            if (e < 0)
+                return fail();
+
+            n.kind = static_node::chr;
+            n.c = static_cast<char>(e);
+            break;
+        }
+        case '*': case '+': case '?': case '{': case '|': case ')':
+            return fail();
+        default:
+            n.kind = static_node::chr;
+            n.c = c;
+            break;
+        }
+
+        ++pos_;
+        return add(n);
+    }
+
+    const char* text_;
+    std::size_t pos_ = 0;
+    static_program<Size> program_;
+
+}; // class static_parser
+
+/// Matching code generated from the program of Pattern
+template<class Pattern>
+struct static_matcher
+{
+    static constexpr auto const& program = Pattern::program;
+
+    struct range
+    {
+        const char* first;
+        const char* last;
+    };
+
+    template<int N, class K>
+    static bool
+    node(range const& r, const char* p, K const& k)
+    {
+        constexpr static_node n = program.nodes[N];
+
+        if constexpr (n.kind == static_node::chr)
+            return p != r.last and *p == n.c and k(p + 1);
+        else if constexpr (n.kind == static_node::set)
+            return p != r.last and n.test(static_cast<unsigned char>(*p)) and k(p + 1);
+        else if constexpr (n.kind == static_node::seq)
+            return sequence<n.child>(r, p, k);
+        else if constexpr (n.kind == static_node::alt)
+            return alternative<n.child>(r, p, k);
+        else if constexpr (n.kind == static_node::repeat) {
+            constexpr static_node element = program.nodes[n.child];
+            if constexpr (element.kind == static_node::chr or element.kind == static_node::set)
+                return repeat_chars<N>(r, p, k);
+            else
+                return repeat<N>(r, p, 0, k);
+        }
+        else if constexpr (n.kind == static_node::bol)
+            return p == r.first and k(p);
+        else if constexpr (n.kind == static_node::eol)
+            return p == r.last and k(p);
+        else
+            return k(p);
+    }
+
+    template<int I, class K>
+    static bool
+    sequence(range const& r, const char* p, K const& k)
+    {
+        if constexpr (I < 0)
+            return k(p);
+        else
+            return node<I>(r, p, [&r, &k](const char* q){
+                return sequence<program.nodes[I].next>(r, q, k);
+            });
+    }
+
+    template<int I, class K>
+    static bool
+    alternative(range const& r, const char* p, K const& k)
+    {
+        if constexpr (I < 0)
+            return false;
+        else
+            return node<I>(r, p, k) or alternative<program.nodes[I].next>(r, p, k);
+    }
+
+    // A run of single characters is scanned first, then given back one by one
+    template<int N, class K>
+    static bool
+    repeat_chars(range const& r, const char* p, K const& k)
+    {
+        constexpr static_node n = program.nodes[N];
+        constexpr static_node element = program.nodes[n.child];
+
+        std::size_t limit = static_cast<std::size_t>(r.last - p);
+        if (n.max >= 0 and limit > std::size_t(n.max))
+            limit = std::size_t(n.max);
+
+        std::size_t count = 0;
+        if constexpr (element.kind == static_node::chr)
+            while (count < limit and p[count] == element.c)
+                ++count;
+        else
+            while (count < limit and element.test(static_cast<unsigned char>(p[count])))
+                ++count;
+
+        for (;; --count) {
+            if (count < std::size_t(n.min))
+                return false;
+            if (k(p + count))
+                return true;
+            if (count == 0)
+                return false;
+        }
+    }
+
+    template<int N, class K>
+    static bool
+    repeat(range const& r, const char* p, int count, K const& k)
+    {
+        constexpr static_node n = program.nodes[N];
+
+        if ((n.max < 0 or count < n.max)
+                and node<n.child>(r, p, [&r, &k, p, count](const char* q){
+                    // An empty iteration only counts towards the minimum
+                    return (q != p or count < program.nodes[N].min)
+                            and repeat<N>(r, q, count + 1, k);
+                }))
+            return true;
+
+        return count >= n.min and k(p);
+    }
+
+    static bool
+    match(const char* first, const char* last)
+    {
+        const range r{first, last};
+        return node<program.root>(r, first, [last](const char* q){ return q == last; });
+    }
+
+}; // struct static_matcher
+
+} // namespace detail
+
+/**
+  @brief Regex backend for route patterns known at build time
+
+  Drop-in replacement for base::regex. A pattern written with the _re
+  literal is parsed by the compiler and turned into matching code:
+
+      using namespace http::literals;
+
+      router.get("^/users/(\\d+)$"_re, handler);
+
+  The literal converts to the pattern string and registers its code under
+  it, so compile() of the same string uses that code instead of
+  std::regex. Any other pattern, and every pattern of an icase or
+  non-ECMAScript router, is matched by base::regex as before. The
+  supported subset is the one of route paths: literals, '.', classes,
+  \d \w \s, groups, '|', the quantifiers, ^, $ and the typed segments of
+  base::segment_pattern; anything else fails to compile.
+*/
+class static_regex
+{
+    using self_type = static_regex;
+
+public:
+
+    using char_type = regex::char_type;
+
+    using traits_type = regex::traits_type;
+
+    using regex_type = regex::regex_type;
+
+    using flag_type = regex::flag_type;
+
+    using string_view_type = regex::string_view_type;
+
+    using matcher_type = bool (*)(const char*, const char*);
+
+    class compiled_type
+    {
+        friend class static_regex;
+
+    public:
+
+        /// True if the pattern is matched by generated code
+        bool
+        generated() const
+        {
+            return matcher_ != nullptr;
+        }
+
+    private:
+
+        matcher_type matcher_ = nullptr;
+        regex::compiled_type expression_;
+
+    }; // class compiled_type
+
+    inline static_regex(flag_type);
+
+    inline flag_type
+    flags() const;
+
+    inline compiled_type
+    compile(const std::string&) const;
+
+    inline bool
+    match(const compiled_type&, string_view_type) const;
+
+    /// Registers the generated code of a pattern, done by the _re literal
+    inline static void
+    define(const std::string&, matcher_type);
+
+private:
+
+    inline static matcher_type
+    find(const std::string&);
+
+    inline static std::unordered_map<std::string, matcher_type>&
+    registry();
+
+    inline static std::mutex&
+    mutex();
+
+    regex regex_;
+
+}; // class static_regex
+
+/// Pattern text as a type, with its program and generated code
+template<char... Cs>
+class static_pattern
+{
+public:
+
+    static constexpr std::size_t size = sizeof... (Cs);
+
+    static constexpr char text[size + 1] = {Cs..., '\0'};
+
+    static constexpr detail::static_program<size> program =
+            detail::static_parser<size>{text}.parse();
+
+    static_assert (program.valid, "Pattern is not supported by static_regex!");
+
+    /// True if the whole range matches the pattern
+    static bool
+    match(const char* first, const char* last)
+    {
+        return detail::static_matcher<static_pattern>::match(first, last);
+    }
+
+    operator std::string() const
+    {
+        std::string pattern{text, size};
+        static_regex::define(pattern, &static_pattern::match);
+        return pattern;
+    }
+
+}; // class static_pattern
+
+} // namespace base
+
+namespace literals {
+
+// A GNU extension, accepted by gcc and clang
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wgnu-string-literal-operator-template"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+template<class CharT, CharT... Cs>
+constexpr base::static_pattern<Cs...>
+operator"" _re()
+{
+    static_assert (std::is_same<CharT, char>::value, "Only narrow patterns are supported!");
+    return {};
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+} // namespace literals
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/static_regex.hxx>
+#endif // BEASTHTTP_CXX17_IF_CONSTEXPR && BEASTHTTP_STRING_LITERAL_TEMPLATE
+
+#endif // not defined BEASTHTTP_BASE_STATIC_REGEX_HXX
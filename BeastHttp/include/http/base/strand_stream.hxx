@@ -5,6 +5,8 @@
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/system_timer.hpp>
 
+#include <type_traits>
+
 namespace _0xdead4ead {
 namespace http {
 namespace base {
@@ -14,7 +16,10 @@ struct strand_stream :
 {
     using asio_type = boost::asio::strand<boost::asio::system_timer::executor_type>;
 
-    strand_stream(const boost::asio::system_timer::executor_type& executor)
+    template<class Executor,
+             typename = typename std::enable_if<
+                 not std::is_base_of<asio_type, Executor>::value>::type>
+    strand_stream(const Executor& executor)
         : asio_type(executor)
     {
     }
@@ -3,6 +3,7 @@
 
 #include <http/base/config.hxx>
 
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 
@@ -117,6 +118,43 @@ struct get<instance<Elements...>, 0>
 
 } // namespace typelist
 
+namespace sequence {
+
+template<std::size_t...>
+struct index
+{
+};
+
+template<class, class>
+struct concat;
+
+template<std::size_t... Left, std::size_t... Right>
+struct concat<index<Left...>, index<Right...>>
+{
+    using type = index<Left..., (sizeof... (Left) + Right)...>;
+};
+
+// Halves the length on every step, so the depth is logarithmic
+template<std::size_t Count>
+struct make
+        : concat<typename make<Count / 2>::type, typename make<Count - Count / 2>::type>
+{
+};
+
+template<>
+struct make<0>
+{
+    using type = index<>;
+};
+
+template<>
+struct make<1>
+{
+    using type = index<0>;
+};
+
+} // namespace sequence
+
 template<class...>
 struct conjunction;
 
@@ -357,6 +395,17 @@ struct has_regex_flag_type_cxx11 : try_invoke_cxx11<R, has_regex_flag_type_helpe
 {
 };
 
+struct has_route_type_helper
+{
+    template<class X>
+    auto operator()(wrap<X> x) -> typename decltype (value(x))::route_type;
+};
+
+template<class R, class X>
+struct has_route_type_cxx11 : try_invoke_cxx11<R, has_route_type_helper, X>
+{
+};
+
 struct has_value_type_helper
 {
     template<class X>
@@ -551,6 +600,13 @@ constexpr auto hasRegexFlagType(wrap<X> x)
                 [](auto x) -> typename decltype (value(x))::regex_flag_type {})(x);
 }
 
+template<class R, class X>
+constexpr auto hasRouteType(wrap<X> x)
+{
+    return isValid<R>(
+                [](auto x) -> typename decltype (value(x))::route_type {})(x);
+}
+
 template<class R, class X>
 constexpr auto hasValueType(wrap<X> x)
 {
@@ -652,6 +708,10 @@ template<class R, class X>
 constexpr auto hasRegexFlagType(X&&)
 -> decltype (has_regex_flag_type_cxx11<R, X>{});
 
+template<class R, class X>
+constexpr auto hasRouteType(X&&)
+-> decltype (has_route_type_cxx11<R, X>{});
+
 template<class R, class X>
 constexpr auto hasValueType(X&&)
 -> decltype (has_value_type_cxx11<R, X>{});
@@ -758,6 +818,9 @@ using HasRegexType = decltype (detail::hasRegexType<R>(detail::wrap<X>()));
 template<class X, class R>
 using HasRegexFlagType = decltype (detail::hasRegexFlagType<R>(detail::wrap<X>()));
 
+template<class X, class R>
+using HasRouteType = decltype (detail::hasRouteType<R>(detail::wrap<X>()));
+
 template<class... Elements>
 using TypeList = detail::typelist::instance<Elements...>;
 
@@ -767,6 +830,12 @@ using ForEach = detail::typelist::for_each<0, TypeList, Pred>;
 template<class TypeList, unsigned Index>
 using Get = detail::typelist::get<TypeList, Index>;
 
+template<std::size_t... Indexes>
+using IndexSequence = detail::sequence::index<Indexes...>;
+
+template<std::size_t Count>
+using MakeIndexSequence = typename detail::sequence::make<Count>::type;
+
 template<class... Bn>
 using Conjunction = detail::conjunction<Bn...>;
 
@@ -0,0 +1,224 @@
+#ifndef BEASTHTTP_BASE_VERB_MAP_HXX
+#define BEASTHTTP_BASE_VERB_MAP_HXX
+
+#include <boost/beast/http/verb.hpp>
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+/**
+  @brief Method map indexed directly by the verb
+
+  Drop-in replacement for the MethodMap container of a session. Entries
+  live in a fixed array indexed by boost::beast::http::verb, and a bitmask
+  of the occupied slots answers find() with one bit test, without
+  comparing keys. Iteration visits the entries in verb order, as std::map
+  does.
+*/
+template<class Key, class Value, class... Args>
+class verb_map
+{
+    using self_type = verb_map;
+
+    static_assert (std::is_same<Key, boost::beast::http::verb>::value,
+                   "verb_map is keyed by boost::beast::http::verb!");
+
+public:
+
+    using key_type = Key;
+
+    using mapped_type = Value;
+
+    using value_type = std::pair<const key_type, mapped_type>;
+
+    using size_type = std::size_t;
+
+    static constexpr size_type capacity =
+            static_cast<size_type>(boost::beast::http::verb::unlink) + 1;
+
+    static_assert (capacity <= 64, "Too many verbs for the slot mask!");
+
+    template<bool Const>
+    class basic_iterator
+    {
+        friend class verb_map;
+
+        template<bool>
+        friend class basic_iterator;
+
+        using map_pointer = typename std::conditional<
+        Const, verb_map const*, verb_map*>::type;
+
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+
+        using value_type = typename verb_map::value_type;
+
+        using difference_type = std::ptrdiff_t;
+
+        using pointer = typename std::conditional<
+        Const, value_type const*, value_type*>::type;
+
+        using reference = typename std::conditional<
+        Const, value_type const&, value_type&>::type;
+
+        basic_iterator() = default;
+
+        template<bool _Const = Const, class = typename std::enable_if<_Const>::type>
+        basic_iterator(basic_iterator<false> const& other)
+            : map_{other.map_}, index_{other.index_}
+        {
+        }
+
+        reference
+        operator*() const
+        {
+            return *map_->slots_[index_];
+        }
+
+        pointer
+        operator->() const
+        {
+            return map_->slots_[index_].get();
+        }
+
+        basic_iterator&
+        operator++()
+        {
+            index_ = map_->next(index_ + 1);
+            return *this;
+        }
+
+        basic_iterator
+        operator++(int)
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        friend bool
+        operator==(basic_iterator const& lhs, basic_iterator const& rhs)
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool
+        operator!=(basic_iterator const& lhs, basic_iterator const& rhs)
+        {
+            return lhs.index_ != rhs.index_;
+        }
+
+    private:
+
+        basic_iterator(map_pointer map, size_type index)
+            : map_{map}, index_{index}
+        {
+        }
+
+        map_pointer map_ = nullptr;
+        size_type index_ = capacity;
+
+    }; // class basic_iterator
+
+    using iterator = basic_iterator<false>;
+
+    using const_iterator = basic_iterator<true>;
+
+    verb_map() = default;
+
+    verb_map(self_type const&);
+
+    verb_map(self_type&&) = default;
+
+    self_type&
+    operator=(self_type const&);
+
+    self_type&
+    operator=(self_type&&) = default;
+
+    iterator
+    begin();
+
+    iterator
+    end();
+
+    const_iterator
+    begin() const;
+
+    const_iterator
+    end() const;
+
+    const_iterator
+    cbegin() const;
+
+    const_iterator
+    cend() const;
+
+    size_type
+    size() const;
+
+    bool
+    empty() const;
+
+    iterator
+    find(key_type const&);
+
+    const_iterator
+    find(key_type const&) const;
+
+    mapped_type&
+    at(key_type const&);
+
+    mapped_type const&
+    at(key_type const&) const;
+
+    mapped_type&
+    operator[](key_type const&);
+
+    std::pair<iterator, bool>
+    insert(value_type const&);
+
+    std::pair<iterator, bool>
+    insert(value_type&&);
+
+    template<class... Params>
+    std::pair<iterator, bool>
+    emplace(Params&&...);
+
+private:
+
+    static size_type
+    index(key_type const&);
+
+    bool
+    contains(size_type) const;
+
+    size_type
+    next(size_type) const;
+
+    std::pair<iterator, bool>
+    assign(std::unique_ptr<value_type>&&);
+
+    std::array<std::unique_ptr<value_type>, capacity> slots_;
+    std::uint64_t mask_ = 0;
+    size_type size_ = 0;
+
+}; // class verb_map
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/verb_map.hxx>
+
+#endif // not defined BEASTHTTP_BASE_VERB_MAP_HXX
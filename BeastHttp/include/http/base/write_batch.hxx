@@ -0,0 +1,98 @@
+#ifndef BEASTHTTP_BASE_WRITE_BATCH_HXX
+#define BEASTHTTP_BASE_WRITE_BATCH_HXX
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/http/message.hpp>
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace _0xdead4ead {
+namespace http {
+namespace base {
+
+/**
+  @brief Serialized responses, sent with a single gather write
+
+  Headers are copied into the batch, bodies which keep their bytes in
+  the message (string, vector, span and empty bodies) are referenced,
+  so the responses must outlive the write. Other bodies are copied, and
+  taken only when their size is known and they fit the limit of copied
+  bytes; chunked ones are never taken.
+*/
+class write_batch
+{
+    using self_type = write_batch;
+
+    struct piece
+    {
+        const void* data;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    struct collect;
+
+    template<class Body>
+    struct references;
+
+    std::size_t limit_;
+
+    std::size_t responses_ = 0;
+
+    bool need_eof_ = false;
+
+    std::string storage_;
+
+    std::vector<piece> pieces_;
+
+    std::vector<boost::asio::const_buffer> buffers_;
+
+    void
+    rollback(std::size_t pieces, std::size_t stored);
+
+public:
+
+    using const_buffers_type = std::vector<boost::asio::const_buffer>;
+
+    explicit
+    write_batch(std::size_t limit = 0);
+
+    /// Bytes the batch copies at most, 0 for none
+    std::size_t
+    limit() const;
+
+    void
+    limit(std::size_t);
+
+    /// Appends the response, unless it does not fit the batch
+    template<class Body, class Fields>
+    bool
+    append(boost::beast::http::response<Body, Fields>& response);
+
+    /// Responses in the batch
+    std::size_t
+    size() const;
+
+    /// True when the last response closes the connection
+    bool
+    need_eof() const;
+
+    /// Buffers of all the responses, in order
+    const_buffers_type const&
+    buffers();
+
+    void
+    clear();
+
+}; // class write_batch
+
+} // namespace base
+} // namespace http
+} // namespace _0xdead4ead
+
+#include <http/base/impl/write_batch.hxx>
+
+#endif // not defined BEASTHTTP_BASE_WRITE_BATCH_HXX
@@ -40,7 +40,7 @@ public:
     using chain_node_type = chain_node;
 
     chain_router(regex_flag_type regex_flags) noexcept
-        : base_type{resource_map_, method_map_},
+        : base_type{resource_map_, method_map_, regex_flags},
           regex_flags_{regex_flags}
     {
     }
@@ -52,6 +52,12 @@ public:
         return chain_node{*this};
     }
 
+    /**
+      @brief Copies the routes of another router under a path prefix
+
+      Routers mounted in the other one stay mounted under a literal prefix;
+      under a regular expression their routes are copied too.
+    */
     void
     use(resource_regex_type const& path_to_resource, base_type const& other)
     {
@@ -64,6 +70,24 @@ public:
         base_type::use("", other);
     }
 
+    /**
+      @brief Mounts another router under a literal path prefix
+
+      Unlike use(), the routes are not copied: a request whose target is the
+      prefix or starts with it followed by '/' is resolved by the other
+      router, against the target without the prefix. Later changes to that
+      router are seen at once; it has to outlive this one.
+
+      Mounts are tried before the routes of this router, which only see
+      the requests the mounted router has no route for. The prefix must
+      be literal, std::invalid_argument is thrown otherwise.
+    */
+    void
+    mount(resource_regex_type const& path_to_resource, base_type const& other)
+    {
+        base_type::mount(path_to_resource, other);
+    }
+
     template<class Pack>
     auto
     param()
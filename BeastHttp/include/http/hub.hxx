@@ -0,0 +1,142 @@
+#ifndef BEASTHTTP_HUB_HXX
+#define BEASTHTTP_HUB_HXX
+
+#include <http/base/lockable.hxx>
+#include <http/base/outbox.hxx>
+
+#include <boost/beast/http/message.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace _0xdead4ead {
+namespace http {
+
+/**
+  @brief Fans events out to the sessions subscribed to it
+
+      http::hub<http_session> hub;
+
+      router.get("^/events$", [&hub](auto request, auto context){
+          hub.subscribe(context);
+          context.recv();
+      });
+
+      hub.publish(event);
+
+  An event is serialized once into an immutable buffer, shared by the
+  outboxes of all the subscribers: each one is pushed a reference to it
+  through its strand and writes the same bytes, under its push limits.
+  The hub holds its subscribers weakly, a session gone is dropped by the
+  next publish.
+*/
+template<class Session>
+class hub
+{
+    using self_type = hub;
+
+    using mutex_type = base::lockable::mutex_type;
+
+public:
+
+    using session_type = Session;
+
+    using context_type = typename session_type::context_type;
+
+    using weak_context = typename session_type::weak_context;
+
+    using message_type = typename session_type::shared_message;
+
+    hub() = default;
+
+    hub(self_type const&) = delete;
+
+    self_type&
+    operator=(self_type const&) = delete;
+
+    void
+    subscribe(context_type const& context)
+    {
+        BEASTHTTP_LOCKABLE_ENTER_TO_WRITE(mutex_)
+
+        subscribers_.push_back(context.weak());
+    }
+
+    /// Subscribers, the ones gone since the last publish included
+    std::size_t
+    size() const
+    {
+        BEASTHTTP_LOCKABLE_ENTER_TO_READ(mutex_)
+
+        return subscribers_.size();
+    }
+
+    /// Serializes the event once, returns the subscribers it is pushed to
+    template<class Body, class Fields>
+    std::size_t
+    publish(boost::beast::http::response<Body, Fields>& event)
+    {
+        boost::beast::error_code ec;
+
+        auto message = base::outbox::encode(event, ec);
+        if (ec)
+            BOOST_THROW_EXCEPTION(boost::system::system_error{ec});
+
+        return publish(message);
+    }
+
+    template<class Body, class Fields>
+    std::size_t
+    publish(boost::beast::http::response<Body, Fields>&& event)
+    {
+        return publish(event);
+    }
+
+    /// Pushes an event encoded beforehand
+    std::size_t
+    publish(message_type const& message)
+    {
+        std::vector<context_type> targets;
+
+        {
+            BEASTHTTP_LOCKABLE_ENTER_TO_WRITE(mutex_)
+
+            targets.reserve(subscribers_.size());
+
+            for (std::size_t index = 0; index < subscribers_.size();) {
+                bool is_ok = false;
+                auto context = context_type::save(subscribers_[index].load(), is_ok);
+
+                if (is_ok) {
+                    targets.push_back(std::move(context));
+                    ++index;
+                    continue;
+                }
+
+                subscribers_[index] = subscribers_.back();
+                subscribers_.pop_back();
+            }
+        }
+
+        // Pushed out of the lock, a push may run its session's handlers
+        // at once, and these may use the hub
+        for (auto const& context : targets)
+            context.push(message);
+
+        return targets.size();
+    }
+
+private:
+
+    mutable mutex_type mutex_;
+
+    std::vector<weak_context> subscribers_;
+
+}; // class hub
+
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_HUB_HXX
@@ -3,9 +3,12 @@
 
 #include <http/base/config.hxx>
 
+#include <boost/beast/http/verb.hpp>
+
 #include <cassert>
 #include <cstddef>
 #include <tuple>
+#include <type_traits>
 
 #define BEASTHTTP_LITERALS_DECLARE_VERB_SYMBOL(x) class x;
 
@@ -28,6 +31,12 @@
         } \
     };
 
+#define BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(x) \
+    template<> \
+    struct __method<symbol:: x> \
+        : std::integral_constant<boost::beast::http::verb, boost::beast::http::verb:: x> \
+    {};
+
 #define BEASTHTTP_LITERALS_DECLARE_ROUTE_STRUCT \
     struct __route \
     { \
@@ -172,6 +181,46 @@ BEASTHTTP_LITERALS_DECLARE_VERB_STRUCT(link)
 BEASTHTTP_LITERALS_DECLARE_VERB_STRUCT(unlink)
 BEASTHTTP_LITERALS_DECLARE_VERB_STRUCT(all)
 
+// Method of a literal, verb::unknown stands for any method
+template<class> struct __method;
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(get)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(post)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(put)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(head)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(delete_)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(options)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(connect)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(trace)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(copy)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(lock)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(mkcol)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(move)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(propfind)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(proppatch)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(search)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(unlock)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(bind)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(rebind)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(unbind)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(acl)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(report)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(mkactivity)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(checkout)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(merge)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(msearch)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(notify)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(subscribe)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(unsubscribe)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(patch)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(purge)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(mkcalendar)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(link)
+BEASTHTTP_LITERALS_DECLARE_VERB_METHOD(unlink)
+template<>
+struct __method<symbol::all>
+    : std::integral_constant<boost::beast::http::verb, boost::beast::http::verb::unknown>
+{};
+
 BEASTHTTP_LITERALS_DECLARE_ROUTE_STRUCT
 
 } // namespace detail
@@ -198,211 +247,211 @@ value(const std::tuple<Types...>& tpl, std::integral_constant<int, Index>)
 }
 #endif // BEASTHTTP_CXX14_CONSTEXPR
 
-inline detail::__verb<detail::symbol::get>
+constexpr detail::__verb<detail::symbol::get>
 operator "" _get(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::get>{s, n};
 }
 
-inline detail::__verb<detail::symbol::post>
+constexpr detail::__verb<detail::symbol::post>
 operator "" _post(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::post>{s, n};
 }
 
-inline detail::__verb<detail::symbol::put>
+constexpr detail::__verb<detail::symbol::put>
 operator "" _put(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::put>{s, n};
 }
 
-inline detail::__verb<detail::symbol::head>
+constexpr detail::__verb<detail::symbol::head>
 operator "" _head(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::head>{s, n};
 }
 
-inline detail::__verb<detail::symbol::delete_>
+constexpr detail::__verb<detail::symbol::delete_>
 operator "" _delete(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::delete_>{s, n};
 }
 
-inline detail::__verb<detail::symbol::options>
+constexpr detail::__verb<detail::symbol::options>
 operator "" _options(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::options>{s, n};
 }
 
-inline detail::__verb<detail::symbol::connect>
+constexpr detail::__verb<detail::symbol::connect>
 operator "" _connect(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::connect>{s, n};
 }
 
-inline detail::__verb<detail::symbol::trace>
+constexpr detail::__verb<detail::symbol::trace>
 operator "" _trace(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::trace>{s, n};
 }
 
-inline detail::__verb<detail::symbol::copy>
+constexpr detail::__verb<detail::symbol::copy>
 operator "" _copy(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::copy>{s, n};
 }
 
-inline detail::__verb<detail::symbol::lock>
+constexpr detail::__verb<detail::symbol::lock>
 operator "" _lock(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::lock>{s, n};
 }
 
-inline detail::__verb<detail::symbol::mkcol>
+constexpr detail::__verb<detail::symbol::mkcol>
 operator "" _mkcol(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::mkcol>{s, n};
 }
 
-inline detail::__verb<detail::symbol::move>
+constexpr detail::__verb<detail::symbol::move>
 operator "" _move(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::move>{s, n};
 }
 
-inline detail::__verb<detail::symbol::propfind>
+constexpr detail::__verb<detail::symbol::propfind>
 operator "" _propfind(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::propfind>{s, n};
 }
 
-inline detail::__verb<detail::symbol::proppatch>
+constexpr detail::__verb<detail::symbol::proppatch>
 operator "" _proppatch(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::proppatch>{s, n};
 }
 
-inline detail::__verb<detail::symbol::search>
+constexpr detail::__verb<detail::symbol::search>
 operator "" _search(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::search>{s, n};
 }
 
-inline detail::__verb<detail::symbol::unlock>
+constexpr detail::__verb<detail::symbol::unlock>
 operator "" _unlock(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::unlock>{s, n};
 }
 
-inline detail::__verb<detail::symbol::bind>
+constexpr detail::__verb<detail::symbol::bind>
 operator "" _bind(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::bind>{s, n};
 }
 
-inline detail::__verb<detail::symbol::rebind>
+constexpr detail::__verb<detail::symbol::rebind>
 operator "" _rebind(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::rebind>{s, n};
 }
 
-inline detail::__verb<detail::symbol::unbind>
+constexpr detail::__verb<detail::symbol::unbind>
 operator "" _unbind(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::unbind>{s, n};
 }
 
-inline detail::__verb<detail::symbol::acl>
+constexpr detail::__verb<detail::symbol::acl>
 operator "" _acl(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::acl>{s, n};
 }
 
-inline detail::__verb<detail::symbol::report>
+constexpr detail::__verb<detail::symbol::report>
 operator "" _report(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::report>{s, n};
 }
 
-inline detail::__verb<detail::symbol::mkactivity>
+constexpr detail::__verb<detail::symbol::mkactivity>
 operator "" _mkactivity(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::mkactivity>{s, n};
 }
 
-inline detail::__verb<detail::symbol::checkout>
+constexpr detail::__verb<detail::symbol::checkout>
 operator "" _checkout(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::checkout>{s, n};
 }
 
-inline detail::__verb<detail::symbol::merge>
+constexpr detail::__verb<detail::symbol::merge>
 operator "" _merge(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::merge>{s, n};
 }
 
-inline detail::__verb<detail::symbol::msearch>
+constexpr detail::__verb<detail::symbol::msearch>
 operator "" _msearch(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::msearch>{s, n};
 }
 
-inline detail::__verb<detail::symbol::notify>
+constexpr detail::__verb<detail::symbol::notify>
 operator "" _notify(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::notify>{s, n};
 }
 
-inline detail::__verb<detail::symbol::subscribe>
+constexpr detail::__verb<detail::symbol::subscribe>
 operator "" _subscribe(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::subscribe>{s, n};
 }
 
-inline detail::__verb<detail::symbol::unsubscribe>
+constexpr detail::__verb<detail::symbol::unsubscribe>
 operator "" _unsubscribe(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::unsubscribe>{s, n};
 }
 
-inline detail::__verb<detail::symbol::patch>
+constexpr detail::__verb<detail::symbol::patch>
 operator "" _patch(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::patch>{s, n};
 }
 
-inline detail::__verb<detail::symbol::purge>
+constexpr detail::__verb<detail::symbol::purge>
 operator "" _purge(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::purge>{s, n};
 }
 
-inline detail::__verb<detail::symbol::mkcalendar>
+constexpr detail::__verb<detail::symbol::mkcalendar>
 operator "" _mkcalendar(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::mkcalendar>{s, n};
 }
 
-inline detail::__verb<detail::symbol::link>
+constexpr detail::__verb<detail::symbol::link>
 operator "" _link(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::link>{s, n};
 }
 
-inline detail::__verb<detail::symbol::unlink>
+constexpr detail::__verb<detail::symbol::unlink>
 operator "" _unlink(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::unlink>{s, n};
 }
 
-inline detail::__verb<detail::symbol::all>
+constexpr detail::__verb<detail::symbol::all>
 operator "" _all(const char* s, std::size_t n)
 {
     return detail::__verb<detail::symbol::all>{s, n};
 }
 
-inline detail::__route
+constexpr detail::__route
 operator "" _route(const char* s, std::size_t n)
 {
     return detail::__route{s, n};
@@ -1,57 +1,29 @@
 #ifndef BEASTHTTP_PARAM_HXX
 #define BEASTHTTP_PARAM_HXX
 
-#include <http/base/regex.hxx>
+#include <http/base/cb.hxx>
+#include <http/base/config.hxx>
+#include <http/base/segment_pattern.hxx>
 #include <http/base/traits.hxx>
 
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <regex>
+#include <string>
 #include <tuple>
-#include <mutex>
+#include <type_traits>
 
-#include <boost/lexical_cast.hpp>
+#ifdef BEASTHTTP_CXX17_CHARCONV
+#include <charconv>
+#endif // BEASTHTTP_CXX17_CHARCONV
 
-#define BEASTHTTP_IMPL_PARAM_PROCESS_CLASSIC \
-    if (shared_block_p_->rp_iter_ \
-            != shared_block_p_->regex_pack.cbegin()) { \
-        shared_block_p_->rp_iter_ = shared_block_p_->regex_pack.cend(); \
-        shared_block_p_->rp_iter_--; \
-        shared_block_p_->cur_pos_cb_ = shared_block_p_->regex_pack.size() - 1; \
-    } \
-    std::smatch what; \
-    const auto& target = request.target().to_string(); \
-    if (shared_block_p_->regex_.match( \
-                *(shared_block_p_->rp_iter_), target, what)) \
-        for (size_t i = 1; i < what.size(); i++) \
-            shared_block_p_->str_args.push_back(what[int(i)]);
-
-#define BEASTHTTP_IMPL_PARAM_PROCESS_ADVANCED \
-    for (std::size_t i = shared_block_p_->cur_pos_cb_; i < it.pos(); i++) { \
-        shared_block_p_->rp_iter_++; \
-        if (shared_block_p_->rp_iter_ == shared_block_p_->regex_pack.cend()) \
-            shared_block_p_->rp_iter_--; \
-        shared_block_p_->cur_pos_cb_++; \
-    } \
-    if (shared_block_p_->rp_iter_ == shared_block_p_->regex_pack.cbegin()) \
-        shared_block_p_->rp_iter_++; \
-    std::smatch what; \
-    const auto& target = request.target().to_string(); \
-    if (shared_block_p_->regex_.match( \
-                *(shared_block_p_->rp_iter_), target, what)) \
-        for (size_t i = 1; i < what.size(); i++) \
-            shared_block_p_->str_args.push_back(what[int(i)]);
-
-#define BEASTHTTP_DEFINE_MEMBERS_AND_STRUCTS \
-    shared_block_ptr shared_block_p_; \
-    F f_; \
-    explicit \
-    paramcb(const shared_block_ptr& shared_block_p, const F& f) \
-        : shared_block_p_{shared_block_p}, \
-          f_{f} \
-    {} \
-    explicit \
-    paramcb(const shared_block_ptr& shared_block_p, F&& f) \
-        : shared_block_p_{shared_block_p}, \
-          f_{std::move(f)} \
-    {}
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/container/small_vector.hpp>
+#include <boost/lexical_cast.hpp>
 
 namespace _0xdead4ead {
 namespace http {
@@ -64,6 +36,197 @@ class chain_router;
 
 namespace param {
 
+namespace detail {
+
+template<class T>
+struct is_number : std::integral_constant<bool,
+        std::is_arithmetic<T>::value
+        and not std::is_same<T, bool>::value
+        and not std::is_same<T, char>::value
+        and not std::is_same<T, signed char>::value
+        and not std::is_same<T, unsigned char>::value
+        and not std::is_same<T, wchar_t>::value
+        and not std::is_same<T, char16_t>::value
+        and not std::is_same<T, char32_t>::value>
+{
+};
+
+// A '+' is taken as the sign of the number only, "+-5" is not a number
+inline bool
+is_plus_sign(boost::beast::string_view in, bool floating)
+{
+    return in.size() > 1 and in[0] == '+'
+            and ((in[1] >= '0' and in[1] <= '9') or (floating and in[1] == '.'));
+}
+
+template<class T>
+bool
+parse_integer(boost::beast::string_view in, T& out)
+{
+    if (is_plus_sign(in, false))
+        in.remove_prefix(1);
+
+    if (in.empty())
+        return false;
+
+#ifdef BEASTHTTP_CXX17_CHARCONV
+    auto const result = std::from_chars(in.data(), in.data() + in.size(), out);
+    return result.ec == std::errc{} and result.ptr == in.data() + in.size();
+#else
+    bool negative = false;
+    if (std::is_signed<T>::value and in.front() == '-') {
+        negative = true;
+        in.remove_prefix(1);
+        if (in.empty())
+            return false;
+    }
+
+    using unsigned_type = typename std::make_unsigned<T>::type;
+
+    unsigned_type const limit = negative
+            ? unsigned_type(std::numeric_limits<T>::max()) + 1
+            : unsigned_type(std::numeric_limits<T>::max());
+
+    unsigned_type value = 0;
+    for (char c : in) {
+        if (c < '0' or c > '9')
+            return false;
+
+        unsigned_type const digit = unsigned_type(c - '0');
+        if (value > (limit - digit) / 10)
+            return false;
+
+        value = value * 10 + digit;
+    }
+
+    out = negative ? T(unsigned_type(0) - value) : T(value);
+    return true;
+#endif // BEASTHTTP_CXX17_CHARCONV
+}
+
+template<class T>
+bool
+parse_floating(boost::beast::string_view in, T& out)
+{
+    if (is_plus_sign(in, true))
+        in.remove_prefix(1);
+    else if (not in.empty() and in.front() == '+')
+        return false;
+
+    if (in.empty())
+        return false;
+
+#ifdef BEASTHTTP_CXX17_FLOATING_CHARCONV
+    auto const result = std::from_chars(in.data(), in.data() + in.size(), out);
+    return result.ec == std::errc{} and result.ptr == in.data() + in.size();
+#else
+    char buffer[64];
+    if (in.size() >= sizeof (buffer))
+        return false;
+
+    std::memcpy(buffer, in.data(), in.size());
+    buffer[in.size()] = '\0';
+
+    char* end = nullptr;
+    long double const value = std::strtold(buffer, &end);
+    if (end != buffer + in.size())
+        return false;
+
+    out = T(value);
+    return true;
+#endif // BEASTHTTP_CXX17_FLOATING_CHARCONV
+}
+
+} // namespace detail
+
+/**
+  @brief Converts one capture to an element of a param::pack
+
+  convert() returns false when the text is not a valid T, in that case
+  the route's on_bad_request handler is called instead of the route's
+  own handler; without one, the client is answered 400. Specialize it
+  for your own types, for example
+
+      template<>
+      struct http::param::converter<uuid>
+      {
+          static bool
+          convert(boost::beast::string_view in, uuid& out);
+      };
+
+  The primary template falls back to boost::conversion::try_lexical_convert.
+*/
+template<class T, class = void>
+struct converter
+{
+    static bool
+    convert(boost::beast::string_view in, T& out)
+    {
+        return boost::conversion::try_lexical_convert(in.data(), in.size(), out);
+    }
+}; // struct converter
+
+template<class T>
+struct converter<T, typename std::enable_if<
+        detail::is_number<T>::value and std::is_integral<T>::value>::type>
+{
+    static bool
+    convert(boost::beast::string_view in, T& out)
+    {
+        return detail::parse_integer(in, out);
+    }
+}; // struct converter
+
+template<class T>
+struct converter<T, typename std::enable_if<
+        std::is_floating_point<T>::value>::type>
+{
+    static bool
+    convert(boost::beast::string_view in, T& out)
+    {
+        return detail::parse_floating(in, out);
+    }
+}; // struct converter
+
+template<class T>
+struct converter<T, typename std::enable_if<
+        std::is_enum<T>::value>::type>
+{
+    static bool
+    convert(boost::beast::string_view in, T& out)
+    {
+        typename std::underlying_type<T>::type value;
+        if (not converter<decltype (value)>::convert(in, value))
+            return false;
+
+        out = T(value);
+        return true;
+    }
+}; // struct converter
+
+template<>
+struct converter<std::string>
+{
+    static bool
+    convert(boost::beast::string_view in, std::string& out)
+    {
+        out.assign(in.data(), in.size());
+        return true;
+    }
+}; // struct converter
+
+// Views into the target, valid while the request walks the chain
+template<>
+struct converter<boost::beast::string_view>
+{
+    static bool
+    convert(boost::beast::string_view in, boost::beast::string_view& out)
+    {
+        out = in;
+        return true;
+    }
+}; // struct converter
+
 template<class, class>
 class base;
 
@@ -75,9 +238,7 @@ class pack
 {
     using self_type = pack;
 
-    using regex_type = http::base::regex;
-
-    static constexpr unsigned max_count = 12;
+    static constexpr std::size_t count = sizeof... (Types);
 
     template<class T, unsigned>
     struct Check
@@ -88,9 +249,6 @@ class pack
 
     using TypeList = http::base::traits::TypeList<Types...>;
 
-    template<unsigned Index>
-    using get_ = http::base::traits::Get<TypeList, Index>;
-
     http::base::traits::ForEach<TypeList, Check> dummy;
 
     template<class, class>
@@ -102,7 +260,7 @@ public:
 
     template<class Router>
     static impl<Router, self_type>
-    provide(Router& router, typename regex_type::flag_type flags)
+    provide(Router& router, typename Router::regex_type::flag_type flags)
     {
         return impl<Router, self_type>{router, flags};
     }
@@ -122,9 +280,11 @@ protected:
 
     using resource_regex_type = typename router_type::resource_regex_type;
 
-    using resource_regex_pack_type = std::vector<resource_regex_type>;
+    using regex_type = typename router_type::regex_type;
+
+    using resource_regex_pack_type = std::vector<typename regex_type::compiled_type>;
 
-    using regex_type = typename pack_type::regex_type;
+    using segment_pack_type = std::vector<http::base::segment_pattern>;
 
     using tuple_type = typename pack_type::Tuple;
 
@@ -151,2566 +311,309 @@ protected:
                    http::base::traits::HasStorageType<router_type, void>>::value,
                    "Router type is incorrect!");
 
+    // Filled once when the route is added and only read afterwards. A path
+    // made of literal and named segments only ("/users/{id:int}") is kept
+    // in segment_pack and matched without the regex engine.
     struct shared_block : public std::enable_shared_from_this<shared_block>
     {
-        std::recursive_mutex mutex_;
         router_type& router_;
-        size_t cur_pos_cb_ = 0;
         resource_regex_pack_type regex_pack;
-        typename resource_regex_pack_type::const_iterator rp_iter_;
-        std::vector<std::string> str_args;
+        segment_pack_type segment_pack;
+        bool segmented_ = false;
         regex_type regex_;
+        std::function<void (request_type&, context_type)> on_bad_request_;
 
         shared_block(router_type& router, typename regex_type::flag_type flags)
             : router_{router}, regex_{flags}
         {
         }
 
-        void reset(){
-            rp_iter_ = regex_pack.cbegin();
-            cur_pos_cb_ = 0;
-            str_args.clear();
-        }
-
-    }; // struct shared_block
-
-    using shared_block_type = shared_block;
-
-    using shared_block_ptr = std::shared_ptr<shared_block_type>;
-
-    shared_block_ptr shared_block_p_;
-
-    base(const shared_block_ptr& shared_block_p)
-        : shared_block_p_{shared_block_p}
-    {
-    }
-
-    void
-    split_regex(resource_regex_type path_to_resource)
-    {
-        if (path_to_resource.empty())
-            return;
-
-        shared_block_p_->regex_pack.clear();
-        shared_block_p_->regex_pack.push_back(path_to_resource);
-        constexpr char delim = '/';
-        size_t pos = 0;
-        std::string token;
-        while(true) {
-            pos = path_to_resource.find(delim);
-            if (pos == 0)
-                pos = path_to_resource.find(delim, pos + 1);
-            if (pos != std::string::npos) {
-                token = path_to_resource.substr(0, pos);
-                shared_block_p_->regex_pack.push_back(token);
-                path_to_resource.erase(0, pos);
-            }
-            else {
-                token = path_to_resource;
-                shared_block_p_->regex_pack.push_back(token);
-                break;
-            }
+        std::size_t
+        size() const
+        {
+            return segmented_ ? segment_pack.size() : regex_pack.size();
         }
-        shared_block_p_->rp_iter_ = shared_block_p_->regex_pack.cbegin();
-    }
-
-    template<class F, unsigned count>
-    struct paramcb
-    {
-        static_assert (count != 0, "Incorrect value, pack is empty!");
-        static_assert (count <= pack_type::max_count, "Pack types limit!");
-    };
-
-    template<class F>
-    struct paramcb<F, 1>
-    {
-        static constexpr unsigned count = 1;
-
-        BEASTHTTP_DEFINE_MEMBERS_AND_STRUCTS
 
         void
-        operator()(request_type request, context_type context)
+        bad_request(request_type& request, context_type context) const
         {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_CLASSIC
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0])
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), tuple_type{});
-            }
-            shared_block_p_->reset();
+            if (on_bad_request_)
+                on_bad_request_(request, std::move(context));
+            else
+                reject(request, context, 0);
         }
 
-        void
-        operator()(request_type request, context_type context, iterator_type it)
+        // Without an on_bad_request handler the client is answered 400
+        template<class Context>
+        static auto
+        reject(request_type& request, Context& context, int)
+        -> decltype (context.send(std::declval<boost::beast::http::response<
+                                      boost::beast::http::string_body>>()), void())
         {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_ADVANCED
+            boost::beast::http::response<boost::beast::http::string_body> response{
+                boost::beast::http::status::bad_request, request.version()};
+            response.set(boost::beast::http::field::content_type, "text/plain");
+            response.keep_alive(request.keep_alive());
+            response.body() = "Bad request\n";
+            response.prepare_payload();
+
+            context.send(std::move(response));
+        }
 
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0])
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), std::move(it), tuple_type{});
-            }
+        template<class Context>
+        static void
+        reject(request_type&, Context&, long)
+        {
         }
 
-    }; // struct paramcb
+    }; // struct shared_block
 
-    template<class F>
-    struct paramcb<F, 2>
+    // Captures of one request, as slices of the target kept in the state of
+    // the chain (or of the request's own target, for a single handler). The
+    // first handler of the chain keeps it on its stack and leaves it in the
+    // state of the chain, where the following ones (called from inside it,
+    // on any thread) find it, so requests never share mutable state.
+    struct request_block
     {
-        static constexpr unsigned count = 2;
+        using args_type = boost::container::small_vector<
+            boost::beast::string_view, pack_type::count>;
 
-        BEASTHTTP_DEFINE_MEMBERS_AND_STRUCTS
+        shared_block const* owner_;
+        http::base::cb::chain* chain_ = nullptr;
+        bool failed_ = false;
+        size_t cur_pos_cb_ = 0;
+        size_t rp_pos_ = 0;
+        args_type args;
 
-        void
-        operator()(request_type request, context_type context)
+        explicit
+        request_block(shared_block const& owner)
+            : owner_{&owner}
         {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_CLASSIC
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1])
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), tuple_type{});
-            }
-            shared_block_p_->reset();
         }
 
-        void
-        operator()(request_type request, context_type context, iterator_type it)
-        {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
+        request_block(request_block const&) = delete;
 
-            BEASTHTTP_IMPL_PARAM_PROCESS_ADVANCED
+        request_block&
+        operator=(request_block const&) = delete;
 
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1])
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), std::move(it), tuple_type{});
+        ~request_block()
+        {
+            if (chain_ != nullptr) {
+                chain_->owner = nullptr;
+                chain_->block = nullptr;
             }
         }
 
-    };  // struct paramcb
-
-    template<class F>
-    struct paramcb<F, 3>
-    {
-        static constexpr unsigned count = 3;
-
-        BEASTHTTP_DEFINE_MEMBERS_AND_STRUCTS
-
-        void
-        operator()(request_type request, context_type context)
+        request_block&
+        enter(http::base::cb::chain& chain)
         {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
+            if (chain.owner == owner_)
+                return *static_cast<request_block*>(chain.block);
 
-            BEASTHTTP_IMPL_PARAM_PROCESS_CLASSIC
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2])
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), tuple_type{});
-            }
-            shared_block_p_->reset();
+            chain_ = &chain;
+            chain.owner = owner_;
+            chain.block = this;
+            return *this;
         }
 
-        void
-        operator()(request_type request, context_type context, iterator_type it)
+        template<class T>
+        T
+        convert(std::size_t index)
         {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
+            T value{};
+            if (index < args.size()
+                    and not converter<T>::convert(args[index], value))
+                failed_ = true;
 
-            BEASTHTTP_IMPL_PARAM_PROCESS_ADVANCED
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2])
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), std::move(it), tuple_type{});
-            }
+            return value;
         }
 
-    }; // struct paramcb
+    }; // struct request_block
 
-    template<class F>
-    struct paramcb<F, 4>
-    {
-        static constexpr unsigned count = 4;
+    using request_block_type = request_block;
 
-        BEASTHTTP_DEFINE_MEMBERS_AND_STRUCTS
+    using shared_block_type = shared_block;
 
-        void
-        operator()(request_type request, context_type context)
-        {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_CLASSIC
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3])
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), tuple_type{});
-            }
-            shared_block_p_->reset();
-        }
+    using shared_block_ptr = std::shared_ptr<shared_block_type>;
 
-        void
-        operator()(request_type request, context_type context, iterator_type it)
-        {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_ADVANCED
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3])
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), std::move(it), tuple_type{});
-            }
-        }
+    shared_block_ptr shared_block_p_;
 
-    }; // struct paramcb
+    base(const shared_block_ptr& shared_block_p)
+        : shared_block_p_{shared_block_p}
+    {
+    }
 
-    template<class F>
-    struct paramcb<F, 5>
+    void
+    split_regex(resource_regex_type path_to_resource)
     {
-        static constexpr unsigned count = 5;
+        if (path_to_resource.empty())
+            return;
 
-        BEASTHTTP_DEFINE_MEMBERS_AND_STRUCTS
+        shared_block_type& block = *shared_block_p_;
 
-        void
-        operator()(request_type request, context_type context)
-        {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_CLASSIC
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4])
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), tuple_type{});
-            }
-            shared_block_p_->reset();
-        }
+        block.regex_pack.clear();
+        block.segment_pack.clear();
+        block.segmented_ = http::base::segment_pattern{}.assign(path_to_resource);
 
-        void
-        operator()(request_type request, context_type context, iterator_type it)
-        {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_ADVANCED
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4])
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
+        const auto add = [&block](const std::string& token){
+            if (block.segmented_) {
+                block.segment_pack.emplace_back();
+                block.segment_pack.back().assign(token);
             }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
+            else
+                block.regex_pack.push_back(block.regex_.compile(token));
+        };
+
+        add(path_to_resource);
+        constexpr char delim = '/';
+        size_t pos = 0;
+        std::string token;
+        while(true) {
+            pos = path_to_resource.find(delim);
+            if (pos == 0)
+                pos = path_to_resource.find(delim, pos + 1);
+            if (pos != std::string::npos) {
+                token = path_to_resource.substr(0, pos);
+                add(token);
+                path_to_resource.erase(0, pos);
             }
             else {
-                f_(std::move(request), std::move(context), std::move(it), tuple_type{});
+                token = path_to_resource;
+                add(token);
+                break;
             }
         }
-
-    }; // struct paramcb
+    }
 
     template<class F>
-    struct paramcb<F, 6>
+    struct paramcb
     {
-        static constexpr unsigned count = 6;
+        static constexpr std::size_t count = pack_type::count;
 
-        BEASTHTTP_DEFINE_MEMBERS_AND_STRUCTS
+        static_assert (count != 0, "Incorrect value, pack is empty!");
 
-        void
-        operator()(request_type request, context_type context)
-        {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_CLASSIC
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5])
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                            typename pack_type::template get_<5>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 5) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), tuple_type{});
-            }
-            shared_block_p_->reset();
-        }
+        shared_block_ptr shared_block_p_;
+        F f_;
 
-        void
-        operator()(request_type request, context_type context, iterator_type it)
+        explicit
+        paramcb(const shared_block_ptr& shared_block_p, const F& f)
+            : shared_block_p_{shared_block_p},
+              f_{f}
         {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_ADVANCED
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5])
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                            typename pack_type::template get_<5>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 5) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), std::move(it), tuple_type{});
-            }
         }
 
-    }; // struct paramcb
-
-    template<class F>
-    struct paramcb<F, 7>
-    {
-        static constexpr unsigned count = 7;
-
-        BEASTHTTP_DEFINE_MEMBERS_AND_STRUCTS
-
-        void
-        operator()(request_type request, context_type context)
+        explicit
+        paramcb(const shared_block_ptr& shared_block_p, F&& f)
+            : shared_block_p_{shared_block_p},
+              f_{std::move(f)}
         {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_CLASSIC
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6])
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                            typename pack_type::template get_<6>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 5) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 6) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), tuple_type{});
-            }
-            shared_block_p_->reset();
         }
 
+        // The only handler of the route
         void
-        operator()(request_type request, context_type context, iterator_type it)
+        operator()(request_type& request, context_type context)
         {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_ADVANCED
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6])
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                            typename pack_type::template get_<6>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 5) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 6) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), std::move(it), tuple_type{});
-            }
-        }
-
-    }; // struct paramcb
-
-    template<class F>
-    struct paramcb<F, 8>
-    {
-        static constexpr unsigned count = 8;
+            request_block_type block{*shared_block_p_};
 
-        BEASTHTTP_DEFINE_MEMBERS_AND_STRUCTS
-
-        void
-        operator()(request_type request, context_type context)
-        {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_CLASSIC
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7])
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                            typename pack_type::template get_<7>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 5) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 6) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 7) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), tuple_type{});
-            }
-            shared_block_p_->reset();
+            finish(block, request, request.target(), std::move(context));
         }
 
+        // The last handler of a chain
         void
-        operator()(request_type request, context_type context, iterator_type it)
+        operator()(request_type& request, context_type context,
+                   iterator_type const& it, http::base::cb::last_hop)
         {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_ADVANCED
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7])
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                            typename pack_type::template get_<7>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 5) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 6) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 7) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), std::move(it), tuple_type{});
-            }
-        }
+            request_block_type local_block{*shared_block_p_};
+            request_block_type& block = local_block.enter(it.chain());
 
-    }; // struct paramcb
-
-    template<class F>
-    struct paramcb<F, 9>
-    {
-        static constexpr unsigned count = 9;
-
-        BEASTHTTP_DEFINE_MEMBERS_AND_STRUCTS
-
-        void
-        operator()(request_type request, context_type context)
-        {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_CLASSIC
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8])
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
+            if (block.rp_pos_ != 0) {
+                block.rp_pos_ = shared_block_p_->size() - 1;
+                block.cur_pos_cb_ = shared_block_p_->size() - 1;
             }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 5) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 6) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 7) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 8) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), tuple_type{});
-            }
-            shared_block_p_->reset();
+
+            finish(block, request, it.target(), std::move(context));
         }
 
         void
-        operator()(request_type request, context_type context, iterator_type it)
+        operator()(request_type& request, context_type context, iterator_type it)
         {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_ADVANCED
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8])
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 5) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 6) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 7) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 8) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), std::move(it), tuple_type{});
+            request_block_type local_block{*shared_block_p_};
+            request_block_type& block = local_block.enter(it.chain());
+
+            for (std::size_t i = block.cur_pos_cb_; i < it.pos(); i++) {
+                if (block.rp_pos_ + 1 < shared_block_p_->size())
+                    block.rp_pos_++;
+                block.cur_pos_cb_++;
             }
-        }
 
-    }; // struct paramcb
+            if (block.rp_pos_ == 0)
+                block.rp_pos_++;
 
-    template<class F>
-    struct paramcb<F, 10>
-    {
-        static constexpr unsigned count = 10;
+            match(block, it.target());
 
-        BEASTHTTP_DEFINE_MEMBERS_AND_STRUCTS
+            tuple_type args = make_args(block, http::base::traits::MakeIndexSequence<count>{});
 
-        void
-        operator()(request_type request, context_type context)
-        {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_CLASSIC
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                    boost::lexical_cast<typename pack_type::template get_<9>::type>(shared_block_p_->str_args[9])
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 5) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 6) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 7) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 8) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 9) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), tuple_type{});
-            }
-            shared_block_p_->reset();
+            if (block.failed_)
+                shared_block_p_->bad_request(request, std::move(context));
+            else
+                f_(request, std::move(context), std::move(it), std::move(args));
         }
 
+    private:
+
         void
-        operator()(request_type request, context_type context, iterator_type it)
+        finish(request_block_type& block, request_type& request,
+               boost::beast::string_view target, context_type context)
         {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_ADVANCED
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                    boost::lexical_cast<typename pack_type::template get_<9>::type>(shared_block_p_->str_args[9])
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 5) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 6) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 7) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 8) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 9) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), std::move(it), tuple_type{});
-            }
-        }
+            match(block, target);
 
-    }; // struct paramcb
+            tuple_type args = make_args(block, http::base::traits::MakeIndexSequence<count>{});
 
-    template<class F>
-    struct paramcb<F, 11>
-    {
-        static constexpr unsigned count = 11;
-
-        BEASTHTTP_DEFINE_MEMBERS_AND_STRUCTS
-
-        void
-        operator()(request_type request, context_type context)
-        {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_CLASSIC
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                    boost::lexical_cast<typename pack_type::template get_<9>::type>(shared_block_p_->str_args[9]),
-                    boost::lexical_cast<typename pack_type::template get_<10>::type>(shared_block_p_->str_args[10])
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                    boost::lexical_cast<typename pack_type::template get_<9>::type>(shared_block_p_->str_args[9]),
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 5) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 6) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 7) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 8) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 9) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 10) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), tuple_type{});
-            }
-            shared_block_p_->reset();
+            // A capture that does not convert ends the chain in the bad request handler
+            if (block.failed_)
+                shared_block_p_->bad_request(request, std::move(context));
+            else
+                f_(request, std::move(context), std::move(args));
         }
 
         void
-        operator()(request_type request, context_type context, iterator_type it)
+        match(request_block_type& block, boost::beast::string_view target) const
         {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_ADVANCED
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                    boost::lexical_cast<typename pack_type::template get_<9>::type>(shared_block_p_->str_args[9]),
-                    boost::lexical_cast<typename pack_type::template get_<10>::type>(shared_block_p_->str_args[10])
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                    boost::lexical_cast<typename pack_type::template get_<9>::type>(shared_block_p_->str_args[9]),
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 5) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 6) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 7) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 8) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 9) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 10) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), std::move(it), tuple_type{});
-            }
-        }
+            const shared_block_type& shared = *shared_block_p_;
 
-    }; // struct paramcb
+            if (block.rp_pos_ >= shared.size())
+                return;
 
-    template<class F>
-    struct paramcb<F, 12>
-    {
-        static constexpr unsigned count = 11;
-
-        BEASTHTTP_DEFINE_MEMBERS_AND_STRUCTS
+            if (shared.segmented_) {
+                shared.segment_pack[block.rp_pos_].match(target,
+                                                         [&block](boost::beast::string_view value){
+                    block.args.push_back(value);
+                });
 
-        void
-        operator()(request_type request, context_type context)
-        {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_CLASSIC
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                    boost::lexical_cast<typename pack_type::template get_<9>::type>(shared_block_p_->str_args[9]),
-                    boost::lexical_cast<typename pack_type::template get_<10>::type>(shared_block_p_->str_args[10]),
-                    boost::lexical_cast<typename pack_type::template get_<11>::type>(shared_block_p_->str_args[11])
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                    boost::lexical_cast<typename pack_type::template get_<9>::type>(shared_block_p_->str_args[9]),
-                    boost::lexical_cast<typename pack_type::template get_<10>::type>(shared_block_p_->str_args[10]),
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                    boost::lexical_cast<typename pack_type::template get_<9>::type>(shared_block_p_->str_args[9]),
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 5) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 6) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
+                return;
             }
-            else if (shared_block_p_->str_args.size() == count - 7) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 8) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 9) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 10) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 11) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), tuple_type{});
-            }
-            shared_block_p_->reset();
+
+            std::cmatch what;
+            if (shared.regex_.match(shared.regex_pack[block.rp_pos_], target, what))
+                for (std::size_t i = 1; i < what.size(); i++)
+                    block.args.emplace_back(what[int(i)].first,
+                                                std::size_t(what[int(i)].length()));
         }
 
-        void
-        operator()(request_type request, context_type context, iterator_type it)
+        // Captures missing from the target leave their values default constructed
+        template<std::size_t... Indexes>
+        static tuple_type
+        make_args(request_block_type& block, http::base::traits::IndexSequence<Indexes...>)
         {
-            std::lock_guard<std::recursive_mutex> _lock(shared_block_p_->mutex_);
-
-            BEASTHTTP_IMPL_PARAM_PROCESS_ADVANCED
-
-            if (shared_block_p_->str_args.size() >= count) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                    boost::lexical_cast<typename pack_type::template get_<9>::type>(shared_block_p_->str_args[9]),
-                    boost::lexical_cast<typename pack_type::template get_<10>::type>(shared_block_p_->str_args[10]),
-                    boost::lexical_cast<typename pack_type::template get_<11>::type>(shared_block_p_->str_args[11])
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 1) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                    boost::lexical_cast<typename pack_type::template get_<9>::type>(shared_block_p_->str_args[9]),
-                    boost::lexical_cast<typename pack_type::template get_<10>::type>(shared_block_p_->str_args[10]),
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 2) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                    boost::lexical_cast<typename pack_type::template get_<9>::type>(shared_block_p_->str_args[9]),
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 3) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                    boost::lexical_cast<typename pack_type::template get_<8>::type>(shared_block_p_->str_args[8]),
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 4) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                    boost::lexical_cast<typename pack_type::template get_<7>::type>(shared_block_p_->str_args[7]),
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 5) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                    boost::lexical_cast<typename pack_type::template get_<6>::type>(shared_block_p_->str_args[6]),
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 6) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                    boost::lexical_cast<typename pack_type::template get_<5>::type>(shared_block_p_->str_args[5]),
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 7) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                    boost::lexical_cast<typename pack_type::template get_<4>::type>(shared_block_p_->str_args[4]),
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 8) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                    boost::lexical_cast<typename pack_type::template get_<3>::type>(shared_block_p_->str_args[3]),
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 9) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                    boost::lexical_cast<typename pack_type::template get_<2>::type>(shared_block_p_->str_args[2]),
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 10) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                    boost::lexical_cast<typename pack_type::template get_<1>::type>(shared_block_p_->str_args[1]),
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else if (shared_block_p_->str_args.size() == count - 11) {
-                tuple_type args{
-                    boost::lexical_cast<typename pack_type::template get_<0>::type>(shared_block_p_->str_args[0]),
-                            typename pack_type::template get_<1>::type{},
-                            typename pack_type::template get_<2>::type{},
-                            typename pack_type::template get_<3>::type{},
-                            typename pack_type::template get_<4>::type{},
-                            typename pack_type::template get_<5>::type{},
-                            typename pack_type::template get_<6>::type{},
-                            typename pack_type::template get_<7>::type{},
-                            typename pack_type::template get_<8>::type{},
-                            typename pack_type::template get_<9>::type{},
-                            typename pack_type::template get_<10>::type{},
-                            typename pack_type::template get_<11>::type{}
-                };
-                f_(std::move(request), std::move(context), std::move(it), std::move(args));
-            }
-            else {
-                f_(std::move(request), std::move(context), std::move(it), tuple_type{});
-            }
+            return tuple_type{
+                block.template convert<typename std::tuple_element<Indexes, tuple_type>::type>(Indexes)...
+            };
         }
 
     }; // struct paramcb
 
-    template<class F, unsigned Count>
-    using paramcb_type = paramcb<F, Count>;
+    template<class F>
+    using paramcb_type = paramcb<F>;
 
 }; // class base
 
@@ -2747,16 +650,29 @@ public:
     {
     }
 
+    /// Replaces the 400 answered when a capture does not convert
+    template<class OnBadRequest>
+    self_type&&
+    on_bad_request(OnBadRequest&& on_bad_request) &&
+    {
+        static_assert (http::base::traits::TryInvoke<OnBadRequest,
+                       void (request_type&, context_type)>::value,
+                       "Invalid OnBadRequest handler type!");
+
+        base_type::shared_block_p_->on_bad_request_ = std::forward<OnBadRequest>(on_bad_request);
+        return std::move(*this);
+    }
+
     template<class... OnRequest>
     auto
     get(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.get(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2764,12 +680,12 @@ public:
     auto
     post(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.post(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2777,12 +693,12 @@ public:
     auto
     put(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.put(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2790,12 +706,12 @@ public:
     auto
     head(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.head(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2803,12 +719,12 @@ public:
     auto
     delete_(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.delete_(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2816,12 +732,12 @@ public:
     auto
     options(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.options(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2829,12 +745,12 @@ public:
     auto
     connect(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.connect(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2842,12 +758,12 @@ public:
     auto
     trace(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.trace(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2855,12 +771,12 @@ public:
     auto
     copy(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.copy(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2868,12 +784,12 @@ public:
     auto
     lock(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.lock(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2881,12 +797,12 @@ public:
     auto
     mkcol(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.mkcol(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2894,12 +810,12 @@ public:
     auto
     move(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.move(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2907,12 +823,12 @@ public:
     auto
     propfind(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.propfind(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2920,12 +836,12 @@ public:
     auto
     proppatch(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.proppatch(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2933,12 +849,12 @@ public:
     auto
     search(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.search(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2946,12 +862,12 @@ public:
     auto
     unlock(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.unlock(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2959,12 +875,12 @@ public:
     auto
     bind(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.bind(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2972,12 +888,12 @@ public:
     auto
     rebind(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.rebind(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2985,12 +901,12 @@ public:
     auto
     unbind(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.unbind(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -2998,12 +914,12 @@ public:
     auto
     acl(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.acl(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3011,12 +927,12 @@ public:
     auto
     report(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.report(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3024,12 +940,12 @@ public:
     auto
     mkactivity(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.mkactivity(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3037,12 +953,12 @@ public:
     auto
     checkout(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.checkout(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3050,12 +966,12 @@ public:
     auto
     merge(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.merge(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3063,12 +979,12 @@ public:
     auto
     msearch(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.msearch(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3076,12 +992,12 @@ public:
     auto
     notify(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.notify(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3089,12 +1005,12 @@ public:
     auto
     subscribe(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.subscribe(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3102,12 +1018,12 @@ public:
     auto
     unsubscribe(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.unsubscribe(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3115,12 +1031,12 @@ public:
     auto
     patch(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.patch(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3128,12 +1044,12 @@ public:
     auto
     purge(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.purge(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3141,12 +1057,12 @@ public:
     auto
     mkcalendar(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.mkcalendar(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3154,12 +1070,12 @@ public:
     auto
     link(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.link(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3167,12 +1083,12 @@ public:
     auto
     unlink(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.unlink(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3180,12 +1096,12 @@ public:
     auto
     all(const resource_regex_type& path_to_resource, OnRequest&&... on_request) &&
     -> decltype (void(typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                      sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                 void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}))
+                      sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                 void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}))
     {
         base_type::split_regex(path_to_resource);
         base_type::shared_block_p_->router_.all(
-                    path_to_resource, typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+                    path_to_resource, typename base_type::template paramcb_type<OnRequest>
                               {base_type::shared_block_p_, std::forward<OnRequest>(on_request)}...);
     }
 
@@ -3233,10 +1149,10 @@ public:
         auto
         get(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::get(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::get(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3245,10 +1161,10 @@ public:
         auto
         post(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::post(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::post(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3257,10 +1173,10 @@ public:
         auto
         put(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::put(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::put(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3269,10 +1185,10 @@ public:
         auto
         head(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::head(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::head(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3281,10 +1197,10 @@ public:
         auto
         delete_(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::delete_(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::delete_(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3293,10 +1209,10 @@ public:
         auto
         options(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::options(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::options(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3305,10 +1221,10 @@ public:
         auto
         connect(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::connect(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::connect(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3317,10 +1233,10 @@ public:
         auto
         trace(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::trace(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::trace(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3329,10 +1245,10 @@ public:
         auto
         copy(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::copy(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::copy(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3341,10 +1257,10 @@ public:
         auto
         lock(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::lock(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::lock(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3353,10 +1269,10 @@ public:
         auto
         mkcol(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::mkcol(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::mkcol(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3365,10 +1281,10 @@ public:
         auto
         move(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::move(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::move(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3377,10 +1293,10 @@ public:
         auto
         propfind(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::propfind(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::propfind(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3389,10 +1305,10 @@ public:
         auto
         proppatch(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::proppatch(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::proppatch(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3401,10 +1317,10 @@ public:
         auto
         search(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::search(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::search(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3413,10 +1329,10 @@ public:
         auto
         unlock(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::unlock(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::unlock(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3425,10 +1341,10 @@ public:
         auto
         bind(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::bind(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::bind(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3437,10 +1353,10 @@ public:
         auto
         rebind(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::rebind(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::rebind(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3449,10 +1365,10 @@ public:
         auto
         unbind(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::unbind(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::unbind(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3461,10 +1377,10 @@ public:
         auto
         acl(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::acl(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::acl(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3473,10 +1389,10 @@ public:
         auto
         report(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::report(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::report(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3485,10 +1401,10 @@ public:
         auto
         mkactivity(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::mkactivity(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::mkactivity(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3497,10 +1413,10 @@ public:
         auto
         checkout(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::checkout(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::checkout(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3509,10 +1425,10 @@ public:
         auto
         merge(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::merge(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::merge(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3521,10 +1437,10 @@ public:
         auto
         msearch(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::msearch(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::msearch(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3533,10 +1449,10 @@ public:
         auto
         notify(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::notify(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::notify(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3545,10 +1461,10 @@ public:
         auto
         subscribe(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::subscribe(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::subscribe(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3557,10 +1473,10 @@ public:
         auto
         unsubscribe(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::unsubscribe(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::unsubscribe(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3569,10 +1485,10 @@ public:
         auto
         patch(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::patch(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::patch(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3581,10 +1497,10 @@ public:
         auto
         purge(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::purge(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::purge(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3593,10 +1509,10 @@ public:
         auto
         mkcalendar(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::mkcalendar(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::mkcalendar(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3605,10 +1521,10 @@ public:
         auto
         link(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::link(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::link(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3617,10 +1533,10 @@ public:
         auto
         unlink(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::unlink(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::unlink(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3629,10 +1545,10 @@ public:
         auto
         all(OnRequest&&... on_request)
         -> decltype (typename std::enable_if<http::base::traits::TryInvokeConjunction<
-                          sizeof... (OnRequest) - 1, void (request_type, context_type, iterator_type, tuple_type),
-                     void (request_type, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
+                          sizeof... (OnRequest) - 1, void (request_type&, context_type, iterator_type, tuple_type),
+                     void (request_type&, context_type, tuple_type), OnRequest...>::value, int>::type{}, std::declval<node&>())
         {
-            chain_node_type::all(typename base_type::template paramcb_type<OnRequest, sizeof... (Types)>
+            chain_node_type::all(typename base_type::template paramcb_type<OnRequest>
                                     {shared_block_p_, std::forward<OnRequest>(on_request)}...);
             return *this;
         }
@@ -3649,6 +1565,19 @@ public:
     {
     }
 
+    /// Replaces the 400 answered when a capture does not convert
+    template<class OnBadRequest>
+    self_type&&
+    on_bad_request(OnBadRequest&& on_bad_request) &&
+    {
+        static_assert (http::base::traits::TryInvoke<OnBadRequest,
+                       void (request_type&, context_type)>::value,
+                       "Invalid OnBadRequest handler type!");
+
+        base_type::shared_block_p_->on_bad_request_ = std::forward<OnBadRequest>(on_bad_request);
+        return std::move(*this);
+    }
+
     node
     route(const resource_regex_type& path_to_resource) &&
     {
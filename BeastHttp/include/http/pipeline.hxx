@@ -0,0 +1,167 @@
+#ifndef BEASTHTTP_PIPELINE_HXX
+#define BEASTHTTP_PIPELINE_HXX
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace _0xdead4ead {
+namespace http {
+
+/**
+  @brief Statically typed handler chain
+
+  Registered as a single handler, for example
+
+      router.get("/x", http::make_pipeline(auth, log, handler));
+
+  Every stage but the last is called as f(request, context, next), the
+  last one as f(request, context). `next` keeps the iterator style of
+  cb::const_iterator, so `std::next(next)()` moves on to the following
+  stage, but it is a compile-time continuation: the stage it calls is
+  part of its type and the whole chain can be inlined into one call.
+
+  Unlike a runtime chain, the stages of a pipeline all see the full
+  request target.
+*/
+template<class... Fs>
+class pipeline
+{
+    using self_type = pipeline;
+
+    using tuple_type = std::tuple<Fs...>;
+
+public:
+
+    static constexpr std::size_t size = sizeof... (Fs);
+
+    static_assert (size != 0, "Pipeline is empty!");
+
+    template<class Request, class Context, std::size_t Index>
+    class continuation
+    {
+        using self_type = continuation;
+
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+
+        using value_type = continuation;
+
+        using difference_type = std::ptrdiff_t;
+
+        using pointer = continuation*;
+
+        using reference = continuation&;
+
+        continuation(pipeline& owner, Request& request, Context& context)
+            : owner_{owner},
+              request_{request},
+              context_{context},
+              offset_{0}
+        {
+        }
+
+        self_type&
+        operator++()
+        {
+            ++offset_;
+            return *this;
+        }
+
+        self_type
+        operator++(int)
+        {
+            self_type temp = *this;
+            ++offset_;
+            return temp;
+        }
+
+        void
+        operator()() const
+        {
+            call<Index>(offset_);
+        }
+
+        std::size_t
+        pos() const
+        {
+            return Index + offset_;
+        }
+
+    private:
+
+        template<std::size_t Stage>
+        typename std::enable_if<(Stage < size)>::type
+        call(std::size_t offset) const
+        {
+            if (offset == 0)
+                owner_.template invoke<Stage>(request_, context_);
+            else
+                call<Stage + 1>(offset - 1);
+        }
+
+        template<std::size_t Stage>
+        typename std::enable_if<(Stage >= size)>::type
+        call(std::size_t) const
+        {
+        }
+
+        pipeline& owner_;
+        Request& request_;
+        Context& context_;
+        std::size_t offset_;
+
+    }; // class continuation
+
+    explicit
+    pipeline(Fs... fs)
+        : stages_{std::move(fs)...}
+    {
+    }
+
+    template<class Request, class Context>
+    void
+    operator()(Request& request, Context context)
+    {
+        invoke<0>(request, context);
+    }
+
+private:
+
+    template<std::size_t Stage, class Request, class Context>
+    typename std::enable_if<(Stage + 1 < size)>::type
+    invoke(Request& request, Context& context)
+    {
+        std::get<Stage>(stages_)(request, Context(context),
+                                 continuation<Request, Context, Stage>{
+                                     *this, request, context});
+    }
+
+    template<std::size_t Stage, class Request, class Context>
+    typename std::enable_if<(Stage + 1 == size)>::type
+    invoke(Request& request, Context& context)
+    {
+        std::get<Stage>(stages_)(request, Context(context));
+    }
+
+    tuple_type stages_;
+
+}; // class pipeline
+
+template<class... Fs>
+constexpr std::size_t pipeline<Fs...>::size;
+
+template<class... Fs>
+pipeline<typename std::decay<Fs>::type...>
+make_pipeline(Fs&&... fs)
+{
+    return pipeline<typename std::decay<Fs>::type...>{std::forward<Fs>(fs)...};
+}
+
+} // namespace http
+} // namespace _0xdead4ead
+
+#endif // not defined BEASTHTTP_PIPELINE_HXX
@@ -18,10 +18,12 @@
              template<typename, typename, typename...> class ResourceMap, \
              template<typename> class OnError, \
              template<typename> class OnTimer, \
-             template<typename> class OnHandshake>
+             template<typename> class OnHandshake, \
+             class Regex, \
+             std::size_t QueueDepth>
 
 #define BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES \
-    Body, RequestParser, ResponseSerializer, Buffer, Protocol, Socket, Clock, Timer, Entry, Container, MethodMap, ResourceMap, OnError, OnTimer, OnHandshake
+    Body, RequestParser, ResponseSerializer, Buffer, Protocol, Socket, Clock, Timer, Entry, Container, MethodMap, ResourceMap, OnError, OnTimer, OnHandshake, Regex, QueueDepth
 
 namespace _0xdead4ead {
 namespace http {
@@ -154,6 +156,16 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::push(
     return *this;
 }
 
+BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
+typename session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh&
+session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::push(
+        shared_message const& message)
+{
+    do_push(message);
+
+    return *this;
+}
+
 BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
 typename session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh&
 session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::wait()
@@ -274,6 +286,18 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::member(
     on_timer_ = on_timer_type(std::move(handler));
 }
 
+BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
+template<class Handler>
+void
+session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::member(
+        typename option::on_backpressure_t, Handler& handler,
+        typename std::enable_if<
+        base::traits::TryInvoke<Handler,
+        void(context_type, std::size_t)>::value, int>::type)
+{
+    on_backpressure_ = on_backpressure_type(std::move(handler));
+}
+
 BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
 template<class Handler, class Allocator>
 void
@@ -325,14 +349,15 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::flesh(
         std::shared_ptr<method_map_type> const& method_map,
         regex_flag_type flags,
         mutex_type* mutex,
+        std::shared_ptr<snapshot_type const> const& snapshot,
         buffer_type&& buffer)
     : base::strand_stream{socket.get_executor()},
-      base_type{resource_map, method_map, flags},
+      base_type{resource_map, method_map, flags, snapshot},
       router_mutex_{mutex},
       timer_{static_cast<base::strand_stream&>(*this), (time_point_type::max)()},
       connection_{std::move(socket), ctx, static_cast<base::strand_stream&>(*this)},
       buffer_{std::move(buffer)},
-      queue_{*this}
+      queue_{*this, coalesce_limit().load(std::memory_order_relaxed)}
 {
 }
 
@@ -344,14 +369,15 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::flesh(
         std::shared_ptr<method_map_type> const& method_map,
         regex_flag_type flags,
         mutex_type* mutex,
+        std::shared_ptr<snapshot_type const> const& snapshot,
         buffer_type&& buffer)
     : base::strand_stream{socket.get_executor()},
-      base_type{resource_map, method_map, flags},
+      base_type{resource_map, method_map, flags, snapshot},
       router_mutex_{mutex},
       timer_{static_cast<base::strand_stream&>(*this), (time_point_type::max)()},
       connection_{std::move(socket), ctx, static_cast<base::strand_stream&>(*this)},
       buffer_{std::move(buffer)},
-      queue_{*this}
+      queue_{*this, coalesce_limit().load(std::memory_order_relaxed)}
 {
 }
 
@@ -364,19 +390,20 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::flesh(
         std::shared_ptr<method_map_type> const& method_map,
         regex_flag_type flags,
         mutex_type* mutex,
+        std::shared_ptr<snapshot_type const> const& snapshot,
         buffer_type&& buffer,
         _OnHandshake&& on_handshake,
         typename std::enable_if<
         base::traits::TryInvoke<_OnHandshake,
         void(context_type)>::value, int>::type)
     : base::strand_stream{socket.get_executor()},
-      base_type{resource_map, method_map, flags},
+      base_type{resource_map, method_map, flags, snapshot},
       router_mutex_{mutex},
       timer_{static_cast<base::strand_stream&>(*this), (time_point_type::max)()},
       connection_{std::move(socket), ctx, static_cast<base::strand_stream&>(*this)},
       on_handshake_{std::forward<_OnHandshake>(on_handshake)},
       buffer_{std::move(buffer)},
-      queue_{*this}
+      queue_{*this, coalesce_limit().load(std::memory_order_relaxed)}
 {
 }
 
@@ -389,6 +416,7 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::flesh(
         std::shared_ptr<method_map_type> const& method_map,
         regex_flag_type flags,
         mutex_type* mutex,
+        std::shared_ptr<snapshot_type const> const& snapshot,
         buffer_type&& buffer,
         _OnError&& on_error,
         typename std::enable_if<
@@ -396,13 +424,13 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::flesh(
         void(boost::system::error_code,
              boost::string_view)>::value, int>::type)
     : base::strand_stream{socket.get_executor()},
-      base_type{resource_map, method_map, flags},
+      base_type{resource_map, method_map, flags, snapshot},
       router_mutex_{mutex},
       timer_{static_cast<base::strand_stream&>(*this), (time_point_type::max)()},
       connection_{std::move(socket), ctx, static_cast<base::strand_stream&>(*this)},
       on_error_{std::forward<_OnError>(on_error)},
       buffer_{std::move(buffer)},
-      queue_{*this}
+      queue_{*this, coalesce_limit().load(std::memory_order_relaxed)}
 {
 }
 
@@ -415,6 +443,7 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::flesh(
         std::shared_ptr<method_map_type> const& method_map,
         regex_flag_type flags,
         mutex_type* mutex,
+        std::shared_ptr<snapshot_type const> const& snapshot,
         buffer_type&& buffer,
         _OnHandshake&& on_handshake,
         _OnError&& on_error,
@@ -425,14 +454,14 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::flesh(
         void(boost::system::error_code,
              boost::string_view)>::value, int>::type)
     : base::strand_stream{socket.get_executor()},
-      base_type{resource_map, method_map, flags},
+      base_type{resource_map, method_map, flags, snapshot},
       router_mutex_{mutex},
       timer_{static_cast<base::strand_stream&>(*this), (time_point_type::max)()},
       connection_{std::move(socket), ctx, static_cast<base::strand_stream&>(*this)},
       on_handshake_{std::forward<_OnHandshake>(on_handshake)},
       on_error_{std::forward<_OnError>(on_error)},
       buffer_{std::move(buffer)},
-      queue_{*this}
+      queue_{*this, coalesce_limit().load(std::memory_order_relaxed)}
 {
 }
 
@@ -445,6 +474,7 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::flesh(
         std::shared_ptr<method_map_type> const& method_map,
         regex_flag_type flags,
         mutex_type* mutex,
+        std::shared_ptr<snapshot_type const> const& snapshot,
         buffer_type&& buffer,
         _OnHandshake&& on_handshake,
         _OnError&& on_error, _OnTimer&& on_timer,
@@ -457,7 +487,7 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::flesh(
         base::traits::TryInvoke<_OnTimer,
         void(context_type)>::value, int>::type)
     : base::strand_stream{socket.get_executor()},
-      base_type{resource_map, method_map, flags},
+      base_type{resource_map, method_map, flags, snapshot},
       router_mutex_{mutex},
       timer_{static_cast<base::strand_stream&>(*this), (time_point_type::max)()},
       connection_{std::move(socket), ctx, static_cast<base::strand_stream&>(*this)},
@@ -465,7 +495,7 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::flesh(
       on_error_{std::forward<_OnError>(on_error)},
       on_timer_{std::forward<_OnTimer>(on_timer)},
       buffer_{std::move(buffer)},
-      queue_{*this}
+      queue_{*this, coalesce_limit().load(std::memory_order_relaxed)}
 {
 }
 
@@ -538,6 +568,10 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::on_read(
 {
     boost::ignore_unused(bytes_transferred);
 
+    // No request follows, the responses held back for one are written
+    if (ec)
+        queue_.uncork();
+
     if (ec == boost::beast::http::error::end_of_stream) {
         do_eof();
         return;
@@ -572,10 +606,44 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::on_write(
         return;
     }
 
-    if (queue_.on_write())
+    // Pushed messages waiting go first
+    if (outbox_.pending())
+        queue_.pause();
+
+    const bool was_full = queue_.on_write();
+
+    do_flush();
+
+    if (was_full)
         recv();
 }
 
+BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
+void
+session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::on_push(
+        boost::system::error_code ec, std::size_t bytes_transferred)
+{
+    boost::ignore_unused(bytes_transferred);
+
+    outbox_.consume();
+
+    if (ec) {
+        if (on_error_)
+            on_error_(ec, "async_write/on_push");
+
+        return;
+    }
+
+    if (backpressured_ and outbox_.size() == 0) {
+        backpressured_ = false;
+        on_backpressure_(context_type{*this}, 0);
+    }
+
+    queue_.resume();
+
+    do_flush();
+}
+
 BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
 void
 session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::do_handshake()
@@ -615,21 +683,74 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::do_write(
 }
 
 BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
-template<class _Body>
+void
+session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::do_write(
+        base::write_batch& batch)
+{
+    connection_.async_write_buffers(
+                batch.buffers(),
+                std::bind(&flesh::on_write, this->shared_from_this(),
+                          std::placeholders::_1,
+                          std::placeholders::_2,
+                          batch.need_eof()));
+}
+
+BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
+template<class Message>
 void
 session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::do_push(
-        response_type<_Body>& response)
+        Message& message)
 {
-    serializer_.emplace(response);
+    // A closed session takes no more messages
+    if (not connection_.stream().is_open())
+        return;
 
-    auto ec = connection_.write(*serializer_);
+    auto& limits = push_limits();
+    const auto policy = limits.policy.load(std::memory_order_relaxed);
 
-    if (ec) {
-        if (on_error_)
-            on_error_(ec, "write/do_push");
+    boost::beast::error_code ec;
+    if (not outbox_.push(message, limits.limit.load(std::memory_order_relaxed), policy, ec)) {
+        if (ec) {
+            if (on_error_)
+                on_error_(ec, "serialize/do_push");
 
-        return;
+            return;
+        }
+
+        if (policy == push_overflow::close) {
+            if (on_error_)
+                on_error_(boost::asio::error::no_buffer_space, "limit/do_push");
+
+            do_force_cls();
+            return;
+        }
+    }
+
+    if (not backpressured_ and on_backpressure_
+            and outbox_.size() >= limits.watermark.load(std::memory_order_relaxed)) {
+        backpressured_ = true;
+        on_backpressure_(context_type{*this}, outbox_.size());
     }
+
+    do_flush();
+}
+
+BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
+void
+session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::do_flush()
+{
+    // The queued responses and the pushed messages take turns on the
+    // connection, a write of one waits for the write of the other
+    if (outbox_.writing() or not outbox_.pending() or queue_.writing())
+        return;
+
+    queue_.pause();
+
+    connection_.async_write_buffers(
+                outbox_.flush(),
+                std::bind(&flesh::on_push, this->shared_from_this(),
+                          std::placeholders::_1,
+                          std::placeholders::_2));
 }
 
 BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
@@ -706,11 +827,23 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh::do_process_reques
 {
     request_type request = parser_->release();
 
-    {
+    // While the next pipelined request is already buffered in whole, its
+    // response is coalesced with this one
+    const bool pipelined = queue_.coalescing() and base::pipelined(buffer_.data());
+
+    if (pipelined)
+        queue_.cork();
+
+    if (this->lock_free())
+        this->provide(request, *this);
+    else {
         BEASTHTTP_LOCKABLE_ENTER_TO_READ(*router_mutex_)
         this->provide(request, *this);
     }
 
+    if (not pipelined or queue_.is_full() or not connection_.stream().is_open())
+        queue_.uncork();
+
     if (not queue_.is_full() and connection_.stream().is_open())
         recv();
 }
@@ -734,20 +867,9 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::handshake(
         BEASTHTTP_REACTOR_SSL_SESSION_TRY_INVOKE_FLESH_TYPE(std::declval<Router const&>()),
         std::declval<context_type>())>::type
 {
-#if BEASTHTTP_USE_MAKE_SHARED == 0
-    using Alloc = std::allocator<flesh_type>;
-
-    Alloc a = Alloc();
-
-    std::shared_ptr<flesh_type> _this{
-        new (std::allocator_traits<Alloc>::allocate(a, 1)) flesh_type(
-                    ctx, std::move(socket), router.resource_map(), router.method_map(),
-                    router.regex_flags(), &router.mutex(), std::move(buffer), std::forward<_OnAction>(on_action)...)};
-#else
-    std::shared_ptr<flesh_type> _this = std::make_shared<flesh_type>(
+    std::shared_ptr<flesh_type> _this = create(
                 ctx, std::move(socket), router.resource_map(), router.method_map(), router.regex_flags(),
-                &router.mutex(), std::move(buffer), std::forward<_OnAction>(on_action)...);
-#endif // BEASTHTTP_USE_MAKE_SHARED == 0
+                &router.mutex(), router.snapshot(), std::move(buffer), std::forward<_OnAction>(on_action)...);
 
     boost::asio::dispatch(
                 static_cast<base::strand_stream&>(*_this), std::bind(
@@ -773,7 +895,7 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::handshake(std::allocator
     std::shared_ptr<flesh_type> _this{
         new (std::allocator_traits<Alloc>::allocate(a, 1)) flesh_type(
                     ctx, std::move(socket), router.resource_map(), router.method_map(),
-                    router.regex_flags(), &router.mutex(), std::move(buffer),
+                    router.regex_flags(), &router.mutex(), router.snapshot(), std::move(buffer),
                     std::forward<_OnAction>(on_action)...), d, alloc};
 
     boost::asio::dispatch(
@@ -795,20 +917,9 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::handshake(
 {
     buffer_type buffer;
 
-#if BEASTHTTP_USE_MAKE_SHARED == 0
-    using Alloc = std::allocator<flesh_type>;
-
-    Alloc a = Alloc();
-
-    std::shared_ptr<flesh_type> _this{
-        new (std::allocator_traits<Alloc>::allocate(a, 1)) flesh_type(
-                    ctx, std::move(socket), router.resource_map(), router.method_map(),
-                    router.regex_flags(), &router.mutex(), std::move(buffer), std::forward<_OnAction>(on_action)...)};
-#else
-    std::shared_ptr<flesh_type> _this = std::make_shared<flesh_type>(
+    std::shared_ptr<flesh_type> _this = create(
                 ctx, std::move(socket), router.resource_map(), router.method_map(), router.regex_flags(),
-                &router.mutex(), std::move(buffer), std::forward<_OnAction>(on_action)...);
-#endif // BEASTHTTP_USE_MAKE_SHARED == 0
+                &router.mutex(), router.snapshot(), std::move(buffer), std::forward<_OnAction>(on_action)...);
 
     boost::asio::dispatch(
                 static_cast<base::strand_stream&>(*_this), std::bind(
@@ -836,7 +947,7 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::handshake(std::allocator
     std::shared_ptr<flesh_type> _this{
         new (std::allocator_traits<Alloc>::allocate(a, 1)) flesh_type(
                     ctx, std::move(socket), router.resource_map(), router.method_map(),
-                    router.regex_flags(), &router.mutex(), std::move(buffer),
+                    router.regex_flags(), &router.mutex(), router.snapshot(), std::move(buffer),
                     std::forward<_OnAction>(on_action)...), d, alloc};
 
     boost::asio::dispatch(
@@ -857,20 +968,9 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::handshake(
             std::declval<Router const&>()).handshake(std::declval<TimePointOrDuration>()),
         std::declval<context_type>())>::type
 {
-#if BEASTHTTP_USE_MAKE_SHARED == 0
-    using Alloc = std::allocator<flesh_type>;
-
-    Alloc a = Alloc();
-
-    std::shared_ptr<flesh_type> _this{
-        new (std::allocator_traits<Alloc>::allocate(a, 1)) flesh_type(
-                    ctx, std::move(socket), router.resource_map(), router.method_map(),
-                    router.regex_flags(), &router.mutex(), std::move(buffer), std::forward<_OnAction>(on_action)...)};
-#else
-    std::shared_ptr<flesh_type> _this = std::make_shared<flesh_type>(
+    std::shared_ptr<flesh_type> _this = create(
                 ctx, std::move(socket), router.resource_map(), router.method_map(), router.regex_flags(),
-                &router.mutex(), std::move(buffer), std::forward<_OnAction>(on_action)...);
-#endif // BEASTHTTP_USE_MAKE_SHARED == 0
+                &router.mutex(), router.snapshot(), std::move(buffer), std::forward<_OnAction>(on_action)...);
 
     boost::asio::dispatch(
                 static_cast<base::strand_stream&>(*_this), std::bind(
@@ -898,7 +998,7 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::handshake(std::allocator
     std::shared_ptr<flesh_type> _this{
         new (std::allocator_traits<Alloc>::allocate(a, 1)) flesh_type(
                     ctx, std::move(socket), router.resource_map(), router.method_map(),
-                    router.regex_flags(), &router.mutex(), std::move(buffer),
+                    router.regex_flags(), &router.mutex(), router.snapshot(), std::move(buffer),
                     std::forward<_OnAction>(on_action)...), d, alloc};
 
     boost::asio::dispatch(
@@ -921,20 +1021,9 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::handshake(
 {
     buffer_type buffer;
 
-#if BEASTHTTP_USE_MAKE_SHARED == 0
-    using Alloc = std::allocator<flesh_type>;
-
-    Alloc a = Alloc();
-
-    std::shared_ptr<flesh_type> _this{
-        new (std::allocator_traits<Alloc>::allocate(a, 1)) flesh_type(
-                    ctx, std::move(socket), router.resource_map(), router.method_map(),
-                    router.regex_flags(), &router.mutex(), std::move(buffer), std::forward<_OnAction>(on_action)...)};
-#else
-    std::shared_ptr<flesh_type> _this = std::make_shared<flesh_type>(
+    std::shared_ptr<flesh_type> _this = create(
                 ctx, std::move(socket), router.resource_map(), router.method_map(), router.regex_flags(),
-                &router.mutex(), std::move(buffer), std::forward<_OnAction>(on_action)...);
-#endif // BEASTHTTP_USE_MAKE_SHARED == 0
+                &router.mutex(), router.snapshot(), std::move(buffer), std::forward<_OnAction>(on_action)...);
 
     boost::asio::dispatch(
                 static_cast<base::strand_stream&>(*_this), std::bind(
@@ -963,7 +1052,7 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::handshake(std::allocator
     std::shared_ptr<flesh_type> _this{
         new (std::allocator_traits<Alloc>::allocate(a, 1)) flesh_type(
                     ctx, std::move(socket), router.resource_map(), router.method_map(),
-                    router.regex_flags(), &router.mutex(), std::move(buffer),
+                    router.regex_flags(), &router.mutex(), router.snapshot(), std::move(buffer),
                     std::forward<_OnAction>(on_action)...), d, alloc};
 
     boost::asio::dispatch(
@@ -983,7 +1072,7 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::force_eof(
         BEASTHTTP_REACTOR_SSL_SESSION_TRY_INVOKE_FLESH_TYPE_LEGACY()))
 {
     buffer_type buffer;
-    return flesh_type(0, ctx, std::move(socket), {}, {}, {}, {}, std::move(buffer),
+    return flesh_type(0, ctx, std::move(socket), {}, {}, {}, {}, {}, std::move(buffer),
                       std::forward<_OnError>(on_error)).force_eof();
 }
 
@@ -996,10 +1085,88 @@ session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::force_cls(
         BEASTHTTP_REACTOR_SSL_SESSION_TRY_INVOKE_FLESH_TYPE_LEGACY()))
 {
     buffer_type buffer;
-    return flesh_type(0, ctx, std::move(socket), {}, {}, {}, {}, std::move(buffer),
+    return flesh_type(0, ctx, std::move(socket), {}, {}, {}, {}, {}, std::move(buffer),
                       std::forward<_OnError>(on_error)).force_cls();
 }
 
+BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
+void
+session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::enable_pool(std::size_t capacity)
+{
+    pool_capacity().store(capacity, std::memory_order_relaxed);
+}
+
+BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
+void
+session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::limit_push(std::size_t watermark, std::size_t limit, push_overflow policy)
+{
+    auto& limits = push_limits();
+    limits.watermark.store(watermark, std::memory_order_relaxed);
+    limits.limit.store(limit, std::memory_order_relaxed);
+    limits.policy.store(policy, std::memory_order_relaxed);
+}
+
+BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
+void
+session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::enable_coalescing(std::size_t limit)
+{
+    coalesce_limit().store(limit, std::memory_order_relaxed);
+}
+
+BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
+typename session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::pool_type const&
+session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::pool()
+{
+    return pool_type::local();
+}
+
+BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
+template<class... Args>
+std::shared_ptr<typename session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::flesh_type>
+session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::create(Args&&... args)
+{
+    const std::size_t capacity = pool_capacity().load(std::memory_order_relaxed);
+    if (capacity)
+        return std::allocate_shared<flesh_type>(
+                    base::pool_allocator<flesh_type>{capacity}, std::forward<Args>(args)...);
+
+#if BEASTHTTP_USE_MAKE_SHARED == 0
+    using Alloc = std::allocator<flesh_type>;
+
+    Alloc a = Alloc();
+
+    return std::shared_ptr<flesh_type>(
+                new (std::allocator_traits<Alloc>::allocate(a, 1)) flesh_type(
+                    std::forward<Args>(args)...));
+#else
+    return std::make_shared<flesh_type>(std::forward<Args>(args)...);
+#endif // BEASTHTTP_USE_MAKE_SHARED == 0
+}
+
+BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
+std::atomic<std::size_t>&
+session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::pool_capacity()
+{
+    static std::atomic<std::size_t> value{0};
+    return value;
+}
+
+BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
+std::atomic<std::size_t>&
+session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::coalesce_limit()
+{
+    static std::atomic<std::size_t> value{0};
+    return value;
+}
+
+BEASTHTTP_REACTOR_SSL_SESSION_TMPL_DECLARE
+typename session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::push_limits_type&
+session<BEASTHTTP_REACTOR_SSL_SESSION_TMPL_ATTRIBUTES>::push_limits()
+{
+    static push_limits_type value;
+    return value;
+}
+
 } // namespace ssl
 } // namespace reactor
 } // namespace http
@@ -6,10 +6,16 @@
 #include <http/base/config.hxx>
 
 #include <http/base/cb.hxx>
+#include <http/base/inplace_function.hxx>
 #include <http/base/request_processor.hxx>
+#include <http/base/pool.hxx>
+#include <http/base/outbox.hxx>
+#include <http/base/pipelined.hxx>
 #include <http/base/queue.hxx>
 #include <http/base/timer.hxx>
 #include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/verb_map.hxx>
 #include <http/base/strand_stream.hxx>
 #include <http/base/lockable.hxx>
 
@@ -20,6 +26,8 @@
 #include <boost/asio/dispatch.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/http/string_body.hpp>
+#include <atomic>
+#include <functional>
 #include <memory>
 
 #ifdef BEASTHTTP_CXX17_OPTIONAL
@@ -35,6 +43,7 @@
                router.method_map(), \
                router.regex_flags(), \
                &router.mutex(), \
+               router.snapshot(), \
                std::declval<buffer_type>(), \
                std::declval<_OnAction>()...)
 
@@ -45,6 +54,7 @@
                std::declval<std::shared_ptr<method_map_type>>(), \
                std::declval<regex_flag_type>(), \
                std::declval<mutex_type*>(), \
+               std::declval<std::shared_ptr<snapshot_type const>>(), \
                std::declval<buffer_type>(), \
                std::declval<_OnError>())
 
@@ -73,17 +83,21 @@ template</*Prototype parser/serializer for messages*/
          class Clock = boost::asio::chrono::steady_clock,
          class Timer = boost::asio::basic_waitable_timer<Clock>,
          /*Callback list container*/
-         template<typename> class Entry = std::function,
+         template<typename> class Entry = base::inplace_function,
          template<typename, typename...> class Container = std::vector,
          /*Resources container*/
-         template<typename Key, typename Value, typename... Args> class MethodMap = std::map,
+         template<typename Key, typename Value, typename... Args> class MethodMap = base::verb_map,
          template<typename Key, typename Value, typename... Args> class ResourceMap = std::unordered_map,
          /*On error handler*/
-         template<typename> class OnError = std::function,
+         template<typename> class OnError = base::inplace_function,
          /*On timer expired handler*/
-         template<typename> class OnTimer = std::function,
+         template<typename> class OnTimer = base::inplace_function,
          /*On handshake handler*/
-         template<typename> class OnHandshake = std::function>
+         template<typename> class OnHandshake = std::function,
+         /*Route matching backend*/
+         class Regex = base::regex,
+         /*Responses held for pipelined requests*/
+         std::size_t QueueDepth = 16>
 class session
 {
     using self_type = session;
@@ -107,6 +121,10 @@ public:
         {
         };
 
+        struct on_backpressure_t
+        {
+        };
+
         struct get_socket_t
         {
         };
@@ -143,7 +161,9 @@ public:
     template<class _Body>
     using response_type = boost::beast::http::response<_Body>;
 
-    using queue_type = base::queue<flesh>;
+    using queue_type = base::queue<flesh, QueueDepth, sizeof(response_type<Body>)>;
+
+    using pool_type = base::pool<flesh>;
 
     using buffer_type = Buffer;
 
@@ -161,7 +181,7 @@ public:
 
     using clock_type = typename timer_type::clock_type;
 
-    using regex_type = base::regex;
+    using regex_type = Regex;
 
     using regex_flag_type = typename regex_type::flag_type;
 
@@ -171,12 +191,24 @@ public:
 
     using on_timer_type = OnTimer<void (context_type)>;
 
+    using on_backpressure_type = OnTimer<void (context_type, std::size_t)>;
+
+    using push_overflow = base::outbox::overflow;
+
+    using shared_message = base::outbox::shared_message;
+
     using storage_type = base::cb::storage<self_type, Entry, Container>;
 
-    using resource_map_type = ResourceMap<resource_regex_type, storage_type>;
+    using route_type = base::route<regex_type, storage_type>;
+
+    using resource_map_type = ResourceMap<resource_regex_type, route_type>;
 
     using method_map_type = MethodMap<method_type, resource_map_type>;
 
+    using dispatcher_type = std::function<bool (request_type&, flesh_type&)>;
+
+    using snapshot_type = base::snapshot<resource_map_type, method_map_type, dispatcher_type>;
+
     using shutdown_type = typename socket_type::shutdown_type;
 
     static_assert (base::traits::TryInvoke<on_timer_type, void(context_type)>::value,
@@ -190,9 +222,51 @@ public:
 
     static constexpr typename option::on_error_t on_error_arg{};
     static constexpr typename option::on_timer_t on_timer_arg{};
+    static constexpr typename option::on_backpressure_t on_backpressure_arg{};
     static constexpr typename option::get_socket_t get_socket_arg{};
     static constexpr typename option::get_ssl_stream_t get_ssl_stream_arg{};
 
+    /**
+      @brief Recycles the memory of closed sessions per thread
+
+      Sessions created without an allocator take their flesh, with its
+      shared state, from a free list of the creating thread; a closed
+      session returns it to the list of the thread it was released on,
+      which keeps up to capacity blocks. A capacity of 0 turns the pool
+      off, which is the default.
+    */
+    static void
+    enable_pool(std::size_t capacity);
+
+    /// Pool of the calling thread, with its hit and miss counters
+    static pool_type const&
+    pool();
+
+    /**
+      @brief Writes the responses pending after a write all at once
+
+      Sessions serialize the responses waiting in their queue into one
+      buffer sequence, sent by a single gather write, copying at most
+      limit bytes of headers and bodies that do not keep their bytes in
+      the message. A limit of 0 writes the responses one by one, which
+      is the default.
+    */
+    static void
+    enable_coalescing(std::size_t limit);
+
+    /**
+      @brief Bounds the messages pushed to a peer slower than they come
+
+      Pushed messages are written in the background, the ones waiting
+      for a write all at once. When the bytes held by a session reach
+      watermark, its on_backpressure handler is called with them, and
+      again with 0 once they are all written. Past limit, policy closes
+      the session, drops the new message, or drops the oldest messages
+      not yet being written. Defaults to 64 KiB, 1 MiB and close.
+    */
+    static void
+    limit_push(std::size_t watermark, std::size_t limit, push_overflow policy);
+
 private:
 
     class flesh : public base::strand_stream, base::request_processor<self_type>,
@@ -240,6 +314,9 @@ private:
         flesh&
         push(response_type<_Body>&);
 
+        flesh&
+        push(shared_message const&);
+
         flesh&
         wait();
 
@@ -282,6 +359,13 @@ private:
                base::traits::TryInvoke<Handler,
                void(context_type)>::value, int>::type = 0);
 
+        template<class Handler>
+        void
+        member(typename option::on_backpressure_t, Handler&,
+               typename std::enable_if<
+               base::traits::TryInvoke<Handler,
+               void(context_type, std::size_t)>::value, int>::type = 0);
+
         template<class Handler, class Allocator>
         void
         member(typename option::on_error_t, Handler&, const Allocator&,
@@ -312,6 +396,7 @@ private:
               std::shared_ptr<method_map_type> const&,
               regex_flag_type,
               mutex_type*,
+              std::shared_ptr<snapshot_type const> const&,
               buffer_type&&);
 
         explicit
@@ -321,6 +406,7 @@ private:
               std::shared_ptr<method_map_type> const&,
               regex_flag_type,
               mutex_type*,
+              std::shared_ptr<snapshot_type const> const&,
               buffer_type&&);
 
         template<class _OnHandshake>
@@ -331,6 +417,7 @@ private:
               std::shared_ptr<method_map_type> const&,
               regex_flag_type,
               mutex_type*,
+              std::shared_ptr<snapshot_type const> const&,
               buffer_type&&,
               _OnHandshake&&,
               typename std::enable_if<
@@ -345,6 +432,7 @@ private:
               std::shared_ptr<method_map_type> const&,
               regex_flag_type,
               mutex_type*,
+              std::shared_ptr<snapshot_type const> const&,
               buffer_type&&,
               _OnError&&,
               typename std::enable_if<
@@ -360,6 +448,7 @@ private:
               std::shared_ptr<method_map_type> const&,
               regex_flag_type,
               mutex_type*,
+              std::shared_ptr<snapshot_type const> const&,
               buffer_type&&,
               _OnHandshake&&,
               _OnError&&,
@@ -378,6 +467,7 @@ private:
               std::shared_ptr<method_map_type> const&,
               regex_flag_type,
               mutex_type*,
+              std::shared_ptr<snapshot_type const> const&,
               buffer_type&&,
               _OnHandshake&&,
               _OnError&&,
@@ -408,6 +498,9 @@ private:
         void
         on_write(boost::system::error_code, std::size_t, bool);
 
+        void
+        on_push(boost::system::error_code, std::size_t);
+
         void
         do_handshake();
 
@@ -418,9 +511,15 @@ private:
         void
         do_write(response_type<_Body>&);
 
-        template<class _Body>
         void
-        do_push(response_type<_Body>&);
+        do_write(base::write_batch&);
+
+        template<class Message>
+        void
+        do_push(Message&);
+
+        void
+        do_flush();
 
         void
         do_read();
@@ -457,6 +556,7 @@ private:
         on_handshake_type on_handshake_;
         on_error_type on_error_;
         on_timer_type on_timer_;
+        on_backpressure_type on_backpressure_;
 
 #ifdef BEASTHTTP_CXX17_OPTIONAL
         std::optional<request_parser_type> parser_;
@@ -469,6 +569,10 @@ private:
         buffer_type buffer_;
         queue_type queue_;
 
+        base::outbox outbox_;
+
+        bool backpressured_ = false;
+
     }; // class flesh
 
     template<class Flesh, context_policy policy>
@@ -520,6 +624,23 @@ private:
                             flesh_p_->shared_from_this(), arg, std::forward<Handler>(handler), 0));
         }
 
+        template<class Handler>
+        auto
+        advance(typename option::on_backpressure_t arg, Handler&& handler) const -> decltype (
+                BEASTHTTP_REACTOR_SSL_SESSION_TRY_INVOKE_MEMBER(
+                    std::declval<typename option::on_backpressure_t>(), std::declval<Handler>()))
+        {
+            using handler_type = typename std::decay<Handler>::type;
+
+            boost::asio::dispatch(
+                        static_cast<base::strand_stream&>(*flesh_p_), std::bind(
+                            static_cast<void (Flesh::*)(
+                                typename option::on_backpressure_t, handler_type&, typename std::enable_if<
+                                    base::traits::TryInvoke<handler_type,
+                                    void(context_type, std::size_t)>::value, int>::type)>(&Flesh::template member<handler_type>),
+                            flesh_p_->shared_from_this(), arg, std::forward<Handler>(handler), 0));
+        }
+
         template<class Handler, class Allocator>
         auto
         advance(typename option::on_error_t arg, Handler&& handler, Allocator&& alloc) const -> decltype (
@@ -596,6 +717,14 @@ private:
             {
                 return ctx.advance(on_timer_arg, std::forward<Args>(args)...);
             }
+
+            template<class... Args>
+            static auto
+            on_backpressure(context<Flesh, context_policy::shared> ctx, Args&&... args) -> decltype (
+                    BEASTHTTP_REACTOR_SSL_SESSION_CONTEXT_TRY_INVOKE_ADVANCE(on_backpressure_arg, std::declval<Args>()...))
+            {
+                return ctx.advance(on_backpressure_arg, std::forward<Args>(args)...);
+            }
         };
 
         struct get
@@ -623,6 +752,12 @@ private:
         {
         }
 
+        /// Empty once the session is gone, see save
+        context(std::shared_ptr<Flesh> flesh_p)
+            : flesh_p_{std::move(flesh_p)}
+        {
+        }
+
         static context<Flesh, context_policy::shared>
         save(context<Flesh, context_policy::shared> other, bool& is_ok)
         {
@@ -760,6 +895,15 @@ private:
                             flesh_p_->shared_from_this(), std::move(response)));
         }
 
+        void
+        push(shared_message const& message) const
+        {
+            boost::asio::dispatch(
+                        static_cast<base::strand_stream&>(*flesh_p_), std::bind(
+                            static_cast<Flesh& (Flesh::*)(shared_message const&)>(&Flesh::push),
+                            flesh_p_->shared_from_this(), message));
+        }
+
         void
         wait() const
         {
@@ -939,6 +1083,28 @@ public:
     force_cls(boost::asio::ssl::context& ctx, socket_type&& socket, _OnError&& on_error) -> decltype (
             void(BEASTHTTP_REACTOR_SSL_SESSION_TRY_INVOKE_FLESH_TYPE_LEGACY()));
 
+private:
+
+    template<class... Args>
+    static std::shared_ptr<flesh_type>
+    create(Args&&... args);
+
+    static std::atomic<std::size_t>&
+    pool_capacity();
+
+    static std::atomic<std::size_t>&
+    coalesce_limit();
+
+    struct push_limits_type
+    {
+        std::atomic<std::size_t> watermark{64 * 1024};
+        std::atomic<std::size_t> limit{1024 * 1024};
+        std::atomic<push_overflow> policy{push_overflow::close};
+    };
+
+    static push_limits_type&
+    push_limits();
+
 }; // class session
 
 namespace _default {
@@ -0,0 +1,380 @@
+#ifndef BEASTHTTP_ROUTE_TABLE_HXX
+#define BEASTHTTP_ROUTE_TABLE_HXX
+
+#include <http/base/config.hxx>
+#include <http/base/request_processor.hxx>
+#include <http/base/traits.hxx>
+#include <http/literals.hxx>
+
+#include <boost/beast/http/verb.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifdef BEASTHTTP_CXX14_CONSTEXPR
+namespace _0xdead4ead {
+namespace http {
+
+template<class, class, class...>
+class route_table;
+
+/**
+  @brief Compile-time index of literal routes
+
+  Built from the route literals by make_route_index, in a constant
+  expression:
+
+      using namespace http::literals;
+
+      constexpr auto routes = http::make_route_index(
+                  "/"_get, "/health"_get, "/users"_post, "/users"_get);
+
+  Exact paths are placed with a perfect hash, whose seed is searched for
+  by the compiler, so find() costs one hash of the target, one slot read
+  and one comparison. A path ending in a slash and an asterisk, such as
+  "/static/" followed by '*', is a prefix; prefixes are tried longest
+  first. A path must be literal: a regular expression or a named segment
+  does not compile, while a dot stands for itself ("/favicon.ico").
+*/
+template<std::size_t Count, std::size_t Slots>
+class route_index
+{
+    using self_type = route_index;
+
+    static_assert (Count != 0, "Route index is empty!");
+
+    static_assert ((Slots & (Slots - 1)) == 0, "Slots must be a power of two!");
+
+public:
+
+    using verb_type = boost::beast::http::verb;
+
+    struct entry
+    {
+        const char* path = nullptr;
+        std::size_t size = 0;
+        verb_type method = verb_type::unknown;
+        bool prefix = false;
+        bool head = true;       // first exact entry of its path
+        std::size_t next = 0;   // next entry of the same path, plus one
+    };
+
+    static constexpr std::size_t size = Count;
+
+    template<class... Symbols>
+    constexpr explicit
+    route_index(literals::detail::__verb<Symbols> const&... routes)
+    {
+        const entry list[] = {make_entry(routes.s_, routes.n_,
+                                         literals::detail::__method<Symbols>::value)...};
+
+        for (std::size_t i = 0; i < Count; ++i) {
+            entries_[i] = list[i];
+            if (entries_[i].prefix) {
+                insert_prefix(i);
+                continue;
+            }
+
+            for (std::size_t j = i; j-- > 0;)
+                if (not entries_[j].prefix and entries_[j].next == 0
+                        and equal(entries_[j], entries_[i].path, entries_[i].size)) {
+                    entries_[j].next = i + 1;
+                    entries_[i].head = false;
+                    break;
+                }
+        }
+
+        for (std::uint32_t seed = 0; seed < 65536; ++seed)
+            if (place(seed)) {
+                seed_ = seed;
+                return;
+            }
+
+        throw std::logic_error{"route_index: no perfect hash found"};
+    }
+
+    /// Index of the route for this request, or size if there is none
+    constexpr std::size_t
+    find(verb_type method, const char* target, std::size_t length) const
+    {
+        for (std::size_t i = slots_[hash(seed_, target, length) & (Slots - 1)]; i != 0;
+             i = entries_[i - 1].next) {
+            if (not equal(entries_[i - 1], target, length))
+                break;
+
+            if (accepts(entries_[i - 1], method))
+                return i - 1;
+        }
+
+        for (std::size_t k = 0; k < prefix_count_; ++k) {
+            entry const& e = entries_[prefixes_[k]];
+            if (length >= e.size and equal(e, target, e.size) and accepts(e, method))
+                return prefixes_[k];
+        }
+
+        return Count;
+    }
+
+    constexpr entry const&
+    operator[](std::size_t i) const
+    {
+        return entries_[i];
+    }
+
+    /// Binds one handler per route, in order, and a router for the rest
+    template<class Router, class... Fs>
+    route_table<typename Router::session_type, self_type, typename std::decay<Fs>::type...>
+    bind(Router const& router, Fs&&... fs) const;
+
+private:
+
+    static constexpr std::uint32_t
+    hash(std::uint32_t seed, const char* data, std::size_t length)
+    {
+        std::uint32_t value = 2166136261u ^ (seed * 16777619u);
+        for (std::size_t i = 0; i < length; ++i)
+            value = (value ^ static_cast<unsigned char>(data[i])) * 16777619u;
+
+        value ^= value >> 15;
+        value *= 0x2c1b3c6du;
+        value ^= value >> 12;
+        return value;
+    }
+
+    static constexpr bool
+    equal(entry const& e, const char* data, std::size_t length)
+    {
+        if (e.size != length and not e.prefix)
+            return false;
+
+        for (std::size_t i = 0; i < length; ++i)
+            if (e.path[i] != data[i])
+                return false;
+
+        return true;
+    }
+
+    static constexpr bool
+    accepts(entry const& e, verb_type method)
+    {
+        return e.method == verb_type::unknown or e.method == method;
+    }
+
+    static constexpr entry
+    make_entry(const char* path, std::size_t size, verb_type method)
+    {
+        if (size > 0 and path[0] == '^') {
+            ++path;
+            --size;
+        }
+
+        if (size > 0 and path[size - 1] == '$')
+            --size;
+
+        entry result;
+        result.method = method;
+
+        if (size > 1 and path[size - 1] == '*' and path[size - 2] == '/') {
+            result.prefix = true;
+            --size;
+        }
+
+        for (std::size_t i = 0; i < size; ++i)
+            switch (path[i]) {
+            case ':':
+                if (i > 0 and path[i - 1] == '/')
+                    throw std::invalid_argument{"route_index: the path is not literal"};
+                break;
+            case '\\': case '*': case '+': case '?': case '|':
+            case '(': case ')': case '[': case ']': case '{': case '}':
+            case '^': case '$':
+                throw std::invalid_argument{"route_index: the path is not literal"};
+            default:
+                break;
+            }
+
+        result.path = path;
+        result.size = size;
+        return result;
+    }
+
+    constexpr void
+    insert_prefix(std::size_t i)
+    {
+        std::size_t k = prefix_count_++;
+        for (; k > 0 and entries_[prefixes_[k - 1]].size < entries_[i].size; --k)
+            prefixes_[k] = prefixes_[k - 1];
+
+        prefixes_[k] = i;
+    }
+
+    constexpr bool
+    place(std::uint32_t seed)
+    {
+        for (std::size_t s = 0; s < Slots; ++s)
+            slots_[s] = 0;
+
+        for (std::size_t i = 0; i < Count; ++i) {
+            if (entries_[i].prefix or not entries_[i].head)
+                continue;
+
+            const std::size_t s = hash(seed, entries_[i].path, entries_[i].size) & (Slots - 1);
+            if (slots_[s] != 0)
+                return false;
+
+            slots_[s] = i + 1;
+        }
+
+        return true;
+    }
+
+    entry entries_[Count] = {};
+    std::size_t slots_[Slots] = {};
+    std::size_t prefixes_[Count] = {};
+    std::size_t prefix_count_ = 0;
+    std::uint32_t seed_ = 0;
+
+}; // class route_index
+
+template<std::size_t Count, std::size_t Slots>
+constexpr std::size_t route_index<Count, Slots>::size;
+
+namespace detail {
+
+constexpr std::size_t
+route_index_slots(std::size_t count)
+{
+    std::size_t slots = 1;
+    while (slots < 4 * count)
+        slots <<= 1;
+
+    return slots;
+}
+
+} // namespace detail
+
+template<class... Symbols>
+constexpr route_index<sizeof... (Symbols), detail::route_index_slots(sizeof... (Symbols))>
+make_route_index(literals::detail::__verb<Symbols> const&... routes)
+{
+    return route_index<sizeof... (Symbols), detail::route_index_slots(sizeof... (Symbols))>{
+        routes...};
+}
+
+/**
+  @brief Literal routes dispatched through a route_index
+
+  Set as the dispatcher of the router it was bound to, the table is tried
+  first by the sessions created afterwards:
+
+      router.dispatch(routes.bind(router, home, health));
+
+  A request on one of the literal routes goes straight to its handler,
+  called as f(request, context); for every other one the table returns
+  false and the router keeps serving the dynamic routes. provide() has
+  the signature of base::request_processor and resolves those through the
+  router itself.
+*/
+template<class Session, class Index, class... Fs>
+class route_table
+{
+    using self_type = route_table;
+
+    static_assert (sizeof... (Fs) == Index::size, "Exactly one handler per route!");
+
+public:
+
+    using session_type = Session;
+
+    using index_type = Index;
+
+    using request_type = typename session_type::request_type;
+
+    using flesh_type = typename session_type::flesh_type;
+
+    using context_type = typename session_type::context_type;
+
+    using processor_type = base::request_processor<session_type>;
+
+    template<class Router, class... Handlers>
+    route_table(index_type const& index, Router const& router, Handlers&&... handlers)
+        : index_{index},
+          handlers_{std::forward<Handlers>(handlers)...},
+          fallback_{router.resource_map(), router.method_map(), router.regex_flags()}
+    {
+    }
+
+    index_type const&
+    index() const
+    {
+        return index_;
+    }
+
+    /// False when the request is on none of the literal routes
+    bool
+    operator()(request_type& request, flesh_type& flesh)
+    {
+        const auto target = request.target();
+        const std::size_t i = index_.find(request.method(), target.data(), target.size());
+
+        if (i == index_type::size)
+            return false;
+
+        invoke(i, request, flesh, base::traits::MakeIndexSequence<index_type::size>{});
+        return true;
+    }
+
+    void
+    provide(request_type& request, flesh_type& flesh)
+    {
+        if (not (*this)(request, flesh))
+            fallback_.provide(request, flesh);
+    }
+
+private:
+
+    template<std::size_t Route>
+    static void
+    call(self_type& self, request_type& request, flesh_type& flesh)
+    {
+        std::get<Route>(self.handlers_)(request, context_type{flesh});
+    }
+
+    // A jump table over the handlers, as a switch on the route index would be
+    template<std::size_t... Indexes>
+    void
+    invoke(std::size_t i, request_type& request, flesh_type& flesh,
+           base::traits::IndexSequence<Indexes...>)
+    {
+        using call_type = void (*)(self_type&, request_type&, flesh_type&);
+
+        static constexpr call_type calls[] = {&self_type::template call<Indexes>...};
+
+        calls[i](*this, request, flesh);
+    }
+
+    index_type index_;
+    std::tuple<Fs...> handlers_;
+    processor_type fallback_;
+
+}; // class route_table
+
+template<std::size_t Count, std::size_t Slots>
+template<class Router, class... Fs>
+route_table<typename Router::session_type, route_index<Count, Slots>,
+            typename std::decay<Fs>::type...>
+route_index<Count, Slots>::bind(Router const& router, Fs&&... fs) const
+{
+    return route_table<typename Router::session_type, self_type,
+            typename std::decay<Fs>::type...>{*this, router, std::forward<Fs>(fs)...};
+}
+
+} // namespace http
+} // namespace _0xdead4ead
+#endif // BEASTHTTP_CXX14_CONSTEXPR
+
+#endif // not defined BEASTHTTP_ROUTE_TABLE_HXX
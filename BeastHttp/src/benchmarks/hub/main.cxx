@@ -0,0 +1,267 @@
+#include <http/reactor/session.hxx>
+#include <http/basic_router.hxx>
+#include <http/hub.hxx>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/config.hpp>
+
+#include <malloc.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace _0xdead4ead;
+
+// Heap bytes held, their peak, and the bytes allocated while a
+// measurement is running. The replacements are kept out of line, so that
+// gcc does not pair malloc with delete
+static std::atomic<bool> counting{false};
+static std::atomic<std::size_t> allocated{0};
+static std::atomic<std::size_t> held{0};
+static std::atomic<std::size_t> peak{0};
+
+BOOST_NOINLINE void*
+operator new(std::size_t size)
+{
+    void* p = std::malloc(size ? size : 1);
+    if (not p)
+        throw std::bad_alloc{};
+
+    const std::size_t bytes = ::malloc_usable_size(p);
+    if (counting.load(std::memory_order_relaxed))
+        allocated.fetch_add(bytes, std::memory_order_relaxed);
+
+    const std::size_t now = held.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::size_t top = peak.load(std::memory_order_relaxed);
+    while (now > top and not peak.compare_exchange_weak(top, now, std::memory_order_relaxed));
+
+    return p;
+}
+
+BOOST_NOINLINE void
+operator delete(void* p) noexcept
+{
+    if (p)
+        held.fetch_sub(::malloc_usable_size(p), std::memory_order_relaxed);
+
+    std::free(p);
+}
+
+BOOST_NOINLINE void
+operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+using http_session = http::reactor::_default::session_type;
+
+using response_type = boost::beast::http::response<boost::beast::http::string_body>;
+
+// An event as the reactor_sse example sends it
+static response_type
+make_event(std::size_t id, std::size_t size)
+{
+    response_type response{boost::beast::http::status::ok, 11};
+    response.set(boost::beast::http::field::cache_control, "no-cache");
+    response.set(boost::beast::http::field::content_type, "text/event-stream");
+    response.body() = "data: " + std::to_string(id) + ' ' + std::string(size, '.') + "\n\n";
+    response.prepare_payload();
+    return response;
+}
+
+// Subscribers connected over loopback, all read by one thread
+struct clients
+{
+    boost::asio::io_context ioc;
+
+    std::vector<std::unique_ptr<boost::asio::ip::tcp::socket>> sockets;
+
+    char discard[65536];
+
+    std::atomic<std::size_t> received{0};
+
+    void
+    connect(boost::asio::ip::tcp::endpoint endpoint, std::size_t count)
+    {
+        const std::string request = "GET /sse HTTP/1.1\r\nHost: bench\r\n\r\n";
+
+        for (std::size_t i = 0; i < count; ++i) {
+            sockets.emplace_back(new boost::asio::ip::tcp::socket{ioc});
+            sockets.back()->connect(endpoint);
+            boost::asio::write(*sockets.back(), boost::asio::buffer(request));
+            read(*sockets.back());
+        }
+    }
+
+    void
+    read(boost::asio::ip::tcp::socket& socket)
+    {
+        socket.async_read_some(boost::asio::buffer(discard), [this, &socket](boost::system::error_code ec, std::size_t bytes){
+            if (ec)
+                return;
+
+            received.fetch_add(bytes, std::memory_order_relaxed);
+            read(socket);
+        });
+    }
+
+}; // struct clients
+
+// Publishes events from the thread of the sessions, as a timer handler
+// would, and waits for all the subscribers to receive them
+static void
+run(const char* name, boost::asio::io_context& ioc, clients& subscribers,
+    std::function<void(std::size_t)> const& publish, std::size_t events, std::size_t event_size)
+{
+    const std::size_t expected = subscribers.received + subscribers.sockets.size() * events * event_size;
+
+    const std::size_t before = held;
+
+    allocated = 0;
+    peak = before;
+    counting = true;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    boost::asio::post(ioc, [&]{
+        for (std::size_t id = 0; id < events; ++id)
+            publish(id);
+    });
+
+    while (subscribers.received < expected)
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+    counting = false;
+
+    std::cout << name << "  events/s " << events / elapsed.count()
+              << "  allocated KiB/event " << allocated / 1024.0 / events
+              << "  peak held MiB " << (peak - before) / 1024.0 / 1024.0 << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    std::size_t events = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+    std::size_t body = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 256;
+
+    // Two descriptors a subscriber, the server and the client ends; past
+    // the hard limit, only as many as it allows
+    const rlim_t needed = 2 * count + 64;
+
+    rlimit files;
+    ::getrlimit(RLIMIT_NOFILE, &files);
+    if (files.rlim_cur < needed) {
+        rlimit raised{needed, std::max(needed, files.rlim_max)};
+        if (::setrlimit(RLIMIT_NOFILE, &raised) == 0)
+            files = raised;
+        else {
+            files.rlim_cur = files.rlim_max;
+            ::setrlimit(RLIMIT_NOFILE, &files);
+        }
+    }
+
+    count = std::min<std::size_t>(count, (files.rlim_cur - 64) / 2);
+
+    boost::asio::io_context ioc;
+
+    http::basic_router<http_session> router{std::regex::ECMAScript};
+
+    http::hub<http_session> hub;
+
+    std::mutex mutex;
+    std::vector<http_session::weak_context> contexts;
+
+    router.get("^/sse$", [&](auto /*request*/, auto context){
+        hub.subscribe(context);
+
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            contexts.push_back(context.weak());
+        }
+
+        context.recv();
+    });
+
+    http_session::limit_push(64 * 1024, 16 * 1024 * 1024, http_session::push_overflow::close);
+
+    boost::asio::ip::tcp::acceptor acceptor{ioc, {boost::asio::ip::address_v4::loopback(), 0}};
+
+    std::function<void()> accept = [&]{
+        acceptor.async_accept([&](boost::system::error_code ec, boost::asio::ip::tcp::socket socket){
+            if (ec)
+                return;
+
+            http_session::recv(std::move(socket), router);
+            accept();
+        });
+    };
+
+    accept();
+
+    auto work = boost::asio::make_work_guard(ioc);
+    std::thread server{[&]{ ioc.run(); }};
+
+    clients subscribers;
+    subscribers.connect(acceptor.local_endpoint(), count);
+
+    auto client_work = boost::asio::make_work_guard(subscribers.ioc);
+    std::thread client{[&]{ subscribers.ioc.run(); }};
+
+    while (hub.size() < count)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    const std::size_t event_size = [&]{
+        std::ostringstream stream;
+        stream << make_event(0, body);
+        return stream.str().size();
+    }();
+
+    std::cout << count << " subscribers, " << events << " events of "
+              << event_size << " bytes" << std::endl;
+
+    // As the reactor_sse example does, a response built and serialized
+    // for each subscriber
+    run("push to each", ioc, subscribers, [&](std::size_t id){
+        for (auto const& weak : contexts) {
+            bool is_ok = false;
+            auto context = http_session::context_type::save(weak.load(), is_ok);
+            if (is_ok)
+                context.push(make_event(id, body));
+        }
+    }, events, event_size);
+
+    // Serialized once, the same buffer written to every subscriber
+    run("hub publish ", ioc, subscribers, [&](std::size_t id){
+        hub.publish(make_event(id, body));
+    }, events, event_size);
+
+    boost::asio::post(ioc, [&]{ acceptor.close(); });
+
+    client_work.reset();
+    subscribers.ioc.stop();
+    client.join();
+
+    subscribers.sockets.clear();
+
+    work.reset();
+    ioc.stop();
+    server.join();
+
+    return 0;
+}
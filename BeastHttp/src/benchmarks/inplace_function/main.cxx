@@ -0,0 +1,213 @@
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/inplace_function.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <unordered_map>
+
+using namespace _0xdead4ead;
+
+static std::size_t allocations = 0;
+
+void*
+operator new(std::size_t size)
+{
+    ++allocations;
+
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+template<template<typename> class Entry>
+class bench_session
+{
+public:
+
+    using self_type = bench_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, Entry, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class bench_session
+
+template<class F>
+static double
+measure(std::size_t iterations, F&& f)
+{
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+        f(n);
+
+    return std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - begin).count() / double(iterations);
+}
+
+// A handler capturing a few references, as route handlers usually do
+struct handler
+{
+    std::size_t& a;
+    std::size_t& b;
+    std::size_t& c;
+    std::size_t& d;
+
+    void
+    operator()(std::size_t n) const
+    {
+        a += n; b ^= n; c += a; d += b;
+    }
+}; // struct handler
+
+template<class Function, class Target>
+static void
+call(const char* name, std::size_t iterations, Target const& target)
+{
+    allocations = 0;
+    std::vector<Function> entries;
+    entries.reserve(64);
+    for (std::size_t i = 0; i < 64; ++i)
+        entries.emplace_back(target);
+
+    double per_entry = double(allocations) / 64;
+
+    double ns = measure(iterations, [&](std::size_t n){
+        entries[n % 64](n);
+    });
+
+    std::cout << name << "  " << ns << "  " << per_entry << std::endl;
+}
+
+// A chain of four handlers and a final one, resolved through provide()
+template<template<typename> class Entry>
+static void
+provide(const char* name, std::size_t iterations)
+{
+    using session_type = bench_session<Entry>;
+
+    http::basic_router<session_type> router{std::regex::ECMAScript};
+
+    std::size_t a = 0, b = 0, c = 0, d = 0;
+
+    allocations = 0;
+
+    router.get("^/$", [&](auto& /*request*/, auto /*context*/, auto _1x){
+        ++a; std::next(_1x)();
+    }, [&](auto& /*request*/, auto /*context*/, auto _2x){
+        ++b; std::next(_2x)();
+    }, [&](auto& /*request*/, auto /*context*/, auto _3x){
+        ++c; std::next(_3x)();
+    }, [&](auto& /*request*/, auto /*context*/, auto _4x){
+        ++d; std::next(_4x)();
+    }, [&](auto& /*request*/, auto /*context*/){
+        ++a;
+    });
+
+    std::size_t registered = allocations;
+
+    http::base::request_processor<session_type>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    typename session_type::request_type request{boost::beast::http::verb::get, "/", 11};
+    typename session_type::flesh flesh;
+
+    double ns = measure(iterations, [&](std::size_t){
+        procs.provide(request, flesh);
+    });
+
+    std::cout << name << "  " << ns << "  " << registered << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+
+    std::size_t a = 0, b = 0, c = 0, d = 0;
+    handler target{a, b, c, d};
+
+    auto bound = std::bind<void>(target, std::placeholders::_1);
+
+    std::cout << "callable  ns/call  allocations/entry" << std::endl;
+
+    call<std::function<void (std::size_t)>>(
+                "std::function(std::bind)", iterations * 100, bound);
+    call<std::function<void (std::size_t)>>(
+                "std::function", iterations * 100, target);
+    call<http::base::inplace_function<void (std::size_t)>>(
+                "base::inplace_function", iterations * 100, target);
+
+    std::cout << "(checksum " << (a ^ b ^ c ^ d) << ")" << std::endl;
+
+    std::cout << "entry  provide ns/req  allocations to register" << std::endl;
+
+    provide<std::function>("std::function", iterations);
+    provide<http::base::inplace_function>("base::inplace_function", iterations);
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace _0xdead4ead;
+
+class bench_session
+{
+public:
+
+    using self_type = bench_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class bench_session
+
+using router_type = http::basic_router<bench_session>;
+
+template<class F>
+static double
+measure(std::size_t iterations, F&& f)
+{
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+        f(n);
+
+    return std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - begin).count() / double(iterations);
+}
+
+// An API of three levels, /sN/rN/..., with `fanout` routers at each of
+// them and 2 * fanout routes per leaf router
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    std::size_t fanout = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 6;
+
+    std::size_t handled = 0;
+
+    auto handler = [&](bench_session::request_type& /*request*/, bench_session::context_type){
+        ++handled;
+    };
+
+    router_type mounted{std::regex::ECMAScript};
+    router_type flat{std::regex::ECMAScript};
+
+    std::vector<std::unique_ptr<router_type>> routers;
+    std::vector<std::string> targets;
+
+    for (std::size_t s = 0; s < fanout; ++s) {
+        routers.emplace_back(new router_type{std::regex::ECMAScript});
+        router_type& service = *routers.back();
+
+        for (std::size_t r = 0; r < fanout; ++r) {
+            routers.emplace_back(new router_type{std::regex::ECMAScript});
+            router_type& resource = *routers.back();
+
+            for (std::size_t i = 0; i < fanout; ++i) {
+                const std::string name = "/item" + std::to_string(i);
+                resource.get("^" + name + "$", handler);
+                resource.get("^" + name + "/(\\d+)$", handler);
+
+                targets.push_back("/s" + std::to_string(s) + "/r" + std::to_string(r) + name + "/42");
+            }
+
+            service.mount("/r" + std::to_string(r), resource);
+        }
+
+        mounted.mount("/s" + std::to_string(s), service);
+        flat.use("^/s" + std::to_string(s) + "$", service);
+    }
+
+    std::vector<bench_session::request_type> requests;
+    for (auto const& target : targets)
+        requests.emplace_back(boost::beast::http::verb::get, target, 11);
+
+    bench_session::flesh flesh;
+
+    std::cout << "dispatch  ns/req (" << targets.size() * 2 << " routes)" << std::endl;
+
+    {
+        http::base::request_processor<bench_session>
+                procs{flat.resource_map(), flat.method_map(), flat.regex_flags()};
+
+        std::cout << "use (flattened)  " << measure(iterations, [&](std::size_t n){
+            procs.provide(requests[n % requests.size()], flesh);
+        }) << std::endl;
+    }
+
+    {
+        http::base::request_processor<bench_session>
+                procs{mounted.resource_map(), mounted.method_map(), mounted.regex_flags()};
+
+        std::cout << "mount  " << measure(iterations, [&](std::size_t n){
+            procs.provide(requests[n % requests.size()], flesh);
+        }) << std::endl;
+    }
+
+    // The deepest router alone, for the cost of its own 2 * fanout routes
+    {
+        std::vector<bench_session::request_type> leaf;
+        for (std::size_t i = 0; i < fanout; ++i)
+            leaf.emplace_back(boost::beast::http::verb::get, "/item" + std::to_string(i) + "/42", 11);
+
+        http::base::request_processor<bench_session>
+                procs{routers.back()->resource_map(), routers.back()->method_map(),
+                      routers.back()->regex_flags()};
+
+        std::cout << "leaf router alone  " << measure(iterations, [&](std::size_t n){
+            procs.provide(leaf[n % leaf.size()], flesh);
+        }) << std::endl;
+    }
+
+    std::cout << "(" << handled << " handled)" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include <http/base/cb.hxx>
+#include <http/base/radix_map.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+#include <http/param.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+
+using namespace _0xdead4ead;
+
+template<template<class, class, class...> class ResourceMap>
+class bench_session
+{
+public:
+
+    using self_type = bench_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = ResourceMap<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class bench_session
+
+// Readers resolve a param<int, std::string> route in a loop, as sessions
+// on different I/O threads do
+template<class Session>
+static double
+run(http::basic_router<Session>& router, std::size_t threads, std::size_t iterations)
+{
+    using processor_type = http::base::request_processor<Session>;
+
+    std::atomic<std::size_t> ready{0};
+    std::atomic<bool> start{false};
+    std::vector<std::thread> readers;
+
+    for (std::size_t i = 0; i < threads; ++i)
+        readers.emplace_back([&, i](){
+            processor_type procs{router.resource_map(), router.method_map(),
+                                 router.regex_flags()};
+
+            typename Session::request_type request{boost::beast::http::verb::get,
+                        "/users/" + std::to_string(1000 + i) + "/orders", 11};
+            typename Session::flesh flesh;
+
+            ++ready;
+            while (not start)
+                std::this_thread::yield();
+
+            for (std::size_t n = 0; n < iterations; ++n)
+                procs.provide(request, flesh);
+        });
+
+    while (ready != threads)
+        std::this_thread::yield();
+
+    auto begin = std::chrono::steady_clock::now();
+    start = true;
+
+    for (auto& reader : readers)
+        reader.join();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+    return double(threads * iterations) / elapsed.count();
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50000;
+
+    http::basic_router<bench_session<std::unordered_map>> regex{std::regex::ECMAScript},
+            segment{std::regex::ECMAScript};
+    http::basic_router<bench_session<http::base::radix_map>> radix{std::regex::ECMAScript};
+
+    std::atomic<std::size_t> sum{0};
+
+    auto handler = [&](){
+        return [&](auto& /*request*/, auto /*context*/, auto args){
+            sum.fetch_add(std::size_t(std::get<0>(args)) + std::get<1>(args).size(),
+                          std::memory_order_relaxed);
+        };
+    };
+
+    using pack = http::param::pack<int, std::string>;
+
+    regex.param<pack>().get("^/users/(\\d+)/(\\w+)$", handler());
+    // Typed segments, dispatched by the regex scan and then by the radix tree
+    segment.param<pack>().get("/users/{id:int}/{name}", handler());
+    radix.param<pack>().get("/users/{id:int}/{name}", handler());
+
+    std::size_t max_threads = std::max(8u, std::thread::hardware_concurrency());
+
+    std::cout << "threads  requests/s: regex  segments  segments+radix_map" << std::endl;
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2)
+        std::cout << threads << "  " << run(regex, threads, iterations)
+                  << "  " << run(segment, threads, iterations)
+                  << "  " << run(radix, threads, iterations) << std::endl;
+
+    std::cout << "(checksum " << sum << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,176 @@
+// Compile-time benchmark of param::pack: 200 parameterised routes with one
+// to six captures, each handler a distinct lambda. What is measured is the
+// build of this translation unit, e.g.
+//
+//     time make param_compile_benchmark && size main.cxx.o
+//
+// and running it only checks that every route is reachable.
+
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+#include <http/param.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace _0xdead4ead;
+
+class bench_session
+{
+public:
+
+    using self_type = bench_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class bench_session
+
+using router_type = http::basic_router<bench_session>;
+
+template<unsigned>
+struct arity;
+
+template<>
+struct arity<1>
+{
+    using type = http::param::pack<int>;
+};
+
+template<>
+struct arity<2>
+{
+    using type = http::param::pack<int, std::string>;
+};
+
+template<>
+struct arity<3>
+{
+    using type = http::param::pack<int, std::string, unsigned>;
+};
+
+template<>
+struct arity<4>
+{
+    using type = http::param::pack<int, std::string, unsigned, long>;
+};
+
+template<>
+struct arity<5>
+{
+    using type = http::param::pack<int, std::string, unsigned, long, int>;
+};
+
+template<>
+struct arity<6>
+{
+    using type = http::param::pack<int, std::string, unsigned, long, int, std::string>;
+};
+
+static std::vector<std::string> targets;
+
+template<unsigned Arity, class F>
+static void
+add(router_type& router, F&& f)
+{
+    std::string target = "/r" + std::to_string(targets.size());
+    std::string path = "^" + target;
+    for (unsigned i = 0; i < Arity; ++i) {
+        target += "/1";
+        path += "/(\\d+)";
+    }
+
+    targets.push_back(target);
+
+    router.param<typename arity<Arity>::type>().get(path + "$", std::forward<F>(f));
+}
+
+#define BENCH_ROUTE \
+    add<__COUNTER__ % 6 + 1>(router, [&](auto& /*request*/, auto /*context*/, auto args){ \
+        handled += std::get<0>(args); \
+    });
+
+#define BENCH_ROUTES_10 \
+    BENCH_ROUTE BENCH_ROUTE BENCH_ROUTE BENCH_ROUTE BENCH_ROUTE \
+    BENCH_ROUTE BENCH_ROUTE BENCH_ROUTE BENCH_ROUTE BENCH_ROUTE
+
+#define BENCH_ROUTES_50 \
+    BENCH_ROUTES_10 BENCH_ROUTES_10 BENCH_ROUTES_10 BENCH_ROUTES_10 BENCH_ROUTES_10
+
+int main()
+{
+    router_type router{std::regex::ECMAScript};
+
+    std::size_t handled = 0;
+
+    BENCH_ROUTES_50
+    BENCH_ROUTES_50
+    BENCH_ROUTES_50
+    BENCH_ROUTES_50
+
+    http::base::request_processor<bench_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    bench_session::flesh flesh;
+
+    for (auto const& target : targets) {
+        bench_session::request_type request{boost::beast::http::verb::get, target, 11};
+        procs.provide(request, flesh);
+    }
+
+    std::cout << targets.size() << " routes, " << handled << " handled" << std::endl;
+
+    return handled == targets.size() ? 0 : 1;
+}
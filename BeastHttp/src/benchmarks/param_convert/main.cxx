@@ -0,0 +1,73 @@
+#include <http/param.hxx>
+
+#include <boost/lexical_cast.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace _0xdead4ead;
+
+template<class F>
+static double
+measure(std::size_t iterations, F&& f)
+{
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+        f(n);
+
+    return std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - begin).count() / double(iterations);
+}
+
+// Converts the same captures once with boost::lexical_cast, as param::pack
+// used to, and once through param::converter
+template<class T>
+static void
+convert(const char* name, std::size_t iterations,
+        std::vector<std::string> const& captures, T& checksum)
+{
+    std::size_t const count = captures.size();
+
+    double lexical = measure(iterations, [&](std::size_t n){
+        checksum += boost::lexical_cast<T>(captures[n % count]);
+    });
+
+    double converter = measure(iterations, [&](std::size_t n){
+        T value{};
+        http::param::converter<T>::convert(captures[n % count], value);
+        checksum += value;
+    });
+
+    std::cout << name << "  " << lexical << "  " << converter << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+
+    std::vector<std::string> integers, floats, strings;
+    for (std::size_t i = 0; i < 64; ++i) {
+        integers.push_back(std::to_string(i * 7919));
+        floats.push_back(std::to_string(double(i) / 7));
+        strings.push_back("user-" + std::to_string(i));
+    }
+
+    int i = 0;
+    unsigned long long u = 0;
+    double d = 0;
+    std::string s;
+
+    std::cout << "type  lexical_cast ns  converter ns" << std::endl;
+
+    convert("int", iterations, integers, i);
+    convert("unsigned long long", iterations, integers, u);
+    convert("double", iterations, floats, d);
+    convert("std::string", iterations, strings, s);
+
+    std::cout << "(checksum " << i + u + d + s.size() << ")" << std::endl;
+
+    return 0;
+}
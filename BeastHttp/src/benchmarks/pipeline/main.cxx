@@ -0,0 +1,141 @@
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/inplace_function.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+#include <http/pipeline.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <unordered_map>
+
+using namespace _0xdead4ead;
+
+class bench_session
+{
+public:
+
+    using self_type = bench_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, http::base::inplace_function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class bench_session
+
+template<class F>
+static double
+measure(std::size_t iterations, F&& f)
+{
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+        f(n);
+
+    return std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - begin).count() / double(iterations);
+}
+
+// The same auth, logging and metrics layers in front of a handler, once as
+// a runtime chain and once as a pipeline
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+
+    std::size_t authorized = 0, logged = 0, measured = 0, handled = 0;
+
+    auto auth = [&](auto& request, auto /*context*/, auto next){
+        if (request.method() == boost::beast::http::verb::get) {
+            ++authorized;
+            std::next(next)();
+        }
+    };
+
+    auto log = [&](auto& /*request*/, auto /*context*/, auto next){
+        ++logged;
+        std::next(next)();
+    };
+
+    auto metrics = [&](auto& /*request*/, auto /*context*/, auto next){
+        ++measured;
+        std::next(next)();
+    };
+
+    auto handler = [&](auto& /*request*/, auto /*context*/){
+        ++handled;
+    };
+
+    http::basic_router<bench_session> chain{std::regex::ECMAScript},
+            pipeline{std::regex::ECMAScript};
+
+    chain.get("^/x$", auth, log, metrics, handler);
+    pipeline.get("^/x$", http::make_pipeline(auth, log, metrics, handler));
+
+    bench_session::request_type request{boost::beast::http::verb::get, "/x", 11};
+    bench_session::flesh flesh;
+
+    std::cout << "handlers  provide ns/req" << std::endl;
+
+    for (auto router : {&chain, &pipeline}) {
+        http::base::request_processor<bench_session>
+                procs{router->resource_map(), router->method_map(), router->regex_flags()};
+
+        double ns = measure(iterations, [&](std::size_t){
+            procs.provide(request, flesh);
+        });
+
+        std::cout << (router == &chain ? "runtime chain" : "pipeline") << "  " << ns
+                  << std::endl;
+    }
+
+    std::cout << "(" << authorized + logged + measured + handled << " calls)" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,305 @@
+#include <http/base/queue.hxx>
+
+#include <http/reactor/session.hxx>
+#include <http/basic_router.hxx>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/config.hpp>
+
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace _0xdead4ead;
+
+// Heap allocations made while a measurement is running. The replacements
+// are kept out of line, so that gcc does not pair malloc with delete
+static std::size_t allocations = 0;
+static bool counting = false;
+
+BOOST_NOINLINE void*
+operator new(std::size_t size)
+{
+    if (counting)
+        ++allocations;
+
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+BOOST_NOINLINE void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+BOOST_NOINLINE void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// Asio writes to sockets with sendmsg, this definition takes the place
+// of the one in libc to count the calls of each thread
+static thread_local std::size_t sends = 0;
+
+extern "C" ssize_t
+sendmsg(int fd, const struct msghdr* message, int flags)
+{
+    ++sends;
+    return ::syscall(SYS_sendmsg, fd, message, flags);
+}
+
+// The queue as it was, with a heap work item per response
+template<class Flesh>
+class legacy_queue
+{
+    constexpr static size_t limit = 16;
+
+    struct work
+    {
+        virtual ~work() = default;
+        virtual void operator()() = 0;
+    };
+
+    Flesh& impl_;
+    std::vector<std::unique_ptr<work>> items_;
+
+public:
+
+    explicit
+    legacy_queue(Flesh& impl)
+        : impl_(impl)
+    {
+        items_.reserve(limit);
+    }
+
+    bool
+    is_full() const
+    {
+        return items_.size() >= limit;
+    }
+
+    bool
+    on_write()
+    {
+        auto const was_full = is_full();
+        items_.erase(items_.begin());
+        if (not items_.empty())
+            (*items_.front())();
+        return was_full;
+    }
+
+    template<class Response>
+    void
+    operator()(Response& response)
+    {
+        using response_type = typename std::decay<Response>::type;
+
+        struct work_impl : work
+        {
+            Flesh& impl_;
+            response_type response_;
+
+            work_impl(Flesh& impl, response_type&& response)
+                : impl_(impl)
+                , response_(std::move(response))
+            {
+            }
+
+            void
+            operator()()
+            {
+                impl_.do_write(response_);
+            }
+        };
+
+        items_.push_back(std::unique_ptr<work_impl>(
+                             new work_impl(impl_, std::move(response))));
+        if (items_.size() == 1)
+            (*items_.front())();
+    }
+
+}; // class legacy_queue
+
+using response_type = boost::beast::http::response<boost::beast::http::string_body>;
+
+template<template<class> class Queue>
+class bench_flesh
+{
+public:
+
+    using queue_type = Queue<bench_flesh>;
+
+    std::size_t written = 0;
+
+    queue_type queue{*this};
+
+    template<class Response>
+    void
+    do_write(Response& response)
+    {
+        written += response.body().size();
+    }
+
+    void
+    do_write(http::base::write_batch& batch)
+    {
+        written += boost::asio::buffer_size(batch.buffers());
+    }
+
+}; // class bench_flesh
+
+template<class Flesh>
+using ring_queue = http::base::queue<Flesh, 16, sizeof(response_type)>;
+
+// Each connection sends its requests at once. The session answers them
+// until the queue is full, then reads again when a write completes and
+// makes room, as flesh::do_process_request and flesh::on_write do
+template<template<class> class Queue>
+static void
+run(const char* name, std::size_t connections, std::size_t pipelined)
+{
+    std::size_t written = 0;
+
+    allocations = 0;
+    counting = true;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for (std::size_t c = 0; c < connections; ++c) {
+        bench_flesh<Queue> flesh;
+
+        std::size_t requests = 0, completed = 0;
+        bool reading = true;
+
+        while (completed < pipelined) {
+            if (reading and requests < pipelined) {
+                response_type response{boost::beast::http::status::ok, 11};
+                response.body() = "pipelined";
+                flesh.queue(response);
+
+                ++requests;
+                reading = not flesh.queue.is_full();
+                continue;
+            }
+
+            ++completed;
+            if (flesh.queue.on_write())
+                reading = true;
+        }
+
+        written += flesh.written;
+    }
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+
+    counting = false;
+
+    const double responses = double(connections * pipelined);
+
+    std::cout << name << "  ns/response " << elapsed.count() / responses
+              << "  allocations/response " << double(allocations) / responses
+              << "  (" << written << " bytes)" << std::endl;
+}
+
+using http_session = http::reactor::_default::session_type;
+
+// The same, over a loopback connection, with the responses pending after
+// each write sent one by one or coalesced
+static void
+run_session(const char* name, std::size_t limit, std::size_t connections, std::size_t pipelined)
+{
+    boost::asio::io_context ioc;
+
+    http::basic_router<http_session> router{std::regex::ECMAScript};
+
+    router.get("^/$", [](auto request, auto context){
+        response_type response{boost::beast::http::status::ok, request.version()};
+        response.body() = "pipelined";
+        response.prepare_payload();
+        context.send(std::move(response));
+    });
+
+    http_session::enable_coalescing(limit);
+
+    boost::asio::ip::tcp::acceptor acceptor{ioc, {boost::asio::ip::address_v4::loopback(), 0}};
+
+    std::function<void()> accept = [&]{
+        acceptor.async_accept([&](boost::system::error_code ec, boost::asio::ip::tcp::socket socket){
+            if (ec)
+                return;
+
+            http_session::recv(std::move(socket), router);
+            accept();
+        });
+    };
+
+    accept();
+
+    std::string requests;
+    for (std::size_t i = 0; i < pipelined; ++i)
+        requests += "GET / HTTP/1.1\r\nHost: bench\r\n\r\n";
+
+    sends = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    std::thread client{[&]{
+        boost::asio::io_context client_ioc;
+
+        for (std::size_t c = 0; c < connections; ++c) {
+            boost::asio::ip::tcp::socket socket{client_ioc};
+            socket.connect(acceptor.local_endpoint());
+            boost::asio::write(socket, boost::asio::buffer(requests));
+
+            boost::beast::flat_buffer buffer;
+            for (std::size_t i = 0; i < pipelined; ++i) {
+                response_type response;
+                boost::beast::http::read(socket, buffer, response);
+            }
+        }
+
+        boost::asio::post(ioc, [&]{ acceptor.close(); });
+    }};
+
+    ioc.run();
+    client.join();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+    const double responses = double(connections * pipelined);
+
+    std::cout << name << "  sendmsg/response " << double(sends) / responses
+              << "  responses/s " << responses / elapsed.count() << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t connections = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    std::size_t pipelined = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+
+    std::cout << connections << " connections, " << pipelined
+              << " pipelined requests each, depth 16" << std::endl;
+
+    run<legacy_queue>("vector + heap work", connections, pipelined);
+    run<ring_queue>("ring + inline slots", connections, pipelined);
+
+    run_session("one by one", 0, connections / 20, pipelined);
+    run_session("coalesced ", 65536, connections / 20, pipelined);
+
+    return 0;
+}
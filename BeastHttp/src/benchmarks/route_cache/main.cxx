@@ -0,0 +1,151 @@
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace _0xdead4ead;
+
+class bench_session
+{
+public:
+
+    using self_type = bench_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class bench_session
+
+using processor_type = http::base::request_processor<bench_session>;
+
+template<class Requests>
+static void
+report(const char* name, processor_type& procs, Requests& requests, bench_session::flesh& flesh)
+{
+    std::vector<double> latency;
+    latency.reserve(requests.size());
+
+    for (auto& request : requests) {
+        auto begin = std::chrono::steady_clock::now();
+        procs.provide(request, flesh);
+        latency.push_back(std::chrono::duration<double, std::nano>(
+                              std::chrono::steady_clock::now() - begin).count());
+    }
+
+    std::sort(latency.begin(), latency.end());
+
+    std::cout << name
+              << "  p50 " << latency[latency.size() / 2]
+              << "  p99 " << latency[latency.size() * 99 / 100]
+              << "  hits " << processor_type::cache().hits()
+              << "  misses " << processor_type::cache().misses() << std::endl;
+}
+
+// 200 routes, of which 20 targets take 90% of the requests
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    std::size_t capacity = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+
+    std::size_t handled = 0;
+
+    auto handler = [&](bench_session::request_type& /*request*/, bench_session::context_type){
+        ++handled;
+    };
+
+    http::basic_router<bench_session> router{std::regex::ECMAScript};
+
+    std::vector<std::string> hot, cold;
+    for (std::size_t i = 0; i < 100; ++i) {
+        const std::string name = "/api/resource" + std::to_string(i);
+        router.get("^" + name + "$", handler);
+        router.get("^" + name + "/(\\d+)$", handler);
+
+        (i < 20 ? hot : cold).push_back(name);
+        cold.push_back(name + "/" + std::to_string(i * 7919));
+    }
+
+    std::mt19937 random{42};
+    std::uniform_int_distribution<std::size_t> percent{0, 99};
+
+    std::vector<bench_session::request_type> requests;
+    requests.reserve(iterations);
+    for (std::size_t n = 0; n < iterations; ++n) {
+        auto const& targets = percent(random) < 90 ? hot : cold;
+        requests.emplace_back(boost::beast::http::verb::get,
+                              targets[random() % targets.size()], 11);
+    }
+
+    bench_session::flesh flesh;
+
+    processor_type procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::cout << "dispatch latency ns (200 routes, capacity " << capacity << ")" << std::endl;
+
+    processor_type::enable_cache(0);
+    report("cache off", procs, requests, flesh);
+
+    processor_type::enable_cache(capacity);
+    report("cache on ", procs, requests, flesh);
+
+    std::cout << "(" << handled << " handled)" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/radix_map.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+#include <http/route_table.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace _0xdead4ead;
+using namespace http::literals;
+
+template<template<class, class, class...> class ResourceMap>
+class bench_session
+{
+public:
+
+    using self_type = bench_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = ResourceMap<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class bench_session
+
+template<class F>
+static double
+measure(std::size_t iterations, F&& f)
+{
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+        f(n);
+
+    return std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - begin).count() / double(iterations);
+}
+
+#define BENCH_PATHS(X) \
+    X("/") X("/health") X("/metrics") X("/login") X("/logout") X("/signup") \
+    X("/api/users") X("/api/orders") X("/api/items") X("/api/carts") \
+    X("/api/payments") X("/api/invoices") X("/api/reports") X("/api/search") \
+    X("/api/settings") X("/api/profile") X("/api/sessions") X("/api/tokens") \
+    X("/api/teams") X("/api/projects") X("/api/tasks") X("/api/comments") \
+    X("/api/files") X("/api/events") X("/api/webhooks") X("/api/audit") \
+    X("/admin") X("/admin/users") X("/admin/logs") X("/docs") X("/about") X("/contact")
+
+#define BENCH_LITERAL(path) path ## _get,
+#define BENCH_STRING(path) path,
+
+// Literal routes only, resolved by the runtime maps and by a route_table
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+
+    static constexpr auto routes = http::make_route_index(BENCH_PATHS(BENCH_LITERAL) "/favicon.ico"_get);
+
+    std::vector<std::string> paths{BENCH_PATHS(BENCH_STRING) "/favicon.ico"};
+
+    std::size_t handled = 0;
+
+    auto handler = [&](auto& /*request*/, auto /*context*/){
+        ++handled;
+    };
+
+    http::basic_router<bench_session<std::unordered_map>> regex{std::regex::ECMAScript};
+    http::basic_router<bench_session<http::base::radix_map>> radix{std::regex::ECMAScript};
+
+    for (auto const& path : paths) {
+        regex.get("^" + path + "$", handler);
+        radix.get(path, handler);
+    }
+
+    auto table = http::make_route_index("/unused"_get).bind(radix, handler);
+
+    std::vector<bench_session<http::base::radix_map>::request_type> requests;
+    for (auto const& path : paths)
+        requests.emplace_back(boost::beast::http::verb::get, path, 11);
+
+    std::cout << "dispatch  ns/req (" << paths.size() << " literal routes)" << std::endl;
+
+    {
+        http::base::request_processor<bench_session<std::unordered_map>>
+                procs{regex.resource_map(), regex.method_map(), regex.regex_flags()};
+        bench_session<std::unordered_map>::flesh flesh;
+
+        std::vector<bench_session<std::unordered_map>::request_type> copies{
+            requests.begin(), requests.end()};
+
+        std::cout << "regex scan  " << measure(iterations / 10, [&](std::size_t n){
+            procs.provide(copies[n % copies.size()], flesh);
+        }) << std::endl;
+    }
+
+    bench_session<http::base::radix_map>::flesh flesh;
+
+    {
+        http::base::request_processor<bench_session<http::base::radix_map>>
+                procs{radix.resource_map(), radix.method_map(), radix.regex_flags()};
+
+        std::cout << "radix_map  " << measure(iterations, [&](std::size_t n){
+            procs.provide(requests[n % requests.size()], flesh);
+        }) << std::endl;
+    }
+
+    {
+        auto literal = routes.bind(radix, handler, handler, handler, handler, handler, handler,
+                                   handler, handler, handler, handler, handler, handler,
+                                   handler, handler, handler, handler, handler, handler,
+                                   handler, handler, handler, handler, handler, handler,
+                                   handler, handler, handler, handler, handler, handler,
+                                   handler, handler, handler);
+
+        std::cout << "route_table  " << measure(iterations, [&](std::size_t n){
+            literal.provide(requests[n % requests.size()], flesh);
+        }) << std::endl;
+    }
+
+    // The same targets when none of them is literal in the table
+    std::cout << "route_table miss + radix_map  " << measure(iterations, [&](std::size_t n){
+        table.provide(requests[n % requests.size()], flesh);
+    }) << std::endl;
+
+    std::cout << "(" << handled << " handled)" << std::endl;
+
+    return 0;
+}
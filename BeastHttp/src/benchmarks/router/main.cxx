@@ -0,0 +1,313 @@
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+#include <http/param.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace _0xdead4ead;
+
+// Heap allocations made while a measurement is running. The replacements
+// are kept out of line, so that gcc does not pair malloc with delete
+static std::size_t allocations = 0;
+static bool counting = false;
+
+BOOST_NOINLINE void*
+operator new(std::size_t size)
+{
+    if (counting)
+        ++allocations;
+
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+BOOST_NOINLINE void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+BOOST_NOINLINE void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+class test_session
+{
+public:
+
+    using self_type = test_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class test_session
+
+using router_type = http::basic_router<test_session>;
+
+using processor_type = http::base::request_processor<test_session>;
+
+static std::size_t handled = 0;
+
+struct scenario
+{
+    const char* kind;
+    std::size_t routes;
+    std::size_t chain;
+    double hit_ratio;
+};
+
+// Every handler but the last passes the request on
+template<std::size_t>
+static auto
+link()
+{
+    return [](test_session::request_type&, test_session::context_type, auto next){
+        std::next(next)();
+    };
+}
+
+template<std::size_t... I>
+static void
+add_chain(router_type& router, std::string const& path, std::index_sequence<I...>)
+{
+    router.get(path, link<I>()...,
+               [](test_session::request_type&, test_session::context_type){
+        ++handled;
+    });
+}
+
+static void
+add_route(router_type& router, scenario const& s, std::size_t i)
+{
+    const std::string name = "/resource" + std::to_string(i);
+
+    if (s.kind == std::string{"param"}) {
+        router.param<http::param::pack<int>>().get("^" + name + "/(\\d+)$",
+           [](test_session::request_type&, test_session::context_type, auto /*args*/){
+            ++handled;
+        });
+        return;
+    }
+
+    const std::string path = s.kind == std::string{"literal"}
+            ? "^" + name + "/item$" : "^" + name + "/(\\d+)$";
+
+    switch (s.chain) {
+    case 1: add_chain(router, path, std::make_index_sequence<0>{}); break;
+    case 2: add_chain(router, path, std::make_index_sequence<1>{}); break;
+    case 4: add_chain(router, path, std::make_index_sequence<3>{}); break;
+    case 8: add_chain(router, path, std::make_index_sequence<7>{}); break;
+    default: std::abort();
+    }
+}
+
+static std::string
+hit_target(scenario const& s, std::size_t i)
+{
+    const std::string name = "/resource" + std::to_string(i);
+    return s.kind == std::string{"literal"} ? name + "/item" : name + "/" + std::to_string(i * 7919);
+}
+
+// Prints one JSON object for the scenario
+static void
+run(scenario const& s, std::size_t budget, bool first)
+{
+    router_type router{std::regex::ECMAScript};
+    for (std::size_t i = 0; i < s.routes; ++i)
+        add_route(router, s, i);
+
+    // Misses walk every route, so the budget is spent in route visits
+    const std::size_t iterations = std::max<std::size_t>(budget / s.routes, 100);
+
+    std::vector<test_session::request_type> requests;
+    requests.reserve(100);
+    for (std::size_t n = 0; n < 100; ++n) {
+        const bool hit = n < std::size_t(s.hit_ratio * 100 + 0.5);
+        const std::size_t i = (n * 7919) % s.routes;
+        requests.emplace_back(boost::beast::http::verb::get,
+                              hit ? hit_target(s, i) : "/missing" + std::to_string(i) + "/item", 11);
+    }
+
+    test_session::flesh flesh;
+    processor_type procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    for (std::size_t n = 0; n < requests.size(); ++n)
+        procs.provide(requests[n], flesh);
+
+    allocations = 0;
+    counting = true;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+        procs.provide(requests[n % requests.size()], flesh);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+
+    counting = false;
+
+    std::cout << (first ? "\n" : ",\n")
+              << "    {\"kind\": \"" << s.kind << "\""
+              << ", \"routes\": " << s.routes
+              << ", \"chain\": " << s.chain
+              << ", \"hit_ratio\": " << s.hit_ratio
+              << ", \"iterations\": " << iterations
+              << ", \"ns_per_request\": " << elapsed.count() / iterations
+              << ", \"allocations_per_request\": " << double(allocations) / iterations
+              << "}" << std::flush;
+}
+
+// Walks the route patterns until one matches each target, as the request
+// processor does: "rebuilt" builds every regex on each call, as routes did
+// before they were compiled at registration, "compiled" matches the
+// automatons built once. Prints one JSON object per matcher
+static void
+match(std::size_t routes, std::size_t budget)
+{
+    http::base::regex regex{std::regex::ECMAScript};
+
+    std::vector<std::string> patterns;
+    std::vector<http::base::regex::compiled_type> compiled;
+    for (std::size_t i = 0; i < routes; ++i) {
+        patterns.push_back("^/resource" + std::to_string(i) + "/(\\d+)$");
+        compiled.push_back(regex.compile(patterns.back()));
+    }
+
+    std::vector<std::string> targets;
+    for (std::size_t n = 0; n < 100; ++n) {
+        const std::size_t i = (n * 7919) % routes;
+        targets.push_back("/resource" + std::to_string(i) + "/" + std::to_string(i * 7919));
+    }
+
+    auto measure = [&](const char* matcher, std::size_t iterations, auto&& matches){
+        std::size_t matched = 0;
+
+        auto begin = std::chrono::steady_clock::now();
+        for (std::size_t n = 0; n < iterations; ++n) {
+            std::string const& target = targets[n % targets.size()];
+            for (std::size_t i = 0; i < routes; ++i)
+                if (matches(i, target)) {
+                    ++matched;
+                    break;
+                }
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+
+        std::cout << ",\n    {\"kind\": \"match\", \"matcher\": \"" << matcher << "\""
+                  << ", \"routes\": " << routes
+                  << ", \"iterations\": " << iterations
+                  << ", \"ns_per_request\": " << elapsed.count() / iterations
+                  << ", \"matched\": " << matched
+                  << "}" << std::flush;
+    };
+
+    // Building a regex costs a hundred times a match, or more
+    measure("rebuilt", std::max<std::size_t>(budget / routes / 100, 10),
+            [&](std::size_t i, std::string const& target){
+        return regex.match(patterns[i], target);
+    });
+
+    measure("compiled", std::max<std::size_t>(budget / routes, 100),
+            [&](std::size_t i, std::string const& target){
+        return regex.match(compiled[i], boost::beast::string_view{target});
+    });
+}
+
+// Usage: router_benchmark [budget]
+//
+// The results go to stdout as a single JSON document, one object per
+// scenario: route kind (literal, regex or param), route count, handlers
+// per route, share of targets that match a route. The "match" objects
+// compare a regex built on each call with one compiled at registration,
+// for 10, 100 and 1000 routes
+int main(int argc, char* argv[])
+{
+    std::size_t budget = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    std::vector<scenario> scenarios;
+
+    for (const char* kind : {"literal", "regex", "param"})
+        for (std::size_t routes : {1, 10, 100, 1000, 5000})
+            for (double hit_ratio : {1.0, 0.5, 0.0})
+                scenarios.push_back({kind, routes, 1, hit_ratio});
+
+    for (const char* kind : {"literal", "regex"})
+        for (std::size_t chain : {2, 4, 8})
+            scenarios.push_back({kind, 100, chain, 1.0});
+
+    std::cout << "{\n  \"benchmark\": \"router\",\n  \"budget\": " << budget
+              << ",\n  \"results\": [";
+
+    bool first = true;
+    for (auto const& s : scenarios) {
+        run(s, budget, first);
+        first = false;
+    }
+
+    for (std::size_t routes : {10, 100, 1000})
+        match(routes, budget);
+
+    std::cout << "\n  ],\n  \"handled\": " << handled << "\n}" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <http/reactor/session.hxx>
+#include <http/basic_router.hxx>
+
+#include <boost/asio/io_context.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+
+using namespace _0xdead4ead;
+
+using http_session = http::reactor::_default::session_type;
+
+// Sessions are made and released in waves of `live` connections, as an
+// I/O thread accepting and closing them does
+static double
+churn(boost::asio::io_context& ioc, http::basic_router<http_session> const& router,
+      std::size_t iterations, std::size_t live)
+{
+    std::deque<http_session::context_type> sessions;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for (std::size_t n = 0; n < iterations; ++n) {
+        sessions.push_back(http_session::make(boost::asio::ip::tcp::socket{ioc}, router));
+        if (sessions.size() > live)
+            sessions.pop_front();
+    }
+
+    sessions.clear();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+    return double(iterations) / elapsed.count();
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    std::size_t live = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+
+    boost::asio::io_context ioc;
+
+    http::basic_router<http_session> router{std::regex::ECMAScript};
+
+    std::cout << "sessions/s (" << live << " alive at once, flesh of "
+              << sizeof(http_session::flesh_type) << " bytes)" << std::endl;
+
+    std::cout << "pool off  " << churn(ioc, router, iterations, live) << std::endl;
+
+    http_session::enable_pool(live * 2);
+
+    std::cout << "pool on   " << churn(ioc, router, iterations, live) << std::endl;
+
+    std::cout << "hits " << http_session::pool().hits()
+              << "  misses " << http_session::pool().misses()
+              << "  pooled " << http_session::pool().size() << std::endl;
+
+    return 0;
+}
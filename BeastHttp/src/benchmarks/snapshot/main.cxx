@@ -0,0 +1,148 @@
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/lockable.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+
+using namespace _0xdead4ead;
+
+class bench_session
+{
+public:
+
+    using self_type = bench_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class bench_session
+
+using router_type = http::basic_router<bench_session>;
+
+using processor_type = http::base::request_processor<bench_session>;
+
+// Every reader resolves the same request in a loop, as sessions do in
+// do_process_request(), either under the router read lock or lock free.
+static double
+run(router_type& router, std::size_t threads, std::size_t iterations, bool snapshot)
+{
+    std::atomic<std::size_t> ready{0};
+    std::atomic<bool> start{false};
+    std::vector<std::thread> readers;
+
+    for (std::size_t i = 0; i < threads; ++i)
+        readers.emplace_back([&](){
+            processor_type procs = snapshot
+                    ? processor_type{router.resource_map(), router.method_map(),
+                                     router.regex_flags(), router.snapshot()}
+                    : processor_type{router.resource_map(), router.method_map(),
+                                     router.regex_flags()};
+
+            bench_session::request_type request{boost::beast::http::verb::get, "/", 11};
+            bench_session::flesh flesh;
+
+            ++ready;
+            while (not start)
+                std::this_thread::yield();
+
+            for (std::size_t n = 0; n < iterations; ++n)
+                if (procs.lock_free())
+                    procs.provide(request, flesh);
+                else {
+                    auto const lock = http::base::lockable::enter_to_read(router.mutex());
+                    procs.provide(request, flesh);
+                }
+        });
+
+    while (ready != threads)
+        std::this_thread::yield();
+
+    auto begin = std::chrono::steady_clock::now();
+    start = true;
+
+    for (auto& reader : readers)
+        reader.join();
+
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    return std::chrono::duration<double, std::nano>(elapsed).count()
+            / double(threads * iterations);
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+
+    router_type locked{std::regex::ECMAScript}, published{std::regex::ECMAScript};
+
+    for (auto router : {&locked, &published})
+        router->get("^/$", [](auto /*request*/, auto /*context*/){});
+
+    published.enable_snapshot();
+
+    std::size_t max_threads = std::max(8u, std::thread::hardware_concurrency());
+
+    std::cout << "threads  lockable ns/req  snapshot ns/req" << std::endl;
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2)
+        std::cout << threads << "  "
+                  << run(locked, threads, iterations, false) << "  "
+                  << run(published, threads, iterations, true) << std::endl;
+
+    return 0;
+}
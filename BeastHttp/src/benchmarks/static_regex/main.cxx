@@ -0,0 +1,204 @@
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/static_regex.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace _0xdead4ead;
+using namespace http::literals;
+
+template<class Regex>
+class bench_session
+{
+public:
+
+    using self_type = bench_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = Regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class bench_session
+
+template<class F>
+static double
+measure(std::size_t iterations, F&& f)
+{
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+        f(n);
+
+    return std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - begin).count() / double(iterations);
+}
+
+#define BENCH_ROUTES(X) \
+    X("^/$") X("^/health$") X("^/login$") X("^/logout$") \
+    X("^/api/users$") X("^/api/users/(\\d+)$") X("^/api/users/(\\d+)/orders$") \
+    X("^/api/orders/(\\d+)$") X("^/api/items/([^/]+)$") X("^/api/search$") \
+    X("^/static/(.*)$") X("^/docs/([a-z]+)\\.html$")
+
+#define BENCH_RUNTIME(pattern) router.get(pattern, handler);
+#define BENCH_STATIC(pattern) router.get(pattern ## _re, handler);
+
+static bool
+digits(boost::beast::string_view s)
+{
+    if (s.empty())
+        return false;
+
+    for (char c : s)
+        if (c < '0' or c > '9')
+            return false;
+
+    return true;
+}
+
+// The same routes written by hand, as a lower bound
+template<class F>
+static void
+hand_written(boost::beast::string_view target, F&& f)
+{
+    using string_view = boost::beast::string_view;
+
+    if (target == "/" or target == "/health" or target == "/login" or target == "/logout"
+            or target == "/api/users" or target == "/api/search")
+        return f();
+
+    if (target.starts_with("/api/users/")) {
+        string_view rest = target.substr(11);
+        const auto slash = rest.find('/');
+        if (slash == string_view::npos ? digits(rest)
+                : digits(rest.substr(0, slash)) and rest.substr(slash) == "/orders")
+            return f();
+    }
+
+    if (target.starts_with("/api/orders/") and digits(target.substr(12)))
+        return f();
+
+    if (target.starts_with("/api/items/") and target.size() > 11
+            and target.substr(11).find('/') == string_view::npos)
+        return f();
+
+    if (target.starts_with("/static/"))
+        return f();
+
+    if (target.starts_with("/docs/") and target.ends_with(".html") and target.size() > 11) {
+        for (char c : target.substr(6, target.size() - 11))
+            if (c < 'a' or c > 'z')
+                return;
+        return f();
+    }
+}
+
+template<class Regex, class Register>
+static double
+dispatch(std::vector<std::string> const& targets, std::size_t iterations,
+         std::size_t& handled, Register&& add)
+{
+    using session_type = bench_session<Regex>;
+
+    http::basic_router<session_type> router{std::regex::ECMAScript};
+    add(router, [&handled](typename session_type::request_type&, typename session_type::context_type){
+        ++handled;
+    });
+
+    std::vector<typename session_type::request_type> requests;
+    for (auto const& target : targets)
+        requests.emplace_back(boost::beast::http::verb::get, target, 11);
+
+    typename session_type::flesh flesh;
+    http::base::request_processor<session_type>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    return measure(iterations, [&](std::size_t n){
+        procs.provide(requests[n % requests.size()], flesh);
+    });
+}
+
+// 12 routes of literal patterns, every target matching one of them
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+
+    const std::vector<std::string> targets{
+        "/", "/health", "/login", "/logout", "/api/users", "/api/users/42",
+        "/api/users/42/orders", "/api/orders/1001", "/api/items/book", "/api/search",
+        "/static/css/site.css", "/docs/index.html"};
+
+    std::size_t handled = 0;
+
+    std::cout << "dispatch  ns/req (12 routes)" << std::endl;
+
+    std::cout << "base::regex  " << dispatch<http::base::regex>(
+                     targets, iterations / 10, handled, [](auto& router, auto handler){
+        BENCH_ROUTES(BENCH_RUNTIME)
+    }) << std::endl;
+
+    std::cout << "static_regex  " << dispatch<http::base::static_regex>(
+                     targets, iterations, handled, [](auto& router, auto handler){
+        BENCH_ROUTES(BENCH_STATIC)
+    }) << std::endl;
+
+    std::cout << "hand-written  " << measure(iterations, [&](std::size_t n){
+        hand_written(targets[n % targets.size()], [&handled]{ ++handled; });
+    }) << std::endl;
+
+    std::cout << "(" << handled << " handled)" << std::endl;
+
+    return 0;
+}
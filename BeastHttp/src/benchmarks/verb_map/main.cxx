@@ -0,0 +1,152 @@
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/request_processor.hxx>
+#include <http/base/verb_map.hxx>
+
+#include <http/basic_router.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <unordered_map>
+
+using namespace _0xdead4ead;
+
+template<template<class, class, class...> class MethodMap>
+class bench_session
+{
+public:
+
+    using self_type = bench_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = MethodMap<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class bench_session
+
+
+using verb = boost::beast::http::verb;
+
+static const std::vector<verb> requested{
+    verb::get, verb::post, verb::get, verb::put, verb::delete_, verb::get,
+    verb::patch, verb::head, verb::options, verb::trace, verb::connect, verb::get};
+
+template<class Clock = std::chrono::steady_clock, class F>
+static double
+measure(std::size_t iterations, F&& f)
+{
+    auto begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+        f(n);
+
+    return std::chrono::duration<double, std::nano>(Clock::now() - begin).count()
+            / double(iterations);
+}
+
+// Cost of the method lookup alone, and of a whole provide() call with one
+// literal route per registered verb
+template<template<class, class, class...> class MethodMap>
+static void
+run(const char* name, std::size_t iterations)
+{
+    using session_type = bench_session<MethodMap>;
+
+    http::basic_router<session_type> router{std::regex::ECMAScript};
+
+    auto handler = [](auto /*request*/, auto /*context*/){};
+    router.get("^/$", handler);
+    router.post("^/$", handler);
+    router.put("^/$", handler);
+    router.delete_("^/$", handler);
+    router.patch("^/$", handler);
+    router.head("^/$", handler);
+    router.options("^/$", handler);
+
+    http::base::request_processor<session_type>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<typename session_type::request_type> requests;
+    for (auto method : requested)
+        requests.emplace_back(method, "/", 11);
+
+    typename session_type::flesh flesh;
+
+    auto const& method_map = static_cast<typename session_type::method_map_type const&>(
+                *router.method_map());
+
+    std::size_t found = 0;
+    double find = measure(iterations * 100, [&](std::size_t n){
+        found += method_map.find(requested[n % requested.size()]) != method_map.cend();
+    });
+
+    double provide = measure(iterations, [&](std::size_t n){
+        procs.provide(requests[n % requests.size()], flesh);
+    });
+
+    std::cout << name << "  " << find << "  " << provide
+              << "  (" << found << " hits)" << std::endl;
+}
+
+template<class Key, class Value, class... Args>
+using unordered_map = std::unordered_map<Key, Value>;
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+
+    std::cout << "method map  find ns  provide ns/req" << std::endl;
+
+    run<std::map>("std::map", iterations);
+    run<unordered_map>("std::unordered_map", iterations);
+    run<http::base::verb_map>("base::verb_map", iterations);
+
+    return 0;
+}
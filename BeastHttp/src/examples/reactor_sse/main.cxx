@@ -2,10 +2,12 @@
 #include <http/reactor/session.hxx>
 
 #include <http/basic_router.hxx>
+#include <http/hub.hxx>
 #include <http/out.hxx>
 
 #include <boost/asio/posix/stream_descriptor.hpp>
 #include <boost/asio/signal_set.hpp>
+#include <boost/asio/steady_timer.hpp>
 
 #include <thread>
 
@@ -44,6 +46,7 @@ auto make_404(const beast::http::request<RequestBody>& request,
 static boost::asio::io_context ioc;
 static boost::asio::posix::stream_descriptor out{ioc, ::dup(STDERR_FILENO)};
 static boost::asio::signal_set sig_set(ioc, SIGINT, SIGTERM);
+static boost::asio::steady_timer timer{ioc};
 
 int main()
 {
@@ -54,10 +57,14 @@ int main()
 
     http::basic_router<http_session> router{std::regex::ECMAScript};
 
+    // Every event is serialized once, for all the clients subscribed
+    http::hub<http_session> hub;
+
     // Set router targets
-    router.get(R"(^/sse$)", [](auto /*beast_http_request*/, auto context) {
-        // Begin send server event after one seconds
-        context.wait(std::chrono::seconds(1));
+    router.get(R"(^/sse$)", [&hub](auto /*beast_http_request*/, auto context) {
+        // Receive the events until the client goes away
+        hub.subscribe(context);
+        context.recv();
     });
 
     router.all(R"(^.*$)", [](auto beast_http_request, auto context) {
@@ -75,21 +82,24 @@ int main()
             ioc.stop();
     };
 
-    // Timer expire handler
-    auto onTimer = [i = 0](auto context) mutable {
-        if (i++ < 5) {
-            std::ostringstream os;
-            os << "event: datetime\ndata: " << boost::posix_time::second_clock::local_time() << " id = " << i << "\n\n";
-
-            // Send event every 3 seconds or so forever...
-            context.push(make_200event<beast::http::string_body>(os.str(), 11));
-            context.wait(std::chrono::seconds(3));
+    // Publish an event every 3 seconds or so forever...
+    std::size_t id = 0;
+    std::function<void(boost::system::error_code)> onPublish = [&](boost::system::error_code ec) {
+        if (ec)
             return;
-        }
 
-        context.eof();
+        std::ostringstream os;
+        os << "event: datetime\ndata: " << boost::posix_time::second_clock::local_time() << " id = " << ++id << "\n\n";
+
+        hub.publish(make_200event<beast::http::string_body>(os.str(), 11));
+
+        timer.expires_after(std::chrono::seconds(3));
+        timer.async_wait(onPublish);
     };
 
+    timer.expires_after(std::chrono::seconds(1));
+    timer.async_wait(onPublish);
+
     // Handler incoming connections
     const auto& onAccept = [&](auto asio_socket) {
         auto endpoint = asio_socket.remote_endpoint();
@@ -98,7 +108,7 @@ int main()
                     out, endpoint.address().to_string() + ':' + std::to_string(endpoint.port()), "connected!");
 
         // Start receive HTTP request
-        http_session::recv(std::move(asio_socket), router, onError, onTimer);
+        http_session::recv(std::move(asio_socket), router, onError);
     };
 
     auto const address = boost::asio::ip::address_v4::any();
@@ -114,6 +124,7 @@ int main()
     sig_set.async_wait([](boost::system::error_code const&, int sig) {
         http::out::prefix::version::time::pushn<std::ostream>(
                     out, "Capture", sig == SIGINT ? "SIGINT." : "SIGTERM.", "Stop!");
+        timer.cancel();
         ioc.stop();
     });
 
@@ -0,0 +1,331 @@
+#define BOOST_TEST_MODULE allocation_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/radix_map.hxx>
+#include <http/base/verb_map.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <cstdlib>
+#include <new>
+
+using namespace _0xdead4ead;
+
+// Heap allocations made by the library while counting is on
+static std::size_t allocations = 0;
+static bool counting = false;
+
+void*
+operator new(std::size_t size)
+{
+    if (counting)
+        ++allocations;
+
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// The message keeps its own allocator, so that rewriting the target and
+// copying the request for by-value handlers are counted apart from routing
+static std::size_t message_allocations = 0;
+
+template<class T>
+struct message_allocator
+{
+    using value_type = T;
+
+    message_allocator() = default;
+
+    template<class U>
+    message_allocator(message_allocator<U> const&)
+    {
+    }
+
+    T*
+    allocate(std::size_t n)
+    {
+        if (counting)
+            ++message_allocations;
+
+        return static_cast<T*>(std::malloc(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T* p, std::size_t)
+    {
+        std::free(p);
+    }
+
+    friend bool
+    operator==(message_allocator const&, message_allocator const&)
+    {
+        return true;
+    }
+
+    friend bool
+    operator!=(message_allocator const&, message_allocator const&)
+    {
+        return false;
+    }
+};
+
+class test_session
+{
+public:
+
+    using self_type = test_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using fields_type = boost::beast::http::basic_fields<message_allocator<char>>;
+
+    using request_type = boost::beast::http::request<body_type, fields_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = http::base::radix_map<resource_regex_type, route_type>;
+
+    using method_map_type = http::base::verb_map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class test_session
+
+static const std::regex::flag_type regex_flags = std::regex::ECMAScript;
+
+BOOST_AUTO_TEST_CASE(chain_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<std::string> seen;
+    seen.reserve(16);
+
+    router.get("/customers/1234567/orders/98765/shipping",
+       [&](auto request, auto /*context*/, auto _1x){
+        seen.emplace_back(request.target().data(), request.target().size());
+        std::next(_1x)();
+    }, [&](auto request, auto /*context*/, auto _2x){
+        seen.emplace_back(request.target().data(), request.target().size());
+        std::next(_2x)();
+    }, [&](auto request, auto /*context*/, auto _3x){
+        seen.emplace_back(request.target().data(), request.target().size());
+        std::next(_3x)();
+    }, [&](auto request, auto /*context*/, auto _4x){
+        seen.emplace_back(request.target().data(), request.target().size());
+        std::next(_4x)();
+    }, [&](auto request, auto /*context*/){
+        seen.emplace_back(request.target().data(), request.target().size());
+    });
+
+    test_session::request_type request{boost::beast::http::verb::get,
+                "/customers/1234567/orders/98765/shipping", 11};
+    test_session::flesh flesh;
+
+    auto warm = request;
+    procs.provide(warm, flesh);
+
+    BOOST_CHECK((seen == std::vector<std::string>{
+                     "/customers", "/1234567", "/orders", "/98765", "/shipping"}));
+
+    seen.clear();
+    allocations = message_allocations = 0;
+
+    counting = true;
+    procs.provide(request, flesh);
+    counting = false;
+
+    BOOST_CHECK_EQUAL(seen.size(), 5);
+    BOOST_CHECK_EQUAL(allocations, 0);
+    BOOST_TEST_MESSAGE("message allocations: " << message_allocations);
+
+} // BOOST_AUTO_TEST_CASE(chain_no_1)
+
+BOOST_AUTO_TEST_CASE(slices_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<boost::beast::string_view> slices;
+    slices.reserve(16);
+
+    router.get("/customers/1234567/orders/42",
+       [&](auto& /*request*/, auto /*context*/, auto _1x){
+        slices.push_back(_1x.target());
+        std::next(_1x)();
+    }, [&](auto& /*request*/, auto /*context*/, auto _2x){
+        slices.push_back(_2x.target());
+        auto copy = std::next(_2x);
+        copy();
+    }, [&](auto& /*request*/, auto /*context*/, auto _3x){
+        slices.push_back(_3x.target());
+        std::next(_3x)();
+    }, [&](auto& request, auto /*context*/){
+        BOOST_CHECK(request.target() == "/42");
+
+        // Every hop, through any copy of the iterator, walks one copy of the target
+        BOOST_REQUIRE_EQUAL(slices.size(), 3);
+        BOOST_CHECK(slices[0] == "/customers");
+        BOOST_CHECK(slices[1] == "/1234567");
+        BOOST_CHECK(slices[2] == "/orders");
+        BOOST_CHECK(slices[1].data() == slices[0].data() + slices[0].size());
+        BOOST_CHECK(slices[2].data() == slices[1].data() + slices[1].size());
+    });
+
+    test_session::request_type request{boost::beast::http::verb::get,
+                "/customers/1234567/orders/42", 11};
+    test_session::flesh flesh;
+
+    procs.provide(request, flesh);
+    BOOST_CHECK_EQUAL(slices.size(), 3);
+
+} // BOOST_AUTO_TEST_CASE(slices_no_1)
+
+BOOST_AUTO_TEST_CASE(fallback_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::size_t invoked = 0;
+
+    router.get("/customers/:id/orders", [&](auto /*request*/, auto /*context*/){
+        ++invoked;
+    });
+
+    router.all("/customers/:id/orders", [&](auto /*request*/, auto /*context*/){
+        invoked += 10;
+    });
+
+    test_session::request_type get{boost::beast::http::verb::get,
+                "/customers/1234567/orders", 11};
+    test_session::request_type post{boost::beast::http::verb::post,
+                "/customers/1234567/orders", 11};
+    test_session::flesh flesh;
+
+    procs.provide(get, flesh);
+
+    allocations = 0;
+
+    counting = true;
+    procs.provide(get, flesh);
+    procs.provide(post, flesh);
+    counting = false;
+
+    BOOST_CHECK_EQUAL(invoked, 12);
+    BOOST_CHECK_EQUAL(allocations, 0);
+
+} // BOOST_AUTO_TEST_CASE(fallback_no_1)
+
+BOOST_AUTO_TEST_CASE(by_reference_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<test_session::request_type const*> seen;
+    seen.reserve(16);
+
+    router.post("^/upload$",
+       [&](auto& request, auto /*context*/, auto _1x){
+        seen.push_back(&request);
+        std::next(_1x)();
+    }, [&](auto& request, auto /*context*/, auto _2x){
+        seen.push_back(&request);
+        std::next(_2x)();
+    }, [&](auto& request, auto /*context*/, auto _3x){
+        seen.push_back(&request);
+        std::next(_3x)();
+    }, [&](auto& request, auto /*context*/, auto _4x){
+        seen.push_back(&request);
+        std::next(_4x)();
+    }, [&](auto& request, auto /*context*/){
+        seen.push_back(&request);
+    });
+
+    test_session::request_type request{boost::beast::http::verb::post, "/upload", 11};
+    request.body().assign(1024 * 1024, 'x');
+    request.prepare_payload();
+    test_session::flesh flesh;
+
+    procs.provide(request, flesh);
+
+    seen.clear();
+    allocations = 0;
+
+    counting = true;
+    procs.provide(request, flesh);
+    counting = false;
+
+    // Every handler sees the session's request, the body is never copied
+    // (string_body allocates through the global operator new)
+    BOOST_CHECK_EQUAL(seen.size(), 5);
+    for (auto address : seen)
+        BOOST_CHECK(address == &request);
+
+    BOOST_CHECK_EQUAL(allocations, 0);
+
+} // BOOST_AUTO_TEST_CASE(by_reference_no_1)
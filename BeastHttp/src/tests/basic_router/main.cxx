@@ -5,8 +5,13 @@
 
 #include <http/base/cb.hxx>
 #include <http/base/regex.hxx>
+#include <http/base/route.hxx>
 #include <http/base/request_processor.hxx>
 
+#ifdef BEASTHTTP_TEST_DFA_REGEX
+#include "../dfa_regex/checked_regex.hxx"
+#endif // BEASTHTTP_TEST_DFA_REGEX
+
 #include <http/literals.hxx>
 #include <http/basic_router.hxx>
 
@@ -43,13 +48,19 @@ public:
 
     using request_type = boost::beast::http::request<body_type>;
 
+#ifdef BEASTHTTP_TEST_DFA_REGEX
+    using regex_type = checked_regex;
+#else
     using regex_type = http::base::regex;
+#endif // BEASTHTTP_TEST_DFA_REGEX
 
     using regex_flag_type = typename regex_type::flag_type;
 
     using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
 
-    using resource_map_type = std::unordered_map<resource_regex_type, storage_type>;
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
 
     using method_map_type = std::map<method_type, resource_map_type>;
 
@@ -804,3 +815,125 @@ BOOST_AUTO_TEST_CASE(literals_no_1) {
     procs.provide({boost::beast::http::verb::get, "/a/b", 11}, test_session::flesh{});
 
 } // BOOST_AUTO_TEST_CASE(literals_no_1)
+
+BOOST_AUTO_TEST_CASE(mount_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+    http::basic_router<test_session> api{regex_flags};
+    http::basic_router<test_session> users{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<std::string> calls;
+
+    auto record = [&calls](std::string name){
+        return [&calls, name](auto request, auto /*context*/){
+            calls.push_back(name + " " + std::string{request.target()});
+        };
+    };
+
+    users.get("^/(\\d+)$", record("user"));
+    users.all("^[/]??$", record("users"));
+
+    api.mount("^/users$", users);
+    router.mount("/api/", api);
+
+    router.get("^/api/version$", record("version"));
+
+    // A route added after mounting is seen by the parent
+    api.get("^/health$", record("health"));
+
+    procs.provide({boost::beast::http::verb::get, "/api/users/42", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::post, "/api/users", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/api/users/", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/api/health", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/api/version", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/apiusers/1", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/api/users/x", 11}, test_session::flesh{});
+
+    BOOST_CHECK((calls == std::vector<std::string>{
+                     "user /42", "users ", "users /", "health /health", "version /api/version"}));
+
+    // Flattening a router with mounts keeps them mounted
+    http::basic_router<test_session> flat{regex_flags};
+
+    http::base::request_processor<test_session>
+            flat_procs{flat.resource_map(), flat.method_map(), flat.regex_flags()};
+
+    flat.use("^/v1$", router);
+    BOOST_CHECK_EQUAL(flat.resource_map()->size(), 1);
+
+    calls.clear();
+    flat_procs.provide({boost::beast::http::verb::get, "/v1/api/users/7", 11}, test_session::flesh{});
+    BOOST_CHECK((calls == std::vector<std::string>{"user /7"}));
+
+} // BOOST_AUTO_TEST_CASE(mount_no_1)
+
+BOOST_AUTO_TEST_CASE(mount_no_2) {
+
+    http::basic_router<test_session> router{regex_flags};
+    http::basic_router<test_session> api{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<std::string> calls;
+
+    auto record = [&calls](std::string name){
+        return [&calls, name](auto request, auto /*context*/){
+            calls.push_back(name + " " + std::string{request.target()});
+        };
+    };
+
+    api.get("^/health$", record("health"));
+
+    router.mount("/api", api);
+
+    // Neither hides the mount, they only see what it has no route for
+    router.get("^/api/.*$", record("parent"));
+    router.all("^.*$", record("not found"));
+
+    procs.provide({boost::beast::http::verb::get, "/api/health", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/api/other", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::post, "/api/health", 11}, test_session::flesh{});
+
+    BOOST_CHECK((calls == std::vector<std::string>{
+                     "health /health", "parent /api/other", "not found /api/health"}));
+
+    BOOST_CHECK_THROW(router.mount("^/v(\\d+)$", api), std::invalid_argument);
+
+} // BOOST_AUTO_TEST_CASE(mount_no_2)
+
+BOOST_AUTO_TEST_CASE(mount_no_3) {
+
+    http::basic_router<test_session> router{regex_flags};
+    http::basic_router<test_session> api{regex_flags};
+    http::basic_router<test_session> flat{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{flat.resource_map(), flat.method_map(), flat.regex_flags()};
+
+    std::vector<std::string> calls;
+
+    auto record = [&calls](std::string name){
+        return [&calls, name](auto request, auto /*context*/){
+            calls.push_back(name + " " + std::string{request.target()});
+        };
+    };
+
+    api.get("^/health$", record("health"));
+    router.mount("/api", api);
+    router.get("^/status$", record("status"));
+
+    // A regex prefix cannot be mounted, the mounted routes are copied instead
+    BOOST_CHECK_NO_THROW(flat.use("^/v(\\d+)$", router));
+
+    procs.provide({boost::beast::http::verb::get, "/v2/api/health", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/v2/status", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/vx/api/health", 11}, test_session::flesh{});
+
+    BOOST_CHECK((calls == std::vector<std::string>{
+                     "health /v2/api/health", "status /v2/status"}));
+
+} // BOOST_AUTO_TEST_CASE(mount_no_3)
@@ -5,8 +5,13 @@
 
 #include <http/base/cb.hxx>
 #include <http/base/regex.hxx>
+#include <http/base/route.hxx>
 #include <http/base/request_processor.hxx>
 
+#ifdef BEASTHTTP_TEST_DFA_REGEX
+#include "../dfa_regex/checked_regex.hxx"
+#endif // BEASTHTTP_TEST_DFA_REGEX
+
 #include <http/literals.hxx>
 #include <http/chain_router.hxx>
 
@@ -43,13 +48,19 @@ public:
 
     using request_type = boost::beast::http::request<body_type>;
 
+#ifdef BEASTHTTP_TEST_DFA_REGEX
+    using regex_type = checked_regex;
+#else
     using regex_type = http::base::regex;
+#endif // BEASTHTTP_TEST_DFA_REGEX
 
     using regex_flag_type = typename regex_type::flag_type;
 
     using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
 
-    using resource_map_type = std::unordered_map<resource_regex_type, storage_type>;
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
 
     using method_map_type = std::map<method_type, resource_map_type>;
 
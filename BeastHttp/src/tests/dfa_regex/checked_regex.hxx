@@ -0,0 +1,46 @@
+#ifndef BEASTHTTP_TESTS_CHECKED_REGEX_HXX
+#define BEASTHTTP_TESTS_CHECKED_REGEX_HXX
+
+#include <http/base/dfa_regex.hxx>
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+// Runs match_all and the sequential scan side by side and
+// checks that both report the same routes in the same order
+class checked_regex : public _0xdead4ead::http::base::dfa_regex
+{
+    using base_type = _0xdead4ead::http::base::dfa_regex;
+
+public:
+
+    using base_type::base_type;
+
+    template<class ResourceMap, class F>
+    bool
+    match_all(ResourceMap const& resource_map, string_view_type target, F&& f) const
+    {
+        using value_type = typename ResourceMap::value_type;
+
+        std::vector<value_type const*> expected, actual;
+        for (const auto& value : resource_map)
+            if (match(value.second.regex(), target))
+                expected.push_back(&value);
+
+        bool invoked = base_type::match_all(resource_map, target, [&](value_type const& value){
+            actual.push_back(&value);
+        });
+
+        BOOST_CHECK(expected == actual);
+        BOOST_CHECK_EQUAL(invoked, not expected.empty());
+
+        for (const auto value : actual)
+            f(*value);
+
+        return invoked;
+    }
+
+}; // class checked_regex
+
+#endif // not defined BEASTHTTP_TESTS_CHECKED_REGEX_HXX
@@ -0,0 +1,140 @@
+#define BOOST_TEST_MODULE dfa_regex_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/regex.hxx>
+#include <http/base/dfa_regex.hxx>
+
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace _0xdead4ead;
+
+template<class Regex>
+class entry
+{
+public:
+
+    using compiled_type = typename Regex::compiled_type;
+
+    explicit
+    entry(compiled_type compiled)
+        : compiled_{std::move(compiled)}
+    {
+    }
+
+    compiled_type const&
+    regex() const
+    {
+        return compiled_;
+    }
+
+private:
+
+    compiled_type compiled_;
+
+}; // class entry
+
+using resource_map_type = std::vector<std::pair<const std::string, entry<http::base::dfa_regex>>>;
+
+static void
+check(std::regex::flag_type flags,
+      const std::vector<std::string>& patterns,
+      const std::vector<std::string>& targets)
+{
+    http::base::regex sequential{flags};
+    http::base::dfa_regex combined{flags};
+
+    resource_map_type resource_map;
+    for (const auto& pattern : patterns)
+        resource_map.emplace_back(pattern, entry<http::base::dfa_regex>{combined.compile(pattern)});
+
+    for (const auto& target : targets) {
+        std::vector<std::string> expected, actual;
+        for (const auto& pattern : patterns)
+            if (sequential.match(sequential.compile(pattern), target))
+                expected.push_back(pattern);
+
+        bool invoked = combined.match_all(resource_map, target,
+                                          [&](resource_map_type::value_type const& value){
+            actual.push_back(value.first);
+        });
+
+        BOOST_TEST_CONTEXT("target: " << target) {
+            BOOST_CHECK(expected == actual);
+            BOOST_CHECK_EQUAL(invoked, not expected.empty());
+        }
+    }
+}
+
+static const std::vector<std::string> targets = {
+    "", "/", "/testpath", "/a", "/a/b/c", "/10", "/10/20/abc", "/10/20/abc/30/-30",
+    "/api/users/42", "/api/users/42/orders", "/API/Users", "abcx", "abcd", "ababab",
+    "abab", "abc", "a.txt", "aa", "a", "b", "xxx", "192.168.0.1", "1-2", "x\n", "A"
+};
+
+BOOST_AUTO_TEST_CASE(ecmascript_no_1) {
+
+    check(std::regex::ECMAScript, {
+        "/testpath", "^/a$", ".*", "^.*$", "/(\\d+)", "/(\\d+)/(\\d+)/(\\w+)",
+        "/(\\d+)/(\\d+)/(\\w+)/(\\d+)/(-\\d+)", "^/a/b/c$", "/api/users/:id",
+        "/api/users/:id/orders", "[a-c]+x?", "(?:ab|cd){2,3}", "[^/]+",
+        "\\w+\\.txt", "a{2}", "^$", "x*", "(a|)+", "\\d{1,3}(\\.\\d{1,3}){3}",
+        "[\\d\\-]+", "a$|b", "^a|^b", "(ab)*?", "[\\s\\S]", "x\\n", "/.+"
+    }, targets);
+
+} // BOOST_AUTO_TEST_CASE(ecmascript_no_1)
+
+BOOST_AUTO_TEST_CASE(icase_no_1) {
+
+    check(std::regex::ECMAScript | std::regex::icase, {
+        "/api/users/\\d+", "/Api/[a-z]+", "[^a]", "A+", "/TESTPATH", "\\w"
+    }, targets);
+
+} // BOOST_AUTO_TEST_CASE(icase_no_1)
+
+BOOST_AUTO_TEST_CASE(sequential_no_1) {
+
+    // Not expressible as a DFA, matched with std::regex in map order
+    check(std::regex::ECMAScript, {
+        "(\\w)\\1", "/a", "(?=a)a", "\\bab\\b", "[[:alpha:]]+", ".*"
+    }, targets);
+
+    check(std::regex::extended, {
+        "/a", "(a|b)+", ".*"
+    }, targets);
+
+} // BOOST_AUTO_TEST_CASE(sequential_no_1)
+
+BOOST_AUTO_TEST_CASE(invalidate_no_1) {
+
+    http::base::dfa_regex combined{std::regex::ECMAScript};
+
+    resource_map_type first, second;
+    first.emplace_back("/a", entry<http::base::dfa_regex>{combined.compile("/a")});
+    second.emplace_back("/b", entry<http::base::dfa_regex>{combined.compile("/b")});
+
+    std::vector<std::string> actual;
+    auto record = [&](resource_map_type::value_type const& value){
+        actual.push_back(value.first);
+    };
+
+    // A copy made in place of a freed map, as a published snapshot may be
+    std::aligned_storage<sizeof (resource_map_type), alignof (resource_map_type)>::type storage;
+
+    auto map = ::new (&storage) resource_map_type{first};
+    combined.match_all(*map, "/a", record);
+    map->~resource_map_type();
+
+    map = ::new (&storage) resource_map_type{second};
+    http::base::dfa_regex::invalidate();
+    combined.match_all(*map, "/b", record);
+    map->~resource_map_type();
+
+    BOOST_CHECK((actual == std::vector<std::string>{"/a", "/b"}));
+
+} // BOOST_AUTO_TEST_CASE(invalidate_no_1)
@@ -0,0 +1,189 @@
+#define BOOST_TEST_MODULE hub_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/outbox.hxx>
+
+#include <http/reactor/session.hxx>
+#include <http/basic_router.hxx>
+#include <http/hub.hxx>
+
+#include <boost/asio/buffers_iterator.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/http.hpp>
+
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace _0xdead4ead;
+
+using response_type = boost::beast::http::response<boost::beast::http::string_body>;
+
+using http_session = http::reactor::_default::session_type;
+
+static response_type
+make_event(std::string body)
+{
+    response_type response{boost::beast::http::status::ok, 11};
+    response.body() = std::move(body);
+    response.prepare_payload();
+    return response;
+}
+
+static std::string
+serialized(response_type const& response)
+{
+    std::ostringstream stream;
+    stream << response;
+    return stream.str();
+}
+
+BOOST_AUTO_TEST_CASE(outbox_no_1) {
+
+    using overflow = http::base::outbox::overflow;
+
+    http::base::outbox outbox;
+    boost::beast::error_code ec;
+
+    auto first = make_event("first");
+    auto second = make_event("second");
+    auto third = make_event("third");
+
+    auto shared = http::base::outbox::encode(second, ec);
+    BOOST_REQUIRE(not ec);
+    BOOST_CHECK_EQUAL(*shared, serialized(second));
+
+    BOOST_CHECK(outbox.push(first, 4096, overflow::close, ec));
+    BOOST_CHECK(outbox.push(shared, 4096, overflow::close, ec));
+    BOOST_CHECK(outbox.push(third, 4096, overflow::close, ec));
+    BOOST_CHECK(outbox.push(third, 4096, overflow::close, ec));
+    BOOST_CHECK(outbox.push(shared, 4096, overflow::close, ec));
+
+    BOOST_CHECK_EQUAL(outbox.size(), serialized(first).size()
+                      + 2 * shared->size() + 2 * serialized(third).size());
+
+    // The shared message is referenced, the serialized ones around it
+    // go in one buffer
+    auto const& buffers = outbox.flush();
+    BOOST_REQUIRE_EQUAL(buffers.size(), 4);
+    BOOST_CHECK(buffers[1].data() == shared->data());
+    BOOST_CHECK(buffers[3].data() == shared->data());
+
+    std::string text{boost::asio::buffers_begin(buffers), boost::asio::buffers_end(buffers)};
+    BOOST_CHECK_EQUAL(text, serialized(first) + *shared + serialized(third) + serialized(third) + *shared);
+
+    // Held until the write completes
+    BOOST_CHECK_EQUAL(shared.use_count(), 3);
+    outbox.consume();
+    BOOST_CHECK_EQUAL(shared.use_count(), 1);
+    BOOST_CHECK_EQUAL(outbox.size(), 0);
+
+    // Shared messages are dropped like the others
+    const std::size_t limit = 2 * shared->size();
+    BOOST_CHECK(outbox.push(shared, limit, overflow::drop_oldest, ec));
+    BOOST_CHECK(outbox.push(first, limit, overflow::drop_oldest, ec));
+    BOOST_CHECK(outbox.push(shared, limit, overflow::drop_oldest, ec));
+
+    BOOST_CHECK_EQUAL(outbox.dropped(), 1);
+    BOOST_CHECK_EQUAL(outbox.size(), serialized(first).size() + shared->size());
+
+    auto const& rest = outbox.flush();
+    text.assign(boost::asio::buffers_begin(rest), boost::asio::buffers_end(rest));
+    BOOST_CHECK_EQUAL(text, serialized(first) + *shared);
+}
+
+struct hub_server
+{
+    boost::asio::io_context ioc;
+
+    http::basic_router<http_session> router{std::regex::ECMAScript};
+
+    boost::asio::ip::tcp::acceptor acceptor{ioc, {boost::asio::ip::address_v4::loopback(), 0}};
+
+    http::hub<http_session> hub;
+
+    hub_server()
+    {
+        router.get("^/sse$", [this](auto /*request*/, auto context){
+            hub.subscribe(context);
+            context.recv();
+        });
+
+        accept();
+    }
+
+    void
+    accept()
+    {
+        acceptor.async_accept([this](boost::system::error_code ec, boost::asio::ip::tcp::socket socket){
+            if (ec)
+                return;
+
+            http_session::recv(std::move(socket), router);
+
+            accept();
+        });
+    }
+
+}; // struct hub_server
+
+BOOST_AUTO_TEST_CASE(hub_no_1) {
+
+    const std::size_t subscribers = 32;
+
+    hub_server server;
+
+    auto work = boost::asio::make_work_guard(server.ioc);
+    std::thread thread{[&]{ server.ioc.run(); }};
+
+    boost::asio::io_context client_ioc;
+    std::vector<std::unique_ptr<boost::asio::ip::tcp::socket>> sockets;
+    std::vector<boost::beast::flat_buffer> buffers(subscribers);
+
+    for (std::size_t i = 0; i < subscribers; ++i) {
+        sockets.emplace_back(new boost::asio::ip::tcp::socket{client_ioc});
+        sockets.back()->connect(server.acceptor.local_endpoint());
+        boost::asio::write(*sockets.back(), boost::asio::buffer(std::string{"GET /sse HTTP/1.1\r\nHost: test\r\n\r\n"}));
+    }
+
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (server.hub.size() < subscribers and std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    // Published from a thread of no session
+    for (auto body : {"1", "2", "3"})
+        BOOST_CHECK_EQUAL(server.hub.publish(make_event(body)), subscribers);
+
+    for (std::size_t i = 0; i < subscribers; ++i)
+        for (auto body : {"1", "2", "3"}) {
+            response_type event;
+            boost::beast::http::read(*sockets[i], buffers[i], event);
+            BOOST_CHECK_EQUAL(event.body(), body);
+        }
+
+    // A session gone leaves the hub
+    sockets.front()->close();
+
+    std::size_t published = subscribers;
+    while (published == subscribers and std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        published = server.hub.publish(make_event("4"));
+    }
+
+    BOOST_CHECK_EQUAL(published, subscribers - 1);
+    BOOST_CHECK_EQUAL(server.hub.size(), subscribers - 1);
+
+    response_type event;
+    boost::beast::http::read(*sockets.back(), buffers.back(), event);
+    BOOST_CHECK_EQUAL(event.body(), "4");
+
+    work.reset();
+    server.ioc.stop();
+    thread.join();
+}
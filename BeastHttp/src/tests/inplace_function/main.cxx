@@ -0,0 +1,275 @@
+#define BOOST_TEST_MODULE inplace_function_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/inplace_function.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+using namespace _0xdead4ead;
+
+class test_session
+{
+public:
+
+    using self_type = test_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, http::base::inplace_function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class test_session
+
+static const std::regex::flag_type regex_flags = std::regex::ECMAScript;
+
+BOOST_AUTO_TEST_CASE(invoke_no_1) {
+
+    http::base::inplace_function<int (int, int)> add = [](int a, int b){
+        return a + b;
+    };
+
+    BOOST_CHECK(add);
+    BOOST_CHECK(add(2, 3) == 5);
+
+    std::size_t invoked = 0;
+
+    // The result of the target is discarded for void signatures
+    http::base::inplace_function<void (std::size_t)> count = [&](std::size_t n){
+        invoked += n;
+        return invoked;
+    };
+
+    count(1);
+    count(10);
+
+    BOOST_CHECK(invoked == 11);
+
+    http::base::inplace_function<void (std::unique_ptr<int>&&)> sink =
+            [&](std::unique_ptr<int> p){
+        invoked += std::size_t(*p);
+    };
+
+    sink(std::unique_ptr<int>{new int{100}});
+
+    BOOST_CHECK(invoked == 111);
+
+} // BOOST_AUTO_TEST_CASE(invoke_no_1)
+
+BOOST_AUTO_TEST_CASE(empty_no_1) {
+
+    http::base::inplace_function<void ()> f;
+
+    BOOST_CHECK(not f);
+    BOOST_CHECK_THROW(f(), std::bad_function_call);
+
+    f = [](){};
+
+    BOOST_CHECK(f);
+
+    f = nullptr;
+
+    BOOST_CHECK(not f);
+
+    http::base::inplace_function<void ()> g{nullptr};
+
+    BOOST_CHECK(not g);
+
+} // BOOST_AUTO_TEST_CASE(empty_no_1)
+
+BOOST_AUTO_TEST_CASE(copy_no_1) {
+
+    auto counter = std::make_shared<int>(0);
+
+    http::base::inplace_function<int ()> f = [counter](){
+        return ++*counter;
+    };
+
+    BOOST_CHECK(counter.use_count() == 2);
+
+    {
+        auto g = f;
+
+        BOOST_CHECK(counter.use_count() == 3);
+        BOOST_CHECK(g() == 1);
+
+        auto h = std::move(g);
+
+        BOOST_CHECK(not g);
+        BOOST_CHECK(counter.use_count() == 3);
+        BOOST_CHECK(h() == 2);
+
+        g = h;
+
+        BOOST_CHECK(counter.use_count() == 4);
+
+        h = nullptr;
+
+        BOOST_CHECK(counter.use_count() == 3);
+    }
+
+    BOOST_CHECK(counter.use_count() == 2);
+    BOOST_CHECK(f() == 3);
+
+    f = std::move(f);
+
+    BOOST_CHECK(f() == 4);
+
+    f = http::base::inplace_function<int ()>{};
+
+    BOOST_CHECK(counter.use_count() == 1);
+
+} // BOOST_AUTO_TEST_CASE(copy_no_1)
+
+BOOST_AUTO_TEST_CASE(empty_no_2) {
+
+    void (*null)() = nullptr;
+
+    http::base::inplace_function<void ()> f{null};
+
+    BOOST_CHECK(not f);
+
+    http::base::inplace_function<void ()> g{std::function<void ()>{}};
+
+    BOOST_CHECK(not g);
+
+    g = std::function<void ()>{[](){}};
+
+    BOOST_CHECK(g);
+
+} // BOOST_AUTO_TEST_CASE(empty_no_2)
+
+struct throwing_move
+{
+    throwing_move() = default;
+
+    throwing_move(throwing_move const&) = default;
+
+    throwing_move(throwing_move&&) noexcept(false)
+    {
+    }
+
+    int
+    operator()() const
+    {
+        return 7;
+    }
+};
+
+static_assert (std::is_nothrow_move_constructible<http::base::inplace_function<void ()>>::value, "");
+
+BOOST_AUTO_TEST_CASE(heap_no_1) {
+
+    // Too large for the buffer, the target goes to the heap
+    std::string a(100, 'a'), b(100, 'b'), c(100, 'c');
+
+    http::base::inplace_function<std::size_t ()> f = [a, b, c](){
+        return a.size() + b.size() + c.size();
+    };
+
+    BOOST_CHECK(f() == 300);
+
+    auto g = f;
+    auto h = std::move(f);
+
+    BOOST_CHECK(not f);
+    BOOST_CHECK(g() == 300);
+    BOOST_CHECK(h() == 300);
+
+    g = std::move(h);
+
+    BOOST_CHECK(not h);
+    BOOST_CHECK(g() == 300);
+
+    // So does a target whose move can throw, moving the wrapper cannot
+    http::base::inplace_function<int ()> t = throwing_move{};
+    auto u = std::move(t);
+
+    BOOST_CHECK(u() == 7);
+
+} // BOOST_AUTO_TEST_CASE(heap_no_1)
+
+BOOST_AUTO_TEST_CASE(chain_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    std::size_t invoked = 0;
+
+    router.get("^/a$", [&](auto& /*request*/, auto /*context*/, auto _1x){
+        ++invoked;
+        std::next(_1x)();
+    }, [&](auto /*request*/, auto /*context*/, auto _2x){
+        invoked += 10;
+        std::next(_2x)();
+    }, [&](auto& /*request*/, auto /*context*/){
+        invoked += 100;
+    });
+
+    router.all("^.*$", [&](auto /*request*/, auto /*context*/){
+        invoked += 1000;
+    });
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    procs.provide({boost::beast::http::verb::get, "/a", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::post, "/a", 11}, test_session::flesh{});
+
+    BOOST_CHECK(invoked == 1111);
+
+} // BOOST_AUTO_TEST_CASE(chain_no_1)
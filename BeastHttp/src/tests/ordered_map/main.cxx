@@ -0,0 +1,297 @@
+#define BOOST_TEST_MODULE ordered_map_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/ordered_map.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+#include <http/chain_router.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <thread>
+#include <unordered_map>
+
+using namespace _0xdead4ead;
+
+class test_session
+{
+public:
+
+    using self_type = test_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = http::base::ordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class test_session
+
+static const std::regex::flag_type regex_flags = std::regex::ECMAScript;
+
+using verb = boost::beast::http::verb;
+
+BOOST_AUTO_TEST_CASE(first_match_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<std::string> invoked;
+
+    router.get("^/api/users$", [&](auto /*request*/, auto /*context*/){
+        invoked.push_back("users");
+    });
+
+    router.get("^/api/.*$", [&](auto /*request*/, auto /*context*/){
+        invoked.push_back("api");
+    });
+
+    router.all("^.*$", [&](auto /*request*/, auto /*context*/){
+        invoked.push_back("404");
+    });
+
+    procs.provide({verb::get, "/api/users", 11}, test_session::flesh{});
+    procs.provide({verb::get, "/api/orders", 11}, test_session::flesh{});
+    procs.provide({verb::get, "/other", 11}, test_session::flesh{});
+    procs.provide({verb::post, "/api/users", 11}, test_session::flesh{});
+
+    BOOST_CHECK((invoked == std::vector<std::string>{"users", "api", "404", "404"}));
+
+} // BOOST_AUTO_TEST_CASE(first_match_no_1)
+
+BOOST_AUTO_TEST_CASE(priority_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<std::string> invoked;
+
+    router.get("^/api/.*$", [&](auto /*request*/, auto /*context*/){
+        invoked.push_back("api");
+    });
+
+    router.get("^/api/users$", [&](auto /*request*/, auto /*context*/){
+        invoked.push_back("users");
+    });
+
+    router.post("^/api/users$", [&](auto /*request*/, auto /*context*/){
+        invoked.push_back("post users");
+    });
+
+    procs.provide({verb::get, "/api/users", 11}, test_session::flesh{});
+
+    router.priority("^/api/users$", 1);
+
+    procs.provide({verb::get, "/api/users", 11}, test_session::flesh{});
+    procs.provide({verb::post, "/api/users", 11}, test_session::flesh{});
+
+    BOOST_CHECK((invoked == std::vector<std::string>{"api", "users", "post users"}));
+    BOOST_CHECK_EQUAL(router.method_map()->at(verb::get).order().front().priority(), 1);
+    BOOST_CHECK_EQUAL(router.method_map()->at(verb::post).order().front().priority(), 1);
+
+} // BOOST_AUTO_TEST_CASE(priority_no_1)
+
+BOOST_AUTO_TEST_CASE(reorder_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    router.get("^/a$", [](auto /*request*/, auto /*context*/){});
+    router.get("^/b$", [](auto /*request*/, auto /*context*/){});
+    router.get("^/c$", [](auto /*request*/, auto /*context*/){});
+    router.get("^/d$", [](auto /*request*/, auto /*context*/){});
+
+    router.priority("^/d$", -1);
+
+    for (int i = 0; i < 3; ++i)
+        procs.provide({verb::get, "/c", 11}, test_session::flesh{});
+
+    for (int i = 0; i < 5; ++i)
+        procs.provide({verb::get, "/d", 11}, test_session::flesh{});
+
+    procs.provide({verb::get, "/b", 11}, test_session::flesh{});
+
+    const auto& order = router.method_map()->at(verb::get).order();
+
+    // Counters do not move routes until reorder() is called
+    BOOST_CHECK_EQUAL(order[0].value().first, "^/a$");
+    BOOST_CHECK_EQUAL(order[2].hits(), 3);
+
+    router.reorder();
+
+    std::vector<std::string> keys;
+    for (const auto& value : order)
+        keys.push_back(value.value().first);
+
+    // Traffic reorders routes only within their priority
+    BOOST_CHECK((keys == std::vector<std::string>{"^/c$", "^/b$", "^/a$", "^/d$"}));
+    BOOST_CHECK_EQUAL(order[3].hits(), 5);
+
+} // BOOST_AUTO_TEST_CASE(reorder_no_1)
+
+BOOST_AUTO_TEST_CASE(snapshot_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    router.get("^/a$", [](auto /*request*/, auto /*context*/){});
+    router.get("^/b$", [](auto /*request*/, auto /*context*/){});
+
+    router.enable_snapshot();
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags(), router.snapshot()};
+
+    for (int i = 0; i < 2; ++i)
+        procs.provide({verb::get, "/b", 11}, test_session::flesh{});
+
+    // Hits recorded on the published copy reach the router's tables
+    BOOST_CHECK_EQUAL(router.method_map()->at(verb::get).order()[1].hits(), 2);
+
+    router.reorder();
+
+    BOOST_CHECK_EQUAL(router.snapshot()->method_map()->at(verb::get).order()[0].value().first, "^/b$");
+
+    procs.provide({verb::get, "/b", 11}, test_session::flesh{});
+
+    BOOST_CHECK_EQUAL(router.snapshot()->method_map()->at(verb::get).order()[0].hits(), 3);
+
+} // BOOST_AUTO_TEST_CASE(snapshot_no_1)
+
+BOOST_AUTO_TEST_CASE(use_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<std::string> invoked;
+
+    http::chain_router<test_session> chain{regex_flags};
+    chain.route("/users")
+            .get([&](auto /*request*/, auto /*context*/){
+        invoked.push_back("users");
+    });
+
+    router.use("^/api$", chain);
+
+    router.get("^/api/users$", [&](auto /*request*/, auto /*context*/){
+        invoked.push_back("overwritten");
+    });
+
+    procs.provide({verb::get, "/api/users", 11}, test_session::flesh{});
+
+    BOOST_CHECK((invoked == std::vector<std::string>{"overwritten"}));
+    BOOST_CHECK_EQUAL(router.method_map()->at(verb::get).order().size(), 1);
+
+} // BOOST_AUTO_TEST_CASE(use_no_1)
+
+BOOST_AUTO_TEST_CASE(threads_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    router.get("^/a$", [](auto /*request*/, auto /*context*/){});
+    router.get("^/b$", [](auto /*request*/, auto /*context*/){});
+
+    router.enable_snapshot();
+
+    // Each thread counts on its own, reorder() sums them, finished threads included
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+        threads.emplace_back([&router]{
+            http::base::request_processor<test_session>
+                    procs{router.resource_map(), router.method_map(),
+                          router.regex_flags(), router.snapshot()};
+
+            for (int j = 0; j < 100; ++j)
+                procs.provide({verb::get, "/b", 11}, test_session::flesh{});
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    BOOST_CHECK_EQUAL(router.method_map()->at(verb::get).order()[1].hits(), 400);
+
+    router.reorder();
+
+    BOOST_CHECK_EQUAL(router.method_map()->at(verb::get).order()[0].value().first, "^/b$");
+
+} // BOOST_AUTO_TEST_CASE(threads_no_1)
+
+BOOST_AUTO_TEST_CASE(cache_no_1) {
+
+    using processor_type = http::base::request_processor<test_session>;
+
+    http::basic_router<test_session> router{regex_flags};
+
+    processor_type procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    router.get("^/a$", [](auto /*request*/, auto /*context*/){});
+    router.get("^/b$", [](auto /*request*/, auto /*context*/){});
+
+    processor_type::enable_cache(16);
+
+    const auto hits = processor_type::cache().hits();
+
+    for (int i = 0; i < 3; ++i)
+        procs.provide({verb::get, "/b", 11}, test_session::flesh{});
+
+    // Requests served from the route cache are counted as well
+    BOOST_CHECK_EQUAL(processor_type::cache().hits() - hits, 2);
+    BOOST_CHECK_EQUAL(router.method_map()->at(verb::get).order()[1].hits(), 3);
+
+    processor_type::enable_cache(0);
+
+} // BOOST_AUTO_TEST_CASE(cache_no_1)
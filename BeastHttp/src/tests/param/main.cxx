@@ -4,7 +4,9 @@
 #include <boost/test/unit_test.hpp>
 
 #include <http/base/cb.hxx>
+#include <http/base/dfa_regex.hxx>
 #include <http/base/regex.hxx>
+#include <http/base/route.hxx>
 #include <http/base/request_processor.hxx>
 
 #include <http/param.hxx>
@@ -14,6 +16,8 @@
 
 #include <boost/beast/http.hpp>
 
+#include <atomic>
+#include <thread>
 #include <unordered_map>
 
 using namespace _0xdead4ead;
@@ -51,7 +55,9 @@ public:
 
     using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
 
-    using resource_map_type = std::unordered_map<resource_regex_type, storage_type>;
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
 
     using method_map_type = std::map<method_type, resource_map_type>;
 
@@ -67,12 +73,76 @@ public:
         context(Flesh&)
         {
         }
+
+        template<class Response>
+        void
+        send(Response&& response) const
+        {
+            sent().push_back(response.result());
+        }
+
+        static std::vector<boost::beast::http::status>&
+        sent()
+        {
+            static std::vector<boost::beast::http::status> value;
+            return value;
+        }
     };
 
 }; // class test_session
 
+// The same session matching its routes with another regex engine
+class dfa_session : public test_session
+{
+public:
+
+    using self_type = dfa_session;
+
+    using regex_type = http::base::dfa_regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+}; // class dfa_session
+
 static const std::regex::flag_type regex_flags = std::regex::ECMAScript;
 
+enum class color { red = 1, green = 2 };
+
+struct version
+{
+    int major = 0;
+    int minor = 0;
+};
+
+namespace _0xdead4ead {
+namespace http {
+namespace param {
+
+template<>
+struct converter<version>
+{
+    static bool
+    convert(boost::beast::string_view in, version& out)
+    {
+        auto const dot = in.find('.');
+        return dot != boost::beast::string_view::npos
+                and converter<int>::convert(in.substr(0, dot), out.major)
+                and converter<int>::convert(in.substr(dot + 1), out.minor);
+    }
+}; // struct converter
+
+} // namespace param
+} // namespace http
+} // namespace _0xdead4ead
+
 BOOST_AUTO_TEST_CASE(no_1) {
 
     http::basic_router<test_session> router{regex_flags};
@@ -417,3 +487,390 @@ BOOST_AUTO_TEST_CASE(literals_no_2) {
     procs.provide({boost::beast::http::verb::put, "/a/10", 11}, test_session::flesh{});
 
 } // BOOST_AUTO_TEST_CASE(literals_no_2)
+
+BOOST_AUTO_TEST_CASE(concurrent_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    using pack = http::param::pack<int, std::string>;
+
+    std::atomic<std::size_t> invoked{0}, mismatched{0};
+
+    router.param<pack>().get("/users/(\\d+)/(\\w+)",
+       [&](auto& request, auto /*context*/, auto args){
+        ++invoked;
+        if (request.target() != "/users/" + std::to_string(std::get<0>(args))
+                + "/" + std::get<1>(args))
+            ++mismatched;
+    });
+
+    router.param<pack>().get("/orders/(\\d+)/(\\w+)",
+       [&](auto& /*request*/, auto /*context*/, auto _1x, auto /*args*/){
+        std::next(_1x)();
+    }, [&](auto& /*request*/, auto /*context*/, auto _2x, auto args){
+        if (std::get<1>(args) != "")
+            ++mismatched;
+        std::next(_2x)();
+    }, [&](auto& request, auto /*context*/, auto args){
+        ++invoked;
+        if (request.target() != "/" + std::get<1>(args))
+            ++mismatched;
+    });
+
+    static const std::size_t threads = 8, iterations = 2000;
+
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t)
+        workers.emplace_back([&, t](){
+            http::base::request_processor<test_session>
+                    procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+            // Every thread sends its own values, captures must never leak
+            // from one request into another
+            for (std::size_t n = 0; n < iterations; ++n) {
+                auto id = std::to_string(t * iterations + n);
+                auto name = "t" + std::to_string(t);
+
+                procs.provide({boost::beast::http::verb::get,
+                               "/users/" + id + "/" + name, 11}, test_session::flesh{});
+                procs.provide({boost::beast::http::verb::get,
+                               "/orders/" + id + "/" + name, 11}, test_session::flesh{});
+            }
+        });
+
+    for (auto& worker : workers)
+        worker.join();
+
+    BOOST_CHECK_EQUAL(invoked, 2 * threads * iterations);
+    BOOST_CHECK_EQUAL(mismatched, 0);
+
+} // BOOST_AUTO_TEST_CASE(concurrent_no_1)
+
+BOOST_AUTO_TEST_CASE(thread_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    using pack = http::param::pack<int, std::string>;
+
+    std::vector<std::tuple<int, std::string>> seen;
+
+    auto first = [&](){
+        return [&](auto& /*request*/, auto /*context*/, auto _1x, auto args){
+            seen.push_back(args);
+            std::next(_1x)();
+        };
+    };
+
+    auto last = [&](){
+        return [&](auto& /*request*/, auto /*context*/, auto args){
+            seen.push_back(args);
+        };
+    };
+
+    router.param<pack>().get("/local/(\\d+)/(\\w+)", first(),
+       [&](auto& /*request*/, auto /*context*/, auto _2x, auto args){
+        seen.push_back(args);
+        std::next(_2x)();
+    }, last());
+
+    // The chain goes on from another thread, the captures follow it
+    router.param<pack>().get("/remote/(\\d+)/(\\w+)", first(),
+       [&](auto& /*request*/, auto /*context*/, auto _2x, auto args){
+        seen.push_back(args);
+        std::thread{[&]{ std::next(_2x)(); }}.join();
+    }, last());
+
+    procs.provide({boost::beast::http::verb::get, "/local/42/name", 11}, test_session::flesh{});
+    auto expected = seen;
+    seen.clear();
+
+    procs.provide({boost::beast::http::verb::get, "/remote/42/name", 11}, test_session::flesh{});
+
+    BOOST_CHECK_EQUAL(expected.size(), 3);
+    BOOST_CHECK(seen == expected);
+
+} // BOOST_AUTO_TEST_CASE(thread_no_1)
+
+BOOST_AUTO_TEST_CASE(converter_no_1) {
+
+    using http::param::converter;
+
+    int i = 0;
+    BOOST_CHECK(converter<int>::convert("42", i) and i == 42);
+    BOOST_CHECK(converter<int>::convert("+42", i) and i == 42);
+    BOOST_CHECK(converter<int>::convert("-42", i) and i == -42);
+    BOOST_CHECK(not converter<int>::convert("", i));
+    BOOST_CHECK(not converter<int>::convert("42a", i));
+    BOOST_CHECK(not converter<int>::convert("99999999999", i));
+    BOOST_CHECK(not converter<int>::convert("+-5", i));
+    BOOST_CHECK(not converter<int>::convert("+", i));
+    BOOST_CHECK(not converter<int>::convert("++5", i));
+
+    unsigned short u = 0;
+    BOOST_CHECK(converter<unsigned short>::convert("65535", u) and u == 65535);
+    BOOST_CHECK(not converter<unsigned short>::convert("65536", u));
+
+    double d = 0;
+    BOOST_CHECK(converter<double>::convert("1.5", d) and d == 1.5);
+    BOOST_CHECK(not converter<double>::convert("1.5.", d));
+    BOOST_CHECK(converter<double>::convert("+2.5", d) and d == 2.5);
+    BOOST_CHECK(converter<double>::convert("+.5", d) and d == 0.5);
+    BOOST_CHECK(converter<double>::convert("-.5", d) and d == -0.5);
+    BOOST_CHECK(not converter<double>::convert("+-5", d));
+    BOOST_CHECK(not converter<double>::convert("+inf", d));
+
+    color c = color::red;
+    BOOST_CHECK(converter<color>::convert("2", c) and c == color::green);
+
+    std::string str;
+    BOOST_CHECK(converter<std::string>::convert("abc", str) and str == "abc");
+
+    boost::beast::string_view view;
+    BOOST_CHECK(converter<boost::beast::string_view>::convert("abc", view) and view == "abc");
+
+    // Types without a specialization go through lexical_cast
+    char ch = 0;
+    BOOST_CHECK(converter<char>::convert("x", ch) and ch == 'x');
+    bool flag = false;
+    BOOST_CHECK(converter<bool>::convert("1", flag) and flag);
+
+    version v;
+    BOOST_CHECK(converter<version>::convert("2.17", v) and v.major == 2 and v.minor == 17);
+    BOOST_CHECK(not converter<version>::convert("2", v));
+
+} // BOOST_AUTO_TEST_CASE(converter_no_1)
+
+BOOST_AUTO_TEST_CASE(bad_request_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::size_t handled = 0, rejected = 0;
+
+    router.param<http::param::pack<int, version>>().on_bad_request(
+                [&](auto& request, auto /*context*/){
+        BOOST_CHECK(request.target() == "/99999999999/v1.2"
+                    or request.target() == "/v1");
+        ++rejected;
+    }).get("/(\\d+)/v([\\d.]+)",
+       [&](auto& /*request*/, auto /*context*/, auto args){
+        BOOST_CHECK_EQUAL(std::get<0>(args), 7);
+        BOOST_CHECK_EQUAL(std::get<1>(args).minor, 2);
+        ++handled;
+    });
+
+    procs.provide({boost::beast::http::verb::get, "/7/v1.2", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/99999999999/v1.2", 11}, test_session::flesh{});
+
+    BOOST_CHECK_EQUAL(handled, 1);
+    BOOST_CHECK_EQUAL(rejected, 1);
+
+    // The chain stops at the first handler whose captures do not convert
+    router.param<http::param::pack<int, version>>().on_bad_request(
+                [&](auto& /*request*/, auto /*context*/){
+        ++rejected;
+    }).post("/(\\d+)/v([\\d.]+)",
+       [&](auto& /*request*/, auto /*context*/, auto _1x, auto /*args*/){
+        ++handled;
+        std::next(_1x)();
+    }, [&](auto& /*request*/, auto /*context*/, auto /*args*/){
+        ++handled;
+    });
+
+    procs.provide({boost::beast::http::verb::post, "/7/v1.2", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::post, "/7/v1", 11}, test_session::flesh{});
+
+    BOOST_CHECK_EQUAL(handled, 4);
+    BOOST_CHECK_EQUAL(rejected, 2);
+
+} // BOOST_AUTO_TEST_CASE(bad_request_no_1)
+
+BOOST_AUTO_TEST_CASE(arity_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    using pack = http::param::pack<int, int, int, int, int, int, int,
+                                   int, int, int, int, int, int, int, int, int>;
+
+    std::size_t handled = 0;
+
+    // More types than the target captures, the rest stay default constructed
+    router.param<pack>().get("^/(\\d+)/(\\d+)/(\\d+)/(\\d+)/(\\d+)/(\\d+)/(\\d+)/(\\d+)"
+                             "/(\\d+)/(\\d+)/(\\d+)/(\\d+)/(\\d+)/(\\d+)$",
+       [&](auto& /*request*/, auto /*context*/, auto args){
+        BOOST_CHECK_EQUAL(std::tuple_size<decltype (args)>::value, 16);
+        BOOST_CHECK_EQUAL(std::get<0>(args), 1);
+        BOOST_CHECK_EQUAL(std::get<12>(args), 13);
+        BOOST_CHECK_EQUAL(std::get<13>(args), 14);
+        BOOST_CHECK_EQUAL(std::get<14>(args), 0);
+        BOOST_CHECK_EQUAL(std::get<15>(args), 0);
+        ++handled;
+    });
+
+    procs.provide({boost::beast::http::verb::get, "/1/2/3/4/5/6/7/8/9/10/11/12/13/14", 11},
+                  test_session::flesh{});
+
+    BOOST_CHECK_EQUAL(handled, 1);
+
+} // BOOST_AUTO_TEST_CASE(arity_no_1)
+
+BOOST_AUTO_TEST_CASE(segment_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::size_t handled = 0;
+
+    router.param<http::param::pack<int, std::string>>().get("/users/{id:int}/posts/{slug}",
+       [&](auto& /*request*/, auto /*context*/, auto args){
+        BOOST_CHECK_EQUAL(std::get<0>(args), 42);
+        BOOST_CHECK_EQUAL(std::get<1>(args), "hello");
+        ++handled;
+    });
+
+    // Every handler of a chain matches its own segment
+    router.param<http::param::pack<unsigned, std::string>>().post("/files/{id:uint}/{path:*}",
+       [&](auto& /*request*/, auto /*context*/, auto _1x, auto args){
+        BOOST_CHECK_EQUAL(std::get<0>(args), 0);
+        ++handled;
+        std::next(_1x)();
+    }, [&](auto& /*request*/, auto /*context*/, auto _2x, auto args){
+        BOOST_CHECK_EQUAL(std::get<0>(args), 7);
+        ++handled;
+        std::next(_2x)();
+    }, [&](auto& /*request*/, auto /*context*/, auto args){
+        BOOST_CHECK_EQUAL(std::get<0>(args), 7);
+        BOOST_CHECK_EQUAL(std::get<1>(args), "readme");
+        ++handled;
+    });
+
+    procs.provide({boost::beast::http::verb::get, "/users/42/posts/hello", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/users/x/posts/hello", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(handled, 1);
+
+    procs.provide({boost::beast::http::verb::post, "/files/7/readme", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(handled, 4);
+
+} // BOOST_AUTO_TEST_CASE(segment_no_1)
+
+BOOST_AUTO_TEST_CASE(bad_request_no_2) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    using context_type = test_session::context_type;
+
+    std::size_t handled = 0, rejected = 0;
+
+    // Without a handler, a capture that does not convert is answered 400
+    router.param<http::param::pack<int>>().get("/items/(\\d+)",
+       [&](auto& /*request*/, auto /*context*/, auto /*args*/){
+        ++handled;
+    });
+
+    context_type::sent().clear();
+
+    procs.provide({boost::beast::http::verb::get, "/items/7", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/items/99999999999", 11}, test_session::flesh{});
+
+    BOOST_CHECK_EQUAL(handled, 1);
+    BOOST_CHECK((context_type::sent() == std::vector<boost::beast::http::status>{
+                     boost::beast::http::status::bad_request}));
+
+    // A handler replaces the answer
+    router.param<http::param::pack<int>>().on_bad_request(
+                [&](auto& /*request*/, auto /*context*/){
+        ++rejected;
+    }).get("/orders/(\\d+)",
+       [&](auto& /*request*/, auto /*context*/, auto /*args*/){
+        ++handled;
+    });
+
+    context_type::sent().clear();
+
+    procs.provide({boost::beast::http::verb::get, "/orders/99999999999", 11}, test_session::flesh{});
+
+    BOOST_CHECK_EQUAL(rejected, 1);
+    BOOST_CHECK(context_type::sent().empty());
+
+} // BOOST_AUTO_TEST_CASE(bad_request_no_2)
+
+BOOST_AUTO_TEST_CASE(view_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    using pack = http::param::pack<boost::beast::string_view, boost::beast::string_view>;
+
+    std::size_t handled = 0;
+
+    // The views of the first hop still read the target in the last one
+    router.param<pack>().get("/users/{name}/{tab}",
+       [&](auto& /*request*/, auto /*context*/, auto _1x, auto args){
+        BOOST_CHECK(std::get<0>(args).empty());
+        ++handled;
+        std::next(_1x)();
+    }, [&](auto& /*request*/, auto /*context*/, auto _2x, auto args){
+        BOOST_CHECK(std::get<0>(args) == "bob");
+        ++handled;
+        std::next(_2x)();
+    }, [&](auto& request, auto /*context*/, auto args){
+        BOOST_CHECK(request.target() == "/posts");
+        BOOST_CHECK(std::get<0>(args) == "bob");
+        BOOST_CHECK(std::get<1>(args) == "posts");
+        ++handled;
+    });
+
+    router.param<pack>().get("/(\\w+)-(\\w+)",
+       [&](auto& request, auto /*context*/, auto args){
+        BOOST_CHECK(std::get<0>(args) == "left");
+        BOOST_CHECK(std::get<1>(args) == "right");
+        BOOST_CHECK(std::get<1>(args).data() == request.target().data() + 6);
+        ++handled;
+    });
+
+    procs.provide({boost::beast::http::verb::get, "/users/bob/posts", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/left-right", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(handled, 4);
+
+} // BOOST_AUTO_TEST_CASE(view_no_1)
+
+BOOST_AUTO_TEST_CASE(session_regex_no_1) {
+
+    http::basic_router<dfa_session> router{regex_flags};
+
+    http::base::request_processor<dfa_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    // The captures are matched with the regex engine of the session
+    using impl_type = decltype (router.param<http::param::pack<int>>());
+    static_assert (std::is_same<impl_type::regex_type, http::base::dfa_regex>::value,
+                   "The regex of the session is not used");
+
+    std::size_t handled = 0;
+
+    router.param<http::param::pack<int, std::string>>().get("/items/(\\d+)/(\\w+)",
+       [&](auto& /*request*/, auto /*context*/, auto args){
+        BOOST_CHECK_EQUAL(std::get<0>(args), 7);
+        BOOST_CHECK_EQUAL(std::get<1>(args), "name");
+        ++handled;
+    });
+
+    procs.provide({boost::beast::http::verb::get, "/items/7/name", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(handled, 1);
+
+} // BOOST_AUTO_TEST_CASE(session_regex_no_1)
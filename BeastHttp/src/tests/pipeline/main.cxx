@@ -0,0 +1,200 @@
+#define BOOST_TEST_MODULE pipeline_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+#include <http/pipeline.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <unordered_map>
+
+using namespace _0xdead4ead;
+
+class test_session
+{
+public:
+
+    using self_type = test_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class test_session
+
+static const std::regex::flag_type regex_flags = std::regex::ECMAScript;
+
+BOOST_AUTO_TEST_CASE(order_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<std::string> seen;
+    test_session::request_type const* address = nullptr;
+
+    auto auth = [&](auto& request, auto /*context*/, auto next){
+        address = &request;
+        seen.push_back("auth");
+        std::next(next)();
+    };
+
+    auto log = [&](auto& request, auto /*context*/, auto next){
+        BOOST_CHECK(address == &request);
+        seen.push_back("log");
+        std::next(next)();
+        seen.push_back("log done");
+    };
+
+    router.get("^/users/\\d+$", http::make_pipeline(auth, log,
+                                                    [&](auto& request, auto /*context*/){
+        BOOST_CHECK(address == &request);
+        // Stages of a pipeline see the whole target
+        seen.emplace_back(request.target().data(), request.target().size());
+    }));
+
+    procs.provide({boost::beast::http::verb::get, "/users/42", 11}, test_session::flesh{});
+
+    BOOST_CHECK((seen == std::vector<std::string>{
+                     "auth", "log", "/users/42", "log done"}));
+
+} // BOOST_AUTO_TEST_CASE(order_no_1)
+
+BOOST_AUTO_TEST_CASE(short_circuit_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::size_t invoked = 0;
+
+    router.get("^/private$", http::make_pipeline(
+                   [&](auto& request, auto /*context*/, auto next){
+        ++invoked;
+        if (request[boost::beast::http::field::authorization] == "secret")
+            std::next(next)();
+    }, [&](auto& /*request*/, auto /*context*/){
+        invoked += 10;
+    }));
+
+    test_session::request_type request{boost::beast::http::verb::get, "/private", 11};
+    test_session::flesh flesh;
+
+    procs.provide(request, flesh);
+
+    BOOST_CHECK(invoked == 1);
+
+    request.set(boost::beast::http::field::authorization, "secret");
+    procs.provide(request, flesh);
+
+    BOOST_CHECK(invoked == 12);
+
+} // BOOST_AUTO_TEST_CASE(short_circuit_no_1)
+
+BOOST_AUTO_TEST_CASE(continuation_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<std::size_t> seen;
+
+    auto stage = [&](auto& /*request*/, auto /*context*/, auto next){
+        seen.push_back(next.pos());
+        std::next(next)();
+    };
+
+    router.get("^/a$", http::make_pipeline(
+                   [&](auto& /*request*/, auto /*context*/, auto next){
+        seen.push_back(next.pos());
+        // Skips the second stage
+        std::next(next, 2)();
+    }, stage, stage, [&](auto& /*request*/, auto /*context*/){
+        seen.push_back(3);
+    }));
+
+    procs.provide({boost::beast::http::verb::get, "/a", 11}, test_session::flesh{});
+
+    BOOST_CHECK((seen == std::vector<std::size_t>{0, 2, 3}));
+
+} // BOOST_AUTO_TEST_CASE(continuation_no_1)
+
+BOOST_AUTO_TEST_CASE(runtime_chain_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::size_t invoked = 0;
+
+    // A pipeline can close a runtime chain
+    router.get("/api/users", [&](auto& /*request*/, auto /*context*/, auto iterator){
+        ++invoked;
+        std::next(iterator)();
+    }, http::make_pipeline([&](auto& /*request*/, auto /*context*/, auto next){
+        invoked += 10;
+        std::next(next)();
+    }, [&](auto& request, auto /*context*/){
+        BOOST_CHECK(request.target() == "/users");
+        invoked += 100;
+    }));
+
+    procs.provide({boost::beast::http::verb::get, "/api/users", 11}, test_session::flesh{});
+
+    BOOST_CHECK(invoked == 111);
+
+} // BOOST_AUTO_TEST_CASE(runtime_chain_no_1)
@@ -0,0 +1,254 @@
+#define BOOST_TEST_MODULE pool_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/pool.hxx>
+#include <http/base/pooled_buffer.hxx>
+
+#include <http/reactor/session.hxx>
+#include <http/basic_router.hxx>
+
+#include <boost/asio/buffers_iterator.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/http.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace _0xdead4ead;
+
+struct block
+{
+    char data[64];
+};
+
+BOOST_AUTO_TEST_CASE(pool_no_1) {
+
+    using pool_type = http::base::pool<block>;
+
+    http::base::pool_allocator<block> alloc{2};
+
+    block* a = alloc.allocate(1);
+    block* b = alloc.allocate(1);
+    block* c = alloc.allocate(1);
+
+    auto const& pool = pool_type::local();
+    BOOST_CHECK_EQUAL(pool.misses(), 3);
+    BOOST_CHECK_EQUAL(pool.block_size(), sizeof(block));
+
+    // The third block is over capacity
+    alloc.deallocate(a, 1);
+    alloc.deallocate(b, 1);
+    alloc.deallocate(c, 1);
+    BOOST_CHECK_EQUAL(pool.size(), 2);
+
+    block* d = alloc.allocate(1);
+    BOOST_CHECK(d == b);
+    BOOST_CHECK_EQUAL(pool.hits(), 1);
+    BOOST_CHECK_EQUAL(pool.size(), 1);
+
+    // Arrays are not pooled
+    block* e = alloc.allocate(4);
+    BOOST_CHECK_EQUAL(pool.misses(), 3);
+    alloc.deallocate(e, 4);
+    BOOST_CHECK_EQUAL(pool.size(), 1);
+
+    // A block released by another thread stays on its list
+    std::thread{[&]{
+        alloc.deallocate(d, 1);
+        BOOST_CHECK_EQUAL(pool_type::local().size(), 1);
+    }}.join();
+    BOOST_CHECK_EQUAL(pool.size(), 1);
+
+    pool_type::local().clear();
+    BOOST_CHECK_EQUAL(pool.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(pool_no_2) {
+
+    struct shared_tag;
+
+    // Rebound to the control block of std::allocate_shared
+    http::base::pool_allocator<block, shared_tag> alloc{4};
+    auto const& pool = http::base::pool<shared_tag>::local();
+
+    for (int i = 0; i < 8; ++i)
+        BOOST_CHECK(std::allocate_shared<block>(alloc));
+
+    BOOST_CHECK_EQUAL(pool.misses(), 1);
+    BOOST_CHECK_EQUAL(pool.hits(), 7);
+    BOOST_CHECK_EQUAL(pool.size(), 1);
+    BOOST_CHECK(pool.block_size() > sizeof(block));
+}
+
+BOOST_AUTO_TEST_CASE(session_no_1) {
+
+    using http_session = http::reactor::_default::session_type;
+
+    boost::asio::io_context ioc;
+
+    http::basic_router<http_session> router{std::regex::ECMAScript};
+
+    auto const& pool = http_session::pool();
+
+    // Off by default
+    http_session::make(boost::asio::ip::tcp::socket{ioc}, router);
+    BOOST_CHECK_EQUAL(pool.misses(), 0);
+
+    http_session::enable_pool(16);
+
+    for (int i = 0; i < 10; ++i)
+        http_session::make(boost::asio::ip::tcp::socket{ioc}, router);
+
+    BOOST_CHECK_EQUAL(pool.misses(), 1);
+    BOOST_CHECK_EQUAL(pool.hits(), 9);
+    BOOST_CHECK_EQUAL(pool.size(), 1);
+
+    // Sessions alive at once take a block each
+    {
+        auto first = http_session::make(boost::asio::ip::tcp::socket{ioc}, router);
+        auto second = http_session::make(boost::asio::ip::tcp::socket{ioc}, router);
+        BOOST_CHECK_EQUAL(pool.size(), 0);
+        BOOST_CHECK_EQUAL(pool.misses(), 2);
+    }
+
+    BOOST_CHECK_EQUAL(pool.size(), 2);
+
+    http_session::enable_pool(0);
+}
+
+BOOST_AUTO_TEST_CASE(pooled_buffer_no_1) {
+
+    using buffer_type = http::base::pooled_buffer<64>;
+
+    buffer_type buffer;
+    BOOST_CHECK(not buffer.borrowed());
+    BOOST_CHECK_EQUAL(buffer.capacity(), 0);
+    BOOST_CHECK_EQUAL(buffer.max_size(), 64);
+
+    auto write = [&](std::string const& text){
+        auto b = buffer.prepare(text.size());
+        std::memcpy(b.data(), text.data(), text.size());
+        buffer.commit(text.size());
+    };
+
+    auto read = [&]{
+        auto b = buffer.data();
+        return std::string{static_cast<const char*>(b.data()), b.size()};
+    };
+
+    write("GET / HTTP/1.1\r\n");
+    BOOST_CHECK(buffer.borrowed());
+    BOOST_CHECK_EQUAL(buffer_type::stats().borrowed, 64);
+
+    buffer.consume(4);
+    BOOST_CHECK_EQUAL(read(), "/ HTTP/1.1\r\n");
+
+    // Pending bytes are moved to the front when the tail is too short
+    write(std::string(40, 'x'));
+    BOOST_CHECK_EQUAL(buffer.size(), 52);
+    BOOST_CHECK_EQUAL(read().substr(0, 12), "/ HTTP/1.1\r\n");
+
+    BOOST_CHECK_THROW(buffer.prepare(13), std::length_error);
+
+    // Consuming everything gives the block back
+    buffer.consume(buffer.size());
+    BOOST_CHECK(not buffer.borrowed());
+    BOOST_CHECK_EQUAL(buffer_type::stats().borrowed, 0);
+    BOOST_CHECK_EQUAL(buffer_type::stats().idle, 64);
+
+    write("next");
+    BOOST_CHECK_EQUAL(buffer_type::pool().hits(), 1);
+    BOOST_CHECK_EQUAL(buffer_type::stats().idle, 0);
+
+    buffer_type other{std::move(buffer)};
+    BOOST_CHECK(not buffer.borrowed());
+    BOOST_CHECK_EQUAL(read(), "");
+    BOOST_CHECK(other.borrowed());
+}
+
+BOOST_AUTO_TEST_CASE(pooled_buffer_no_2) {
+
+    using buffer_type = http::base::pooled_buffer<512>;
+
+    using http_session = http::reactor::session<
+        boost::beast::http::string_body,
+        boost::beast::http::request_parser<boost::beast::http::string_body>,
+        boost::beast::http::response_serializer<boost::beast::http::string_body>,
+        buffer_type>;
+
+    boost::asio::io_context ioc;
+
+    http::basic_router<http_session> router{std::regex::ECMAScript};
+
+    router.get("^/$", [](auto request, auto context){
+        boost::beast::http::response<boost::beast::http::string_body> response{
+            boost::beast::http::status::ok, request.version()};
+        response.body() = "pooled";
+        response.prepare_payload();
+        context.send(std::move(response));
+    });
+
+    boost::system::error_code last_error;
+    auto on_error = [&](boost::system::error_code ec, boost::string_view){
+        last_error = ec;
+    };
+
+    boost::asio::ip::tcp::acceptor acceptor{ioc, {boost::asio::ip::address_v4::loopback(), 0}};
+    acceptor.async_accept([&](boost::system::error_code ec, boost::asio::ip::tcp::socket socket){
+        BOOST_REQUIRE(not ec);
+        http_session::recv(std::move(socket), router, on_error);
+    });
+
+    std::atomic<int> step{0};
+
+    std::thread client{[&]{
+        boost::asio::io_context client_ioc;
+        boost::asio::ip::tcp::socket socket{client_ioc};
+        socket.connect(acceptor.local_endpoint());
+
+        // Two pipelined requests, then an idle keep-alive connection
+        const std::string request = "GET / HTTP/1.1\r\nHost: test\r\n\r\n";
+        boost::asio::write(socket, boost::asio::buffer(request + request));
+
+        boost::beast::flat_buffer buffer;
+        for (int i = 0; i < 2; ++i) {
+            boost::beast::http::response<boost::beast::http::string_body> response;
+            boost::beast::http::read(socket, buffer, response);
+            BOOST_CHECK_EQUAL(response.body(), "pooled");
+        }
+
+        step = 1;
+        while (step != 2)
+            std::this_thread::yield();
+
+        // A header that does not fit in the block
+        const std::string large = "GET / HTTP/1.1\r\nX-Large: " + std::string(1024, 'x') + "\r\n\r\n";
+        boost::system::error_code ec;
+        boost::asio::write(socket, boost::asio::buffer(large), ec);
+
+        step = 3;
+    }};
+
+    while (step != 1)
+        ioc.run_one_for(std::chrono::milliseconds{10});
+
+    ioc.poll();
+
+    // The connection waits for its next request without a buffer
+    BOOST_CHECK_EQUAL(buffer_type::stats().borrowed, 0);
+    BOOST_CHECK_EQUAL(buffer_type::stats().idle, 512);
+
+    step = 2;
+    while (not last_error)
+        ioc.run_one_for(std::chrono::milliseconds{10});
+
+    BOOST_CHECK(last_error == boost::beast::http::error::buffer_overflow);
+
+    client.join();
+    ioc.poll();
+}
@@ -0,0 +1,258 @@
+#define BOOST_TEST_MODULE push_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/outbox.hxx>
+
+#include <http/reactor/session.hxx>
+#include <http/basic_router.hxx>
+
+#include <boost/asio/buffers_iterator.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/http.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace _0xdead4ead;
+
+using response_type = boost::beast::http::response<boost::beast::http::string_body>;
+
+using http_session = http::reactor::_default::session_type;
+
+// An event of about 1 KiB, its number first
+static response_type
+make_event(int id)
+{
+    response_type response{boost::beast::http::status::ok, 11};
+    response.body() = std::to_string(id) + ':' + std::string(1024, '.');
+    response.prepare_payload();
+    return response;
+}
+
+static int
+event_id(response_type const& response)
+{
+    return std::stoi(response.body().substr(0, response.body().find(':')));
+}
+
+BOOST_AUTO_TEST_CASE(outbox_no_1) {
+
+    using overflow = http::base::outbox::overflow;
+
+    http::base::outbox outbox;
+    boost::beast::error_code ec;
+
+    auto event = make_event(0);
+    BOOST_CHECK(outbox.push(event, 4096, overflow::close, ec));
+    const std::size_t size = outbox.size();
+    BOOST_CHECK(size > 1024);
+    BOOST_CHECK(outbox.pending());
+
+    // All the waiting messages go in one write
+    BOOST_CHECK(outbox.push(event, 4096, overflow::close, ec));
+    BOOST_CHECK_EQUAL(boost::asio::buffer_size(outbox.flush()), 2 * size);
+    BOOST_CHECK(outbox.writing());
+    BOOST_CHECK(not outbox.pending());
+
+    // The bytes being written count against the limit
+    BOOST_CHECK(outbox.push(event, 3 * size, overflow::drop_newest, ec));
+    BOOST_CHECK(not outbox.push(event, 3 * size, overflow::drop_newest, ec));
+    BOOST_CHECK_EQUAL(outbox.dropped(), 1);
+    BOOST_CHECK_EQUAL(outbox.size(), 3 * size);
+
+    // Only waiting messages are dropped to make room
+    for (int id = 1; id < 4; ++id) {
+        auto next = make_event(id);
+        BOOST_CHECK(outbox.push(next, 4 * size, overflow::drop_oldest, ec));
+    }
+
+    BOOST_CHECK_EQUAL(outbox.dropped(), 3);
+    BOOST_CHECK_EQUAL(outbox.size(), 4 * size);
+
+    outbox.consume();
+    auto const& buffers = outbox.flush();
+
+    // Events 1, 2 and 3 were not sent at once, 3 is the newest
+    std::string text{boost::asio::buffers_begin(buffers), boost::asio::buffers_end(buffers)};
+    BOOST_CHECK_EQUAL(text.size(), 2 * size);
+    BOOST_CHECK(text.find("\r\n\r\n2:") != std::string::npos);
+    BOOST_CHECK(text.find("\r\n\r\n3:") != std::string::npos);
+
+    // A message larger than the limit is never taken
+    outbox.consume();
+    BOOST_CHECK(not outbox.push(event, size - 1, overflow::drop_oldest, ec));
+    BOOST_CHECK_EQUAL(outbox.size(), 0);
+    BOOST_CHECK(not ec);
+}
+
+// A client that reads nothing, with a receive window kept small
+static boost::asio::ip::tcp::socket
+connect_slow(boost::asio::io_context& ioc, boost::asio::ip::tcp::endpoint endpoint)
+{
+    boost::asio::ip::tcp::socket socket{ioc};
+    socket.open(endpoint.protocol());
+    socket.set_option(boost::asio::socket_base::receive_buffer_size{4096});
+    socket.connect(endpoint);
+
+    const std::string request = "GET /sse HTTP/1.1\r\nHost: test\r\n\r\n";
+    boost::asio::write(socket, boost::asio::buffer(request));
+
+    return socket;
+}
+
+struct push_server
+{
+    boost::asio::io_context ioc;
+
+    http::basic_router<http_session> router{std::regex::ECMAScript};
+
+    boost::asio::ip::tcp::acceptor acceptor{ioc, {boost::asio::ip::address_v4::loopback(), 0}};
+
+    std::vector<std::size_t> pressures;
+
+    std::vector<std::string> errors;
+
+    std::atomic<bool> pushed{false};
+
+    explicit
+    push_server(int events)
+    {
+        router.get("^/sse$", [this, events](auto /*request*/, auto context){
+            auto on_backpressure = [this](auto /*context*/, std::size_t pending){
+                pressures.push_back(pending);
+            };
+
+            http_session::context_type::set::on_backpressure(context, on_backpressure);
+
+            for (int id = 0; id < events; ++id)
+                context.push(make_event(id));
+
+            pushed = true;
+        });
+
+        router.get("^/ping$", [](auto request, auto context){
+            response_type response{boost::beast::http::status::ok, request.version()};
+            response.body() = "pong";
+            response.prepare_payload();
+            context.send(std::move(response));
+        });
+
+        accept();
+    }
+
+    void
+    accept()
+    {
+        acceptor.async_accept([this](boost::system::error_code ec, boost::asio::ip::tcp::socket socket){
+            if (ec)
+                return;
+
+            socket.set_option(boost::asio::socket_base::send_buffer_size{4096});
+            http_session::recv(std::move(socket), router, [this](boost::system::error_code ec, boost::string_view from){
+                errors.push_back(from.to_string() + ' ' + ec.message());
+            });
+
+            accept();
+        });
+    }
+
+    void
+    stop()
+    {
+        boost::asio::post(ioc, [this]{ ioc.stop(); });
+    }
+
+}; // struct push_server
+
+BOOST_AUTO_TEST_CASE(session_no_1) {
+
+    http_session::limit_push(16 * 1024, 64 * 1024, http_session::push_overflow::close);
+
+    push_server server{1000};
+
+    std::string pong;
+
+    std::thread client{[&]{
+        boost::asio::io_context client_ioc;
+        auto slow = connect_slow(client_ioc, server.acceptor.local_endpoint());
+
+        while (not server.pushed)
+            std::this_thread::yield();
+
+        // The thread of the session still serves other connections
+        boost::asio::ip::tcp::socket socket{client_ioc};
+        socket.connect(server.acceptor.local_endpoint());
+        boost::asio::write(socket, boost::asio::buffer(std::string{"GET /ping HTTP/1.1\r\nHost: test\r\n\r\n"}));
+
+        boost::beast::flat_buffer buffer;
+        response_type response;
+        boost::beast::http::read(socket, buffer, response);
+        pong = response.body();
+
+        server.stop();
+    }};
+
+    server.ioc.run();
+    client.join();
+
+    http_session::limit_push(64 * 1024, 1024 * 1024, http_session::push_overflow::close);
+
+    BOOST_CHECK_EQUAL(pong, "pong");
+
+    // Slow to read, the client is dropped past the limit
+    BOOST_REQUIRE(not server.pressures.empty());
+    BOOST_CHECK(server.pressures.front() >= 16 * 1024);
+    BOOST_REQUIRE(not server.errors.empty());
+    BOOST_CHECK_EQUAL(server.errors.front().substr(0, 15), "limit/do_push N");
+    BOOST_CHECK_EQUAL(std::count_if(server.errors.begin(), server.errors.end(), [](std::string const& error){
+        return error.find("limit/do_push") == 0;
+    }), 1);
+}
+
+BOOST_AUTO_TEST_CASE(session_no_2) {
+
+    http_session::limit_push(16 * 1024, 64 * 1024, http_session::push_overflow::drop_oldest);
+
+    push_server server{1000};
+
+    std::vector<int> received;
+
+    std::thread client{[&]{
+        boost::asio::io_context client_ioc;
+        auto slow = connect_slow(client_ioc, server.acceptor.local_endpoint());
+
+        while (not server.pushed)
+            std::this_thread::yield();
+
+        // Reads late, the oldest events were dropped, the newest kept
+        boost::beast::flat_buffer buffer;
+        do {
+            response_type response;
+            boost::beast::http::read(slow, buffer, response);
+            received.push_back(event_id(response));
+        } while (received.back() != 999);
+
+        server.stop();
+    }};
+
+    server.ioc.run();
+    client.join();
+
+    http_session::limit_push(64 * 1024, 1024 * 1024, http_session::push_overflow::close);
+
+    BOOST_CHECK(received.size() < 1000);
+    BOOST_CHECK(std::is_sorted(received.begin(), received.end()));
+    BOOST_CHECK(std::adjacent_find(received.begin(), received.end()) == received.end());
+    BOOST_CHECK(server.errors.empty());
+
+    // Drained, the producer is told so
+    BOOST_REQUIRE(server.pressures.size() >= 1);
+    BOOST_CHECK(server.pressures.front() >= 16 * 1024);
+    BOOST_CHECK_EQUAL(server.pressures.back(), 0);
+}
@@ -0,0 +1,554 @@
+#define BOOST_TEST_MODULE queue_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/pipelined.hxx>
+#include <http/base/queue.hxx>
+#include <http/base/write_batch.hxx>
+
+#include <http/reactor/session.hxx>
+#include <http/basic_router.hxx>
+
+#include <boost/asio/buffers_iterator.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/http.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace _0xdead4ead;
+
+using response_type = boost::beast::http::response<boost::beast::http::string_body>;
+
+// A body too large for the slots of the queue
+struct large_body
+{
+    struct value_type
+    {
+        std::string text;
+        char padding[512];
+    };
+
+    static std::uint64_t
+    size(value_type const& body)
+    {
+        return body.text.size();
+    }
+
+    class writer
+    {
+        value_type const& body_;
+
+    public:
+
+        using const_buffers_type = boost::asio::const_buffer;
+
+        template<bool isRequest, class Fields>
+        writer(boost::beast::http::header<isRequest, Fields> const&, value_type const& body)
+            : body_(body)
+        {
+        }
+
+        void
+        init(boost::beast::error_code& ec)
+        {
+            ec = {};
+        }
+
+        boost::optional<std::pair<const_buffers_type, bool>>
+        get(boost::beast::error_code& ec)
+        {
+            ec = {};
+            return {{const_buffers_type{body_.text.data(), body_.text.size()}, false}};
+        }
+    };
+};
+
+static std::string
+text(std::string const& body)
+{
+    return body;
+}
+
+static std::string
+text(large_body::value_type const& body)
+{
+    return body.text;
+}
+
+static std::string
+text(http::base::write_batch& batch)
+{
+    auto const& buffers = batch.buffers();
+    return {boost::asio::buffers_begin(buffers), boost::asio::buffers_end(buffers)};
+}
+
+// Records the writes started by the queue, as the session's do_write
+class test_flesh
+{
+public:
+
+    using queue_type = http::base::queue<test_flesh, 4, sizeof(response_type)>;
+
+    friend queue_type;
+
+    std::vector<std::string> written;
+
+    queue_type queue;
+
+    explicit
+    test_flesh(std::size_t limit = 0)
+        : queue{*this, limit}
+    {
+    }
+
+private:
+
+    template<class Response>
+    void
+    do_write(Response& response)
+    {
+        written.push_back(text(response.body()));
+    }
+
+    void
+    do_write(http::base::write_batch& batch)
+    {
+        written.push_back(text(batch));
+    }
+
+}; // class test_flesh
+
+static response_type
+make_response(std::string body)
+{
+    response_type response;
+    response.body() = std::move(body);
+    return response;
+}
+
+BOOST_AUTO_TEST_CASE(queue_no_1) {
+
+    test_flesh flesh;
+
+    auto r1 = make_response("1");
+    flesh.queue(r1);
+
+    // The first response is written at once, the next ones wait for it
+    BOOST_CHECK_EQUAL(flesh.written.size(), 1);
+
+    for (auto body : {"2", "3", "4"}) {
+        auto r = make_response(body);
+        flesh.queue(r);
+    }
+
+    BOOST_CHECK(flesh.queue.is_full());
+    BOOST_CHECK_EQUAL(flesh.written.size(), 1);
+
+    // Was full, so the session starts reading again
+    BOOST_CHECK(flesh.queue.on_write());
+    BOOST_CHECK(not flesh.queue.on_write());
+    BOOST_CHECK_EQUAL(flesh.queue.size(), 2);
+
+    // The ring wraps around
+    for (auto body : {"5", "6"}) {
+        auto r = make_response(body);
+        flesh.queue(r);
+    }
+
+    while (flesh.queue.size() > 1)
+        flesh.queue.on_write();
+
+    BOOST_CHECK((flesh.written == std::vector<std::string>{"1", "2", "3", "4", "5", "6"}));
+}
+
+BOOST_AUTO_TEST_CASE(queue_no_2) {
+
+    test_flesh flesh;
+
+    // Past the depth, responses keep their order through the overflow list
+    for (int i = 0; i < 7; ++i) {
+        auto r = make_response(std::to_string(i));
+        flesh.queue(r);
+    }
+
+    BOOST_CHECK_EQUAL(flesh.queue.size(), 7);
+
+    for (int i = 0; i < 5; ++i)
+        flesh.queue.on_write();
+
+    // The ring is empty, the overflow list is drained before it is used again
+    for (int i = 7; i < 9; ++i) {
+        auto r = make_response(std::to_string(i));
+        flesh.queue(r);
+    }
+
+    while (flesh.queue.size() > 1)
+        flesh.queue.on_write();
+
+    std::vector<std::string> expected;
+    for (int i = 0; i < 9; ++i)
+        expected.push_back(std::to_string(i));
+
+    BOOST_CHECK(flesh.written == expected);
+}
+
+BOOST_AUTO_TEST_CASE(queue_no_3) {
+
+    // Responses larger than a slot are kept on the heap
+    using large_response = boost::beast::http::response<large_body>;
+    static_assert(sizeof(large_response) > sizeof(response_type), "");
+
+    test_flesh flesh;
+
+    auto small = make_response("small");
+    flesh.queue(small);
+
+    large_response large;
+    large.body().text = "large";
+    flesh.queue(large);
+
+    flesh.queue.on_write();
+
+    BOOST_CHECK((flesh.written == std::vector<std::string>{"small", "large"}));
+}
+
+static std::string
+serialized(response_type const& response)
+{
+    std::ostringstream stream;
+    stream << response;
+    return stream.str();
+}
+
+BOOST_AUTO_TEST_CASE(write_batch_no_1) {
+
+    http::base::write_batch batch{256};
+
+    auto first = make_response("first");
+    first.prepare_payload();
+    BOOST_CHECK(batch.append(first));
+
+    // String bodies are referenced, not copied
+    bool referenced = false;
+    for (auto const& buffer : batch.buffers())
+        referenced |= buffer.data() == first.body().data();
+    BOOST_CHECK(referenced);
+
+    // Chunked bodies are not taken
+    auto chunked = make_response("chunked");
+    chunked.chunked(true);
+    BOOST_CHECK(not batch.append(chunked));
+
+    // Other bodies are copied, within the limit
+    boost::beast::http::response<large_body> large;
+    large.body().text = std::string(64, 'x');
+    large.prepare_payload();
+    BOOST_CHECK(batch.append(large));
+
+    large.body().text = std::string(256, 'y');
+    large.prepare_payload();
+    BOOST_CHECK(not batch.append(large));
+
+    // So are headers
+    auto header = make_response("header");
+    header.set("X-Large", std::string(256, 'z'));
+    BOOST_CHECK(not batch.append(header));
+
+    auto last = make_response("last");
+    last.keep_alive(false);
+    last.prepare_payload();
+    BOOST_CHECK(batch.append(last));
+
+    BOOST_CHECK_EQUAL(batch.size(), 3);
+    BOOST_CHECK(batch.need_eof());
+
+    std::ostringstream large_text;
+    large.body().text = std::string(64, 'x');
+    large.prepare_payload();
+    large_text << large.base() << large.body().text;
+
+    BOOST_CHECK_EQUAL(text(batch), serialized(first) + large_text.str() + serialized(last));
+
+    batch.clear();
+    BOOST_CHECK_EQUAL(batch.size(), 0);
+    BOOST_CHECK(batch.buffers().empty());
+}
+
+BOOST_AUTO_TEST_CASE(queue_no_4) {
+
+    test_flesh flesh{1024};
+
+    std::vector<response_type> responses;
+    for (auto body : {"1", "2", "3", "4"}) {
+        responses.push_back(make_response(body));
+        responses.back().prepare_payload();
+    }
+    responses[2].keep_alive(false);
+
+    // Alone in the queue, the first response is written as usual
+    flesh.queue(responses[0]);
+    BOOST_CHECK_EQUAL(flesh.written.size(), 1);
+
+    for (std::size_t i = 1; i < responses.size(); ++i) {
+        auto r = responses[i];
+        flesh.queue(r);
+    }
+
+    // The pending ones go in one write, up to the response closing the
+    // connection
+    BOOST_CHECK(flesh.queue.is_full());
+    BOOST_CHECK(flesh.queue.on_write());
+    BOOST_CHECK_EQUAL(flesh.written.size(), 2);
+    BOOST_CHECK_EQUAL(flesh.written[1], serialized(responses[1]) + serialized(responses[2]));
+
+    BOOST_CHECK(not flesh.queue.on_write());
+    BOOST_CHECK_EQUAL(flesh.queue.size(), 1);
+    BOOST_CHECK_EQUAL(flesh.written.size(), 3);
+    BOOST_CHECK_EQUAL(flesh.written[2], "4");
+}
+
+BOOST_AUTO_TEST_CASE(session_no_1) {
+
+    using http_session = http::reactor::_default::session_type;
+
+    boost::asio::io_context ioc;
+
+    http::basic_router<http_session> router{std::regex::ECMAScript};
+
+    router.get("^/(\\d+)$", [](auto request, auto context){
+        response_type response{boost::beast::http::status::ok, request.version()};
+        response.body() = request.target().substr(1).to_string();
+        response.keep_alive(request.keep_alive());
+        response.prepare_payload();
+        context.send(std::move(response));
+    });
+
+    http_session::enable_coalescing(4096);
+
+    boost::asio::ip::tcp::acceptor acceptor{ioc, {boost::asio::ip::address_v4::loopback(), 0}};
+    acceptor.async_accept([&](boost::system::error_code ec, boost::asio::ip::tcp::socket socket){
+        BOOST_REQUIRE(not ec);
+        http_session::recv(std::move(socket), router);
+    });
+
+    std::vector<std::string> bodies;
+    boost::system::error_code eof;
+
+    std::thread client{[&]{
+        boost::asio::io_context client_ioc;
+        boost::asio::ip::tcp::socket socket{client_ioc};
+        socket.connect(acceptor.local_endpoint());
+
+        // Pipelined requests, the last one closing the connection
+        std::string requests;
+        for (int i = 0; i < 40; ++i)
+            requests += "GET /" + std::to_string(i) + " HTTP/1.1\r\nHost: test\r\n\r\n";
+        requests += "GET /40 HTTP/1.1\r\nHost: test\r\nConnection: close\r\n\r\n";
+        boost::asio::write(socket, boost::asio::buffer(requests));
+
+        boost::beast::flat_buffer buffer;
+        for (int i = 0; i <= 40; ++i) {
+            response_type response;
+            boost::beast::http::read(socket, buffer, response);
+            bodies.push_back(response.body());
+        }
+
+        char byte;
+        boost::asio::read(socket, boost::asio::buffer(&byte, 1), eof);
+    }};
+
+    ioc.run();
+    client.join();
+
+    http_session::enable_coalescing(0);
+
+    BOOST_REQUIRE_EQUAL(bodies.size(), 41);
+    for (int i = 0; i <= 40; ++i)
+        BOOST_CHECK_EQUAL(bodies[i], std::to_string(i));
+
+    BOOST_CHECK(eof == boost::asio::error::eof);
+}
+
+BOOST_AUTO_TEST_CASE(session_no_2) {
+
+    using http_session = http::reactor::_default::session_type;
+
+    boost::asio::io_context ioc;
+
+    http::basic_router<http_session> router{std::regex::ECMAScript};
+
+    router.get("^/(\\w+)$", [](auto request, auto context){
+        response_type response{boost::beast::http::status::ok, request.version()};
+        response.body() = request.target().substr(1).to_string();
+        response.keep_alive(request.keep_alive());
+        response.prepare_payload();
+        context.send(std::move(response));
+    });
+
+    http_session::enable_coalescing(4096);
+
+    boost::asio::ip::tcp::acceptor acceptor{ioc, {boost::asio::ip::address_v4::loopback(), 0}};
+    acceptor.async_accept([&](boost::system::error_code ec, boost::asio::ip::tcp::socket socket){
+        BOOST_REQUIRE(not ec);
+        http_session::recv(std::move(socket), router);
+    });
+
+    std::vector<std::string> bodies;
+
+    std::thread client{[&]{
+        boost::asio::io_context client_ioc;
+        boost::asio::ip::tcp::socket socket{client_ioc};
+        socket.connect(acceptor.local_endpoint());
+
+        // The response is not held back for a request sent in part
+        boost::asio::write(socket, boost::asio::buffer(
+                               std::string{"GET /first HTTP/1.1\r\nHost: test\r\n\r\nGET /second HTTP/1.1\r\n"}));
+
+        boost::beast::flat_buffer buffer;
+        response_type first;
+        boost::beast::http::read(socket, buffer, first);
+        bodies.push_back(first.body());
+
+        boost::asio::write(socket, boost::asio::buffer(
+                               std::string{"Host: test\r\nConnection: close\r\n\r\n"}));
+
+        response_type second;
+        boost::beast::http::read(socket, buffer, second);
+        bodies.push_back(second.body());
+    }};
+
+    ioc.run();
+    client.join();
+
+    http_session::enable_coalescing(0);
+
+    BOOST_CHECK((bodies == std::vector<std::string>{"first", "second"}));
+}
+
+BOOST_AUTO_TEST_CASE(pipelined_no_1) {
+
+    auto pipelined = [](std::string const& text){
+        return http::base::pipelined(boost::asio::buffer(text));
+    };
+
+    BOOST_CHECK(not pipelined(""));
+    BOOST_CHECK(not pipelined("GET / HTTP/1.1\r\nHost: test\r\n"));
+    BOOST_CHECK(pipelined("GET / HTTP/1.1\r\nHost: test\r\n\r\n"));
+
+    // The body counts, whatever the case of the field
+    BOOST_CHECK(not pipelined("POST / HTTP/1.1\r\ncontent-LENGTH: 4\r\n\r\nabc"));
+    BOOST_CHECK(pipelined("POST / HTTP/1.1\r\nContent-Length:4\r\n\r\nabcd"));
+
+    // A chunked body is never taken as whole
+    BOOST_CHECK(not pipelined("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n0\r\n\r\n"));
+}
+
+// Echoes the target of any request, on a session coalescing responses
+struct echo_server
+{
+    using http_session = http::reactor::_default::session_type;
+
+    boost::asio::io_context ioc;
+
+    http::basic_router<http_session> router{std::regex::ECMAScript};
+
+    boost::asio::ip::tcp::acceptor acceptor{ioc, {boost::asio::ip::address_v4::loopback(), 0}};
+
+    echo_server()
+    {
+        router.all("^/(\\w+)$", [](auto request, auto context){
+            response_type response{boost::beast::http::status::ok, request.version()};
+            response.body() = request.target().substr(1).to_string();
+            response.keep_alive(request.keep_alive());
+            response.prepare_payload();
+            context.send(std::move(response));
+        });
+
+        http_session::enable_coalescing(4096);
+
+        acceptor.async_accept([this](boost::system::error_code ec, boost::asio::ip::tcp::socket socket){
+            BOOST_REQUIRE(not ec);
+            http_session::recv(std::move(socket), router);
+        });
+    }
+
+    ~echo_server()
+    {
+        http_session::enable_coalescing(0);
+    }
+
+}; // struct echo_server
+
+BOOST_AUTO_TEST_CASE(session_no_3) {
+
+    echo_server server;
+
+    std::string first;
+    boost::system::error_code eof;
+
+    std::thread client{[&]{
+        boost::asio::io_context client_ioc;
+        boost::asio::ip::tcp::socket socket{client_ioc};
+        socket.connect(server.acceptor.local_endpoint());
+
+        // The response held back for the next request is still written
+        // when that request turns out to be malformed
+        boost::asio::write(socket, boost::asio::buffer(
+                               std::string{"GET /first HTTP/1.1\r\nHost: test\r\n\r\nNOT A REQUEST\r\n\r\n"}));
+
+        boost::beast::flat_buffer buffer;
+        response_type response;
+        boost::beast::http::read(socket, buffer, response);
+        first = response.body();
+
+        char byte;
+        boost::asio::read(socket, boost::asio::buffer(&byte, 1), eof);
+    }};
+
+    server.ioc.run();
+    client.join();
+
+    BOOST_CHECK_EQUAL(first, "first");
+    BOOST_CHECK(eof == boost::asio::error::eof);
+}
+
+BOOST_AUTO_TEST_CASE(session_no_4) {
+
+    echo_server server;
+
+    std::vector<std::string> bodies;
+
+    std::thread client{[&]{
+        boost::asio::io_context client_ioc;
+        boost::asio::ip::tcp::socket socket{client_ioc};
+        socket.connect(server.acceptor.local_endpoint());
+
+        // The header of the next request is whole, its body is not
+        boost::asio::write(socket, boost::asio::buffer(std::string{
+                               "GET /first HTTP/1.1\r\nHost: test\r\n\r\n"
+                               "POST /second HTTP/1.1\r\nHost: test\r\nConnection: close\r\n"
+                               "Content-Length: 6\r\n\r\nsec"}));
+
+        boost::beast::flat_buffer buffer;
+        response_type first;
+        boost::beast::http::read(socket, buffer, first);
+        bodies.push_back(first.body());
+
+        boost::asio::write(socket, boost::asio::buffer(std::string{"ond"}));
+
+        response_type second;
+        boost::beast::http::read(socket, buffer, second);
+        bodies.push_back(second.body());
+    }};
+
+    server.ioc.run();
+    client.join();
+
+    BOOST_CHECK((bodies == std::vector<std::string>{"first", "second"}));
+}
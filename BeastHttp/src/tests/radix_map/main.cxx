@@ -0,0 +1,312 @@
+#define BOOST_TEST_MODULE radix_map_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/radix_map.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/param.hxx>
+#include <http/chain_router.hxx>
+#include <http/basic_router.hxx>
+#include <http/chain_router.hxx>
+#include <http/literals.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <unordered_map>
+
+using namespace _0xdead4ead;
+
+class test_session
+{
+public:
+
+    using self_type = test_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = http::base::radix_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class test_session
+
+static const std::regex::flag_type regex_flags = std::regex::ECMAScript;
+
+BOOST_AUTO_TEST_CASE(literal_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<std::string> invoked;
+
+    router.get("/api/users", [&](auto request, auto /*context*/){
+        BOOST_CHECK(request.target() == "/api/users");
+        invoked.push_back("users");
+    });
+
+    router.get("^/api/user$", [&](auto request, auto /*context*/){
+        BOOST_CHECK(request.target() == "/api/user");
+        invoked.push_back("user");
+    });
+
+    router.get("/api/orders", [&](auto request, auto /*context*/){
+        BOOST_CHECK(request.target() == "/api/orders");
+        invoked.push_back("orders");
+    });
+
+    procs.provide({boost::beast::http::verb::get, "/api/users", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/api/user", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/api/orders", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/api/use", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/api/users/", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::post, "/api/users", 11}, test_session::flesh{});
+
+    BOOST_CHECK_EQUAL(invoked.size(), 3);
+    BOOST_CHECK_EQUAL(router.method_map()->at(boost::beast::http::verb::get).fallback().size(), 0);
+
+} // BOOST_AUTO_TEST_CASE(literal_no_1)
+
+BOOST_AUTO_TEST_CASE(named_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::size_t count = 0;
+
+    router.get("/api/users/:id/orders", [&](auto request, auto /*context*/){
+        BOOST_CHECK(request.target() == "/api/users/42/orders" or
+                    request.target() == "/api/users/me/orders");
+        count++;
+    });
+
+    router.get("/api/users/me/orders", [&](auto request, auto /*context*/){
+        BOOST_CHECK(request.target() == "/api/users/me/orders");
+        count += 10;
+    });
+
+    procs.provide({boost::beast::http::verb::get, "/api/users/42/orders", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/api/users//orders", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/api/users/4/2/orders", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(count, 1);
+
+    // Both the literal and the named route match, as with the regex scan
+    count = 0;
+    procs.provide({boost::beast::http::verb::get, "/api/users/me/orders", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(count, 11);
+
+} // BOOST_AUTO_TEST_CASE(named_no_1)
+
+BOOST_AUTO_TEST_CASE(shape_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    std::vector<std::string> invoked;
+
+    // Different keys, one node of the tree
+    router.get("/users/:id", [&](auto /*request*/, auto /*context*/){
+        invoked.push_back("id");
+    });
+
+    router.get("/users/{name}", [&](auto /*request*/, auto /*context*/){
+        invoked.push_back("name");
+    });
+
+    router.get("/a/{x:int}", [&](auto /*request*/, auto /*context*/){
+        invoked.push_back("x");
+    });
+
+    router.get("/a/{y:int}", [&](auto /*request*/, auto /*context*/){
+        invoked.push_back("y");
+    });
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    procs.provide({boost::beast::http::verb::get, "/users/42", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/a/7", 11}, test_session::flesh{});
+
+    BOOST_CHECK((invoked == std::vector<std::string>{"id", "name", "x", "y"}));
+
+    // A copy, as a published snapshot is, keeps both and their order
+    auto copy = router.method_map()->at(boost::beast::http::verb::get);
+
+    std::vector<std::string> keys;
+    copy.match("/users/42", [&](auto const& value){
+        keys.push_back(value.first);
+    });
+
+    BOOST_CHECK((keys == std::vector<std::string>{"/users/:id", "/users/{name}"}));
+
+} // BOOST_AUTO_TEST_CASE(shape_no_1)
+
+BOOST_AUTO_TEST_CASE(fallback_no_1) {
+
+    http::chain_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::size_t count = 0;
+
+    router.route("/files/\\w+\\.txt")
+            .get([&](auto request, auto /*context*/){
+        BOOST_CHECK(request.target() == "/files/a.txt");
+        count++;
+    });
+
+    router.route("/files/readme")
+            .get([&](auto request, auto /*context*/){
+        BOOST_CHECK(request.target() == "/files/readme");
+        count += 10;
+    });
+
+    router.route("/.*")
+            .all([&](auto /*request*/, auto /*context*/){
+        count += 100;
+    });
+
+    procs.provide({boost::beast::http::verb::get, "/files/a.txt", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/files/readme", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(count, 11);
+
+    procs.provide({boost::beast::http::verb::get, "/unknown", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(count, 111);
+
+} // BOOST_AUTO_TEST_CASE(fallback_no_1)
+
+BOOST_AUTO_TEST_CASE(param_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::size_t count = 0;
+
+    using pack = http::param::pack<int, std::string>;
+
+    router.param<pack>().get("/api/users/:id/orders/:name",
+       [&](auto request, auto /*context*/, auto args){
+        count++;
+        BOOST_CHECK(request.target() == "/api/users/42/orders/abc");
+        BOOST_CHECK_EQUAL(std::get<0>(args), 42);
+        BOOST_CHECK_EQUAL(std::get<1>(args), "abc");
+    });
+
+    procs.provide({boost::beast::http::verb::get, "/api/users/42/orders/abc", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(count, 1);
+
+} // BOOST_AUTO_TEST_CASE(param_no_1)
+
+BOOST_AUTO_TEST_CASE(use_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+    http::basic_router<test_session> users{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::size_t count = 0;
+
+    users.get("/:id", [&](auto request, auto /*context*/){
+        BOOST_CHECK(request.target() == "/api/users/7");
+        count++;
+    });
+
+    router.use("/api/users", users);
+
+    procs.provide({boost::beast::http::verb::get, "/api/users/7", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(count, 1);
+
+} // BOOST_AUTO_TEST_CASE(use_no_1)
+
+BOOST_AUTO_TEST_CASE(typed_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::size_t count = 0;
+
+    router.param<http::param::pack<int>>().get("/users/{id:int}",
+       [&](auto& /*request*/, auto /*context*/, auto args){
+        BOOST_CHECK_EQUAL(std::get<0>(args), -7);
+        count++;
+    });
+
+    router.param<http::param::pack<std::string>>().get("/users/{name}",
+       [&](auto& /*request*/, auto /*context*/, auto /*args*/){
+        count += 10;
+    });
+
+    router.param<http::param::pack<std::string>>().get("/static/{path:*}",
+       [&](auto& /*request*/, auto /*context*/, auto args){
+        BOOST_CHECK(std::get<0>(args) == "css/site.css" or std::get<0>(args).empty());
+        count += 100;
+    });
+
+    // None of them falls back to the regex scan
+    BOOST_CHECK(router.method_map()->at(boost::beast::http::verb::get).fallback().empty());
+
+    procs.provide({boost::beast::http::verb::get, "/users/-7", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(count, 11);
+
+    procs.provide({boost::beast::http::verb::get, "/users/bob", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(count, 21);
+
+    procs.provide({boost::beast::http::verb::get, "/static/css/site.css", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/static/", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(count, 221);
+
+} // BOOST_AUTO_TEST_CASE(typed_no_1)
@@ -0,0 +1,178 @@
+#define BOOST_TEST_MODULE route_cache_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/route_cache.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace _0xdead4ead;
+
+class test_session
+{
+public:
+
+    using self_type = test_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class test_session
+
+static const std::regex::flag_type regex_flags = std::regex::ECMAScript;
+
+using processor_type = http::base::request_processor<test_session>;
+
+using verb = boost::beast::http::verb;
+
+BOOST_AUTO_TEST_CASE(cache_no_1) {
+
+    using cache_type = http::base::route_cache<int, verb>;
+
+    BOOST_CHECK_EQUAL(cache_type{}.capacity(), 0);
+    BOOST_CHECK_EQUAL(cache_type{5}.capacity(), 8);
+
+    cache_type cache{8};
+
+    const int routes[2] = {};
+    const cache_type::tables_type tables{&routes[0], nullptr};
+
+    BOOST_CHECK(cache.find(1, tables, verb::get, "/a") == nullptr);
+    cache.insert(1, tables, verb::get, "/a", cache_type::routes_type{&routes[0], &routes[1]});
+
+    auto found = cache.find(1, tables, verb::get, "/a");
+    BOOST_REQUIRE(found != nullptr);
+    BOOST_CHECK_EQUAL(found->size(), 2);
+    BOOST_CHECK(found->front() == &routes[0]);
+
+    // Another generation, other tables, method or target are not the same entry
+    BOOST_CHECK(cache.find(2, tables, verb::get, "/a") == nullptr);
+    BOOST_CHECK(cache.find(1, cache_type::tables_type{nullptr, nullptr}, verb::get, "/a") == nullptr);
+    BOOST_CHECK(cache.find(1, tables, verb::post, "/a") == nullptr);
+    BOOST_CHECK(cache.find(1, tables, verb::get, "/b") == nullptr);
+
+    BOOST_CHECK_EQUAL(cache.hits(), 1);
+    BOOST_CHECK_EQUAL(cache.misses(), 5);
+
+    cache.insert(1, tables, verb::get, std::string(cache_type::max_target + 1, 'x'),
+                 cache_type::routes_type{});
+    BOOST_CHECK(cache.find(1, tables, verb::get, std::string(cache_type::max_target + 1, 'x')) == nullptr);
+
+} // BOOST_AUTO_TEST_CASE(cache_no_1)
+
+BOOST_AUTO_TEST_CASE(provide_no_1) {
+
+    processor_type::enable_cache(16);
+
+    http::basic_router<test_session> router{regex_flags};
+    http::basic_router<test_session> child{regex_flags};
+
+    processor_type procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<std::string> calls;
+
+    auto record = [&calls](std::string name){
+        return [&calls, name](auto request, auto /*context*/){
+            calls.push_back(name + " " + std::string{request.target()});
+        };
+    };
+
+    router.get("^/a$", record("a"));
+    router.get("^/(\\w+)$", record("word"));
+    router.mount("/child", child);
+    child.get("^/c$", record("c"));
+
+    const auto hits = processor_type::cache().hits();
+    const auto misses = processor_type::cache().misses();
+
+    // Both matches of /a are replayed from the cache
+    for (int i = 0; i < 3; ++i)
+        procs.provide({verb::get, "/a", 11}, test_session::flesh{});
+
+    BOOST_CHECK_EQUAL(calls.size(), 6);
+    BOOST_CHECK_EQUAL(processor_type::cache().hits() - hits, 2);
+    BOOST_CHECK_EQUAL(processor_type::cache().misses() - misses, 1);
+
+    procs.provide({verb::post, "/a", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(calls.size(), 6);
+
+    // A new route is seen at once
+    router.get("^/[a-z]$", record("letter"));
+
+    calls.clear();
+    procs.provide({verb::get, "/a", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(calls.size(), 3);
+
+    // So is a change of a mounted router
+    procs.provide({verb::get, "/child/c", 11}, test_session::flesh{});
+    procs.provide({verb::get, "/child/c", 11}, test_session::flesh{});
+    child.get("^/c$", record("c2"));
+
+    calls.clear();
+    procs.provide({verb::get, "/child/c", 11}, test_session::flesh{});
+    BOOST_CHECK((calls == std::vector<std::string>{"c2 /c"}));
+
+    processor_type::enable_cache(0);
+
+    BOOST_CHECK_EQUAL(processor_type::cache().capacity(), 0);
+
+    calls.clear();
+    procs.provide({verb::get, "/a", 11}, test_session::flesh{});
+    BOOST_CHECK_EQUAL(calls.size(), 3);
+
+} // BOOST_AUTO_TEST_CASE(provide_no_1)
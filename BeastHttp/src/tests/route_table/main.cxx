@@ -0,0 +1,223 @@
+#define BOOST_TEST_MODULE route_table_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/reactor/session.hxx>
+#include <http/basic_router.hxx>
+#include <http/pipeline.hxx>
+#include <http/route_table.hxx>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/http.hpp>
+
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+using namespace _0xdead4ead;
+
+class test_session
+{
+public:
+
+    using self_type = test_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class test_session
+
+static const std::regex::flag_type regex_flags = std::regex::ECMAScript;
+
+using namespace http::literals;
+
+using verb = boost::beast::http::verb;
+
+constexpr auto routes = http::make_route_index(
+            "/"_get, "/health"_get, "/users"_post, "/users"_get, "^/ping$"_all,
+            "/static/*"_get, "/static/img/*"_get);
+
+// The index is resolved by the compiler
+static_assert (routes.find(verb::get, "/", 1) == 0, "");
+static_assert (routes.find(verb::get, "/health", 7) == 1, "");
+static_assert (routes.find(verb::post, "/users", 6) == 2, "");
+static_assert (routes.find(verb::get, "/users", 6) == 3, "");
+static_assert (routes.find(verb::delete_, "/users", 6) == routes.size, "");
+static_assert (routes.find(verb::put, "/ping", 5) == 4, "");
+static_assert (routes.find(verb::get, "/static/site.css", 16) == 5, "");
+static_assert (routes.find(verb::get, "/static/img/logo.png", 20) == 6, "");
+static_assert (routes.find(verb::get, "/healthz", 8) == routes.size, "");
+
+// A dot is literal in a route index, not "any character"
+static_assert (http::make_route_index("/favicon.ico"_get).find(
+                   verb::get, "/favicon.ico", 12) == 0, "");
+static_assert (http::make_route_index("/favicon.ico"_get).find(
+                   verb::get, "/favicon-ico", 12) == 1, "");
+
+BOOST_AUTO_TEST_CASE(find_no_1) {
+
+    BOOST_CHECK_EQUAL(routes.size, 7);
+    BOOST_CHECK_EQUAL(routes[4].size, 5);
+    BOOST_CHECK(routes[5].prefix);
+
+    // Targets built at run time take the same path
+    std::string target = "/static/";
+    target += "img/a.png";
+    BOOST_CHECK_EQUAL(routes.find(verb::get, target.data(), target.size()), 6);
+
+    target = "/users";
+    BOOST_CHECK_EQUAL(routes.find(verb::get, target.data(), target.size()), 3);
+
+} // BOOST_AUTO_TEST_CASE(find_no_1)
+
+BOOST_AUTO_TEST_CASE(dispatch_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    std::vector<std::string> seen;
+
+    // Dynamic routes stay with the router
+    router.get("^/users/(\\d+)$", [&](auto& request, auto /*context*/){
+        seen.emplace_back(request.target().data(), request.target().size());
+    });
+
+    router.get("^/health$", [&](auto& /*request*/, auto /*context*/){
+        seen.push_back("router health");
+    });
+
+    auto record = [&](const char* name){
+        return [&seen, name](auto& /*request*/, auto /*context*/){
+            seen.push_back(name);
+        };
+    };
+
+    auto table = routes.bind(router, record("root"), record("health"),
+                             record("add user"), record("list users"), record("ping"),
+                             record("static"), http::make_pipeline(
+                                 [&](auto& /*request*/, auto /*context*/, auto next){
+        seen.push_back("img");
+        std::next(next)();
+    }, record("static img")));
+
+    test_session::flesh flesh;
+
+    for (auto const& request : std::vector<test_session::request_type>{
+             {verb::get, "/", 11}, {verb::get, "/health", 11}, {verb::post, "/users", 11},
+             {verb::get, "/users", 11}, {verb::options, "/ping", 11},
+             {verb::get, "/static/a.css", 11}, {verb::get, "/static/img/b.png", 11},
+             {verb::get, "/users/42", 11}, {verb::put, "/users", 11}}) {
+        test_session::request_type copy = request;
+        table.provide(copy, flesh);
+    }
+
+    BOOST_CHECK((seen == std::vector<std::string>{
+                     "root", "health", "add user", "list users", "ping",
+                     "static", "img", "static img", "/users/42"}));
+
+} // BOOST_AUTO_TEST_CASE(dispatch_no_1)
+
+BOOST_AUTO_TEST_CASE(session_no_1) {
+
+    using http_session = http::reactor::_default::session_type;
+
+    boost::asio::io_context ioc;
+
+    http::basic_router<http_session> router{regex_flags};
+
+    auto reply = [](std::string body){
+        return [body](auto& request, auto context){
+            boost::beast::http::response<boost::beast::http::string_body> response{
+                boost::beast::http::status::ok, request.version()};
+            response.body() = body + ' ' + request.target().to_string();
+            response.prepare_payload();
+            context.send(std::move(response));
+        };
+    };
+
+    router.get("^/health$", reply("router"));
+    router.get("^/users/(\\d+)$", reply("router"));
+
+    router.dispatch(http::make_route_index("/health"_get, "/static/*"_get).bind(
+                        router, reply("table"), reply("table")));
+
+    boost::asio::ip::tcp::acceptor acceptor{ioc, {boost::asio::ip::address_v4::loopback(), 0}};
+    acceptor.async_accept([&](boost::system::error_code ec, boost::asio::ip::tcp::socket socket){
+        if (not ec)
+            http_session::recv(std::move(socket), router);
+    });
+
+    std::thread thread{[&]{ ioc.run(); }};
+
+    boost::asio::ip::tcp::socket socket{ioc};
+    socket.connect(acceptor.local_endpoint());
+
+    boost::beast::flat_buffer buffer;
+
+    // Literal routes go through the table, the others through the router
+    for (auto const& expected : {std::make_pair("/health", "table /health"),
+                                 std::make_pair("/static/a.css", "table /static/a.css"),
+                                 std::make_pair("/users/42", "router /users/42")}) {
+        boost::beast::http::request<boost::beast::http::empty_body> request{
+            verb::get, expected.first, 11};
+        boost::beast::http::write(socket, request);
+
+        boost::beast::http::response<boost::beast::http::string_body> response;
+        boost::beast::http::read(socket, buffer, response);
+        BOOST_CHECK_EQUAL(response.body(), expected.second);
+    }
+
+    socket.close();
+    thread.join();
+
+} // BOOST_AUTO_TEST_CASE(session_no_1)
@@ -0,0 +1,119 @@
+#define BOOST_TEST_MODULE segment_pattern_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/regex.hxx>
+#include <http/base/segment_pattern.hxx>
+
+#include <string>
+#include <vector>
+
+using namespace _0xdead4ead;
+
+using segment_pattern = http::base::segment_pattern;
+
+static std::vector<std::string>
+captures(segment_pattern const& pattern, boost::beast::string_view target, bool& matched)
+{
+    std::vector<std::string> result;
+    matched = pattern.match(target, [&](boost::beast::string_view value){
+        result.emplace_back(value.data(), value.size());
+    });
+
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE(parse_no_1) {
+
+    segment_pattern::parts_type parts;
+
+    BOOST_CHECK(segment_pattern::parse("^/users/{id:int}/posts/{slug}$", parts));
+    BOOST_REQUIRE_EQUAL(parts.size(), 4);
+    BOOST_CHECK(parts[0].type == segment_pattern::kind::literal and parts[0].text == "/users/");
+    BOOST_CHECK(parts[1].type == segment_pattern::kind::integer and parts[1].text == "id");
+    BOOST_CHECK(parts[2].type == segment_pattern::kind::literal and parts[2].text == "/posts/");
+    BOOST_CHECK(parts[3].type == segment_pattern::kind::string and parts[3].text == "slug");
+
+    BOOST_CHECK(segment_pattern::parse("/a/:b/{c:uint}/{d:str}/{e:*}", parts));
+    BOOST_REQUIRE_EQUAL(parts.size(), 8);
+    BOOST_CHECK(parts[1].type == segment_pattern::kind::string);
+    BOOST_CHECK(parts[3].type == segment_pattern::kind::unsigned_integer);
+    BOOST_CHECK(parts[5].type == segment_pattern::kind::string);
+    BOOST_CHECK(parts[7].type == segment_pattern::kind::rest);
+
+    BOOST_CHECK(segment_pattern::parse("/plain/path", parts));
+    BOOST_CHECK_EQUAL(parts.size(), 1);
+
+    // Regular expressions and malformed segments are left to the regex engine
+    BOOST_CHECK(not segment_pattern::parse("/users/(\\d+)", parts));
+    BOOST_CHECK(not segment_pattern::parse("/users/{id:float}", parts));
+    BOOST_CHECK(not segment_pattern::parse("/users/{id}.json", parts));
+    BOOST_CHECK(not segment_pattern::parse("/files/{path:*}/x", parts));
+    BOOST_CHECK(not segment_pattern::parse("/a{2}", parts));
+
+} // BOOST_AUTO_TEST_CASE(parse_no_1)
+
+BOOST_AUTO_TEST_CASE(match_no_1) {
+
+    segment_pattern pattern;
+    BOOST_REQUIRE(pattern.assign("/users/{id:int}/posts/{slug}"));
+
+    bool matched = false;
+    auto values = captures(pattern, "/users/-42/posts/hello", matched);
+    BOOST_CHECK(matched);
+    BOOST_CHECK((values == std::vector<std::string>{"-42", "hello"}));
+
+    values = captures(pattern, "/users/abc/posts/hello", matched);
+    BOOST_CHECK(not matched);
+    BOOST_CHECK(values.empty());
+
+    captures(pattern, "/users/42/posts/", matched);
+    BOOST_CHECK(not matched);
+
+    captures(pattern, "/users/42/posts/a/b", matched);
+    BOOST_CHECK(not matched);
+
+    BOOST_REQUIRE(pattern.assign("/static/{path:*}"));
+
+    values = captures(pattern, "/static/css/site.css", matched);
+    BOOST_CHECK(matched);
+    BOOST_CHECK((values == std::vector<std::string>{"css/site.css"}));
+
+    values = captures(pattern, "/static/", matched);
+    BOOST_CHECK(matched);
+    BOOST_CHECK((values == std::vector<std::string>{""}));
+
+    BOOST_REQUIRE(pattern.assign("/n/{n:uint}"));
+    captures(pattern, "/n/7", matched);
+    BOOST_CHECK(matched);
+    captures(pattern, "/n/-7", matched);
+    BOOST_CHECK(not matched);
+
+} // BOOST_AUTO_TEST_CASE(match_no_1)
+
+BOOST_AUTO_TEST_CASE(expand_no_1) {
+
+    http::base::regex regex{std::regex::ECMAScript};
+
+    BOOST_CHECK_EQUAL(regex.expand("^/users/{id:int}/{name}$"),
+                      "^/users/([-+]?[0-9]+)/([^/]+)$");
+    BOOST_CHECK_EQUAL(regex.expand("/files/{path:*}"), "/files/(.*)");
+    BOOST_CHECK_EQUAL(regex.expand("/a/:b"), "/a/([^/]+)");
+    BOOST_CHECK_EQUAL(regex.expand("/\\d{2}"), "/\\d{2}");
+    BOOST_CHECK_EQUAL(regex.expand("^/a$"), "^/a$");
+    BOOST_CHECK_EQUAL(regex.expand("$"), "$");
+
+    // A regular expression is left as written, "/:x" and "/{x}" stay literal
+    BOOST_CHECK_EQUAL(regex.expand("/(\\d+)/:id"), "/(\\d+)/:id");
+    BOOST_CHECK_EQUAL(regex.expand("^/a/{name}/(\\w+)$"), "^/a/{name}/(\\w+)$");
+
+    std::cmatch what;
+    BOOST_CHECK(regex.match(regex.compile("/(\\d+)/:id"), "/5/:id", what));
+    BOOST_CHECK_EQUAL(what.size(), 2);
+    BOOST_CHECK(not regex.match(regex.compile("/(\\d+)/:id"), "/5/7"));
+
+    BOOST_CHECK(regex.match(regex.compile("/users/{id:uint}"), "/users/15"));
+    BOOST_CHECK(not regex.match(regex.compile("/users/{id:uint}"), "/users/x"));
+
+} // BOOST_AUTO_TEST_CASE(expand_no_1)
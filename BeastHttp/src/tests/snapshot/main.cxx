@@ -0,0 +1,291 @@
+#define BOOST_TEST_MODULE snapshot_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+#include <http/chain_router.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
+using namespace _0xdead4ead;
+
+class test_session
+{
+public:
+
+    using self_type = test_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class test_session
+
+using processor_type = http::base::request_processor<test_session>;
+
+static const std::regex::flag_type regex_flags = std::regex::ECMAScript;
+
+BOOST_AUTO_TEST_CASE(disabled_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    BOOST_CHECK(not router.snapshot());
+
+    processor_type procs{router.resource_map(), router.method_map(),
+                router.regex_flags(), router.snapshot()};
+
+    BOOST_CHECK(not procs.lock_free());
+
+    std::size_t invoked = 0;
+    router.get("^/a$", [&](auto /*request*/, auto /*context*/){
+        ++invoked;
+    });
+
+    procs.provide({boost::beast::http::verb::get, "/a", 11}, test_session::flesh{});
+
+    BOOST_CHECK(invoked == 1);
+
+} // BOOST_AUTO_TEST_CASE(disabled_no_1)
+
+BOOST_AUTO_TEST_CASE(publish_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    std::size_t invoked = 0;
+    router.get("^/a$", [&](auto /*request*/, auto /*context*/){
+        ++invoked;
+    });
+
+    router.enable_snapshot();
+
+    processor_type procs{router.resource_map(), router.method_map(),
+                router.regex_flags(), router.snapshot()};
+
+    BOOST_CHECK(procs.lock_free());
+
+    procs.provide({boost::beast::http::verb::get, "/a", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/b", 11}, test_session::flesh{});
+
+    BOOST_CHECK(invoked == 1);
+
+    // Routes added later are reached by walking the chain of snapshots
+    router.get("^/b$", [&](auto /*request*/, auto /*context*/){
+        invoked += 10;
+    });
+
+    router.all("^/c$", [&](auto /*request*/, auto /*context*/){
+        invoked += 100;
+    });
+
+    procs.provide({boost::beast::http::verb::get, "/b", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::post, "/c", 11}, test_session::flesh{});
+
+    BOOST_CHECK(invoked == 111);
+
+} // BOOST_AUTO_TEST_CASE(publish_no_1)
+
+BOOST_AUTO_TEST_CASE(publish_no_2) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    router.enable_snapshot();
+
+    auto first = router.snapshot();
+
+    BOOST_CHECK(not first->method_map());
+    BOOST_CHECK(not first->resource_map());
+
+    router.get("^/a$", [](auto /*request*/, auto /*context*/){});
+
+    auto second = router.snapshot();
+
+    // Published tables are never modified in place
+    BOOST_CHECK(first->stale());
+    BOOST_CHECK(first->next() == second);
+    BOOST_CHECK(not first->method_map());
+    BOOST_CHECK(not second->stale());
+    BOOST_CHECK(second->method_map()->size() == 1);
+    BOOST_CHECK(second->method_map().get() != router.method_map().get());
+
+} // BOOST_AUTO_TEST_CASE(publish_no_2)
+
+BOOST_AUTO_TEST_CASE(batch_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    router.enable_snapshot();
+
+    processor_type procs{router.resource_map(), router.method_map(),
+                router.regex_flags(), router.snapshot()};
+
+    auto first = router.snapshot();
+
+    std::size_t invoked = 0;
+    {
+        auto batch = router.batch();
+
+        router.get("^/a$", [&](auto /*request*/, auto /*context*/){
+            ++invoked;
+        });
+
+        {
+            auto nested = router.batch();
+
+            router.get("^/b$", [&](auto /*request*/, auto /*context*/){
+                invoked += 10;
+            });
+        }
+
+        // Nothing is published before the outermost batch ends
+        BOOST_CHECK(router.snapshot() == first);
+        BOOST_CHECK(not first->stale());
+
+        procs.provide({boost::beast::http::verb::get, "/a", 11}, test_session::flesh{});
+        BOOST_CHECK(invoked == 0);
+    }
+
+    // One snapshot holds every change of the batch
+    auto second = router.snapshot();
+    BOOST_CHECK(first->stale());
+    BOOST_CHECK(first->next() == second);
+    BOOST_CHECK(second->method_map()->at(boost::beast::http::verb::get).size() == 2);
+
+    procs.provide({boost::beast::http::verb::get, "/a", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::get, "/b", 11}, test_session::flesh{});
+    BOOST_CHECK(invoked == 11);
+
+    // A batch without changes publishes nothing
+    {
+        auto batch = router.batch();
+    }
+
+    BOOST_CHECK(router.snapshot() == second);
+
+} // BOOST_AUTO_TEST_CASE(batch_no_1)
+
+BOOST_AUTO_TEST_CASE(use_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    router.enable_snapshot();
+
+    processor_type procs{router.resource_map(), router.method_map(),
+                router.regex_flags(), router.snapshot()};
+
+    std::size_t invoked = 0;
+
+    http::chain_router<test_session> chain{regex_flags};
+    chain.route("/a")
+            .get([&](auto /*request*/, auto /*context*/){
+        ++invoked;
+    })
+            .post([&](auto /*request*/, auto /*context*/){
+        invoked += 10;
+    });
+
+    router.use("/api", chain);
+
+    procs.provide({boost::beast::http::verb::get, "/api/a", 11}, test_session::flesh{});
+    procs.provide({boost::beast::http::verb::post, "/api/a", 11}, test_session::flesh{});
+
+    BOOST_CHECK(invoked == 11);
+
+} // BOOST_AUTO_TEST_CASE(use_no_1)
+
+BOOST_AUTO_TEST_CASE(concurrent_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    std::atomic<std::size_t> invoked{0};
+    router.get("^/a$", [&](auto /*request*/, auto /*context*/){
+        ++invoked;
+    });
+
+    router.enable_snapshot();
+
+    static const std::size_t threads = 4, iterations = 2000, routes = 50;
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (std::size_t i = 0; i < threads; ++i)
+        readers.emplace_back([&](){
+            processor_type procs{router.resource_map(), router.method_map(),
+                        router.regex_flags(), router.snapshot()};
+
+            for (std::size_t n = 0; n < iterations; ++n)
+                procs.provide({boost::beast::http::verb::get, "/a", 11}, test_session::flesh{});
+
+            while (not done)
+                std::this_thread::yield();
+
+            // After the last publication every reader sees all routes
+            procs.provide({boost::beast::http::verb::get,
+                           "/r" + std::to_string(routes - 1), 11}, test_session::flesh{});
+        });
+
+    for (std::size_t i = 0; i < routes; ++i)
+        router.get("^/r" + std::to_string(i) + "$", [&](auto /*request*/, auto /*context*/){
+            ++invoked;
+        });
+
+    done = true;
+
+    for (auto& reader : readers)
+        reader.join();
+
+    BOOST_CHECK(invoked == threads * (iterations + 1));
+
+} // BOOST_AUTO_TEST_CASE(concurrent_no_1)
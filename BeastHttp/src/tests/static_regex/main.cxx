@@ -0,0 +1,184 @@
+#define BOOST_TEST_MODULE static_regex_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/cb.hxx>
+#include <http/base/route.hxx>
+#include <http/base/static_regex.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/literals.hxx>
+#include <http/basic_router.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace _0xdead4ead;
+using namespace http::literals;
+
+class test_session
+{
+public:
+
+    using self_type = test_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::static_regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = std::map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class test_session
+
+static const std::regex::flag_type regex_flags = std::regex::ECMAScript;
+
+using verb = boost::beast::http::verb;
+
+// The generated code has to agree with base::regex on every target
+template<class Pattern>
+static void
+check(Pattern pattern, std::vector<std::string> const& targets)
+{
+    const std::string text = pattern;
+    http::base::regex runtime{regex_flags};
+    const auto expression = runtime.compile(text);
+
+    for (auto const& target : targets)
+        BOOST_CHECK_MESSAGE(Pattern::match(target.data(), target.data() + target.size())
+                            == runtime.match(expression, target),
+                            text << " on " << target);
+}
+
+BOOST_AUTO_TEST_CASE(match_no_1) {
+
+    const std::vector<std::string> targets{
+        "", "/", "/a", "/a/", "/ab", "/a/b", "/users", "/users/", "/users/42",
+        "/users/-42", "/users/+7", "/users/x", "/users/42/posts/hello", "/users/42/posts/",
+        "/files/a/b.txt", "/files/", "/AbC_9", "/x.json", "/xjson", "/aaa", "/aaaa",
+        "/api/v1/items?limit=10", "/api/v2/items", "/b/b/b/"};
+
+    check("^/$"_re, targets);
+    check("^/a$"_re, targets);
+    check("/users"_re, targets);
+    check("^/users/(\\d+)$"_re, targets);
+    check("^/users/([-+]?[0-9]+)/posts/([^/]+)$"_re, targets);
+    check("^/users/{id:int}$"_re, targets);
+    check("^/users/{id:uint}$"_re, targets);
+    check("^/users/:id$"_re, targets);
+    check("^/users/{id}/posts/{slug:str}$"_re, targets);
+    check("^/files/{path:*}$"_re, targets);
+    check("^/files/.*$"_re, targets);
+    check("^/[A-Za-z_][\\w]*$"_re, targets);
+    check("^/x\\.json$"_re, targets);
+    check("^/a{2,3}$"_re, targets);
+    check("^/a{3}$"_re, targets);
+    check("^/a{2,}$"_re, targets);
+    check("^/(a|ab|users)$"_re, targets);
+    check("^/(?:a/?)+$"_re, targets);
+    check("^(/b)*/?$"_re, targets);
+    check("^/api/v[12]/items(\\?.*)?$"_re, targets);
+    check("^/users/?(\\d*)$"_re, targets);
+    check("^[^/]*/\\S+$"_re, targets);
+    check("^/(a*)*$"_re, targets);
+    check("^/users|^/a$"_re, targets);
+    check("^.*?/posts/.+$"_re, targets);
+
+} // BOOST_AUTO_TEST_CASE(match_no_1)
+
+BOOST_AUTO_TEST_CASE(compile_no_1) {
+
+    http::base::static_regex regex{regex_flags};
+
+    const std::string pattern = "^/compile/(\\d+)$"_re;
+    BOOST_CHECK(regex.compile(pattern).generated());
+    BOOST_CHECK(regex.match(regex.compile(pattern), "/compile/15"));
+    BOOST_CHECK(not regex.match(regex.compile(pattern), "/compile/x"));
+
+    // Runtime strings and icase routers go through std::regex
+    BOOST_CHECK(not regex.compile("^/compile/([a-z]+)$").generated());
+    BOOST_CHECK(regex.match(regex.compile("^/compile/([a-z]+)$"), "/compile/x"));
+
+    http::base::static_regex icase{regex_flags | std::regex::icase};
+    BOOST_CHECK(not icase.compile(pattern).generated());
+    BOOST_CHECK(icase.match(icase.compile("^/COMPILE/(\\d+)$"_re), "/compile/15"));
+
+} // BOOST_AUTO_TEST_CASE(compile_no_1)
+
+BOOST_AUTO_TEST_CASE(router_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<std::string> calls;
+
+    router.get("^/users/{id:int}$"_re, [&calls](auto request, auto /*context*/){
+        calls.push_back("user " + std::string{request.target()});
+    });
+
+    router.get(std::string{"^/runtime$"}, [&calls](auto request, auto /*context*/){
+        calls.push_back("runtime " + std::string{request.target()});
+    });
+
+    "^/literal$"_get.advance(router, [&calls](auto request, auto /*context*/){
+        calls.push_back("literal " + std::string{request.target()});
+    });
+
+    BOOST_CHECK(router.method_map()->at(verb::get).at("^/users/{id:int}$").regex().generated());
+    BOOST_CHECK(not router.method_map()->at(verb::get).at("^/runtime$").regex().generated());
+
+    procs.provide({verb::get, "/users/7", 11}, test_session::flesh{});
+    procs.provide({verb::get, "/users/x", 11}, test_session::flesh{});
+    procs.provide({verb::get, "/runtime", 11}, test_session::flesh{});
+    procs.provide({verb::get, "/literal", 11}, test_session::flesh{});
+
+    BOOST_CHECK((calls == std::vector<std::string>{"user /users/7", "runtime /runtime",
+                                                    "literal /literal"}));
+
+} // BOOST_AUTO_TEST_CASE(router_no_1)
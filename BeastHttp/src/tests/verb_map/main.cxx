@@ -0,0 +1,177 @@
+#define BOOST_TEST_MODULE verb_map_test
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <http/base/cb.hxx>
+#include <http/base/regex.hxx>
+#include <http/base/route.hxx>
+#include <http/base/verb_map.hxx>
+#include <http/base/request_processor.hxx>
+
+#include <http/basic_router.hxx>
+#include <http/chain_router.hxx>
+
+#include <boost/beast/http.hpp>
+
+#include <unordered_map>
+
+using namespace _0xdead4ead;
+
+class test_session
+{
+public:
+
+    using self_type = test_session;
+
+    template<class>
+    class context;
+
+    class flesh;
+
+    using flesh_type = flesh;
+
+    using context_type = context<flesh_type>;
+
+    using resource_regex_type = std::string;
+
+    using resource_type = boost::beast::string_view;
+
+    using method_type = boost::beast::http::verb;
+
+    using body_type = boost::beast::http::string_body;
+
+    using cbexecutor_type = http::base::cb::executor;
+
+    using request_type = boost::beast::http::request<body_type>;
+
+    using regex_type = http::base::regex;
+
+    using regex_flag_type = typename regex_type::flag_type;
+
+    using storage_type = http::base::cb::storage<self_type, std::function, std::vector>;
+
+    using route_type = http::base::route<regex_type, storage_type>;
+
+    using resource_map_type = std::unordered_map<resource_regex_type, route_type>;
+
+    using method_map_type = http::base::verb_map<method_type, resource_map_type>;
+
+    class flesh
+    {
+    };
+
+    template<class Flesh>
+    class context
+    {
+    public:
+
+        context(Flesh&)
+        {
+        }
+    };
+
+}; // class test_session
+
+static const std::regex::flag_type regex_flags = std::regex::ECMAScript;
+
+using verb = boost::beast::http::verb;
+
+BOOST_AUTO_TEST_CASE(container_no_1) {
+
+    http::base::verb_map<verb, int> map;
+
+    BOOST_CHECK(map.empty());
+    BOOST_CHECK(map.begin() == map.end());
+    BOOST_CHECK(map.find(verb::get) == map.cend());
+
+    BOOST_CHECK(map.insert({verb::post, 2}).second);
+    BOOST_CHECK(map.emplace(verb::get, 1).second);
+    BOOST_CHECK(not map.insert({verb::get, 10}).second);
+
+    map[verb::unlink] = 3;
+    map[verb::unknown] = 0;
+
+    BOOST_CHECK_EQUAL(map.size(), 4);
+    BOOST_CHECK_EQUAL(map.at(verb::get), 1);
+    BOOST_CHECK_EQUAL(map.find(verb::post)->second, 2);
+    BOOST_CHECK(map.find(verb::put) == map.end());
+    BOOST_CHECK_THROW(map.at(verb::put), std::out_of_range);
+
+    // Same order as std::map
+    std::vector<verb> keys;
+    for (const auto& value : map)
+        keys.push_back(value.first);
+
+    BOOST_CHECK((keys == std::vector<verb>{verb::unknown, verb::get, verb::post, verb::unlink}));
+
+    const auto copy = map;
+    map.at(verb::get) = 100;
+
+    BOOST_CHECK_EQUAL(copy.at(verb::get), 1);
+    BOOST_CHECK_EQUAL(copy.size(), 4);
+
+    http::base::verb_map<verb, int>::const_iterator pos = map.find(verb::get);
+    BOOST_CHECK_EQUAL(pos->second, 100);
+    BOOST_CHECK(++pos == map.find(verb::post));
+
+} // BOOST_AUTO_TEST_CASE(container_no_1)
+
+BOOST_AUTO_TEST_CASE(router_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<std::string> invoked;
+
+    router.get("^/a$", [&](auto /*request*/, auto /*context*/){
+        invoked.push_back("get");
+    });
+
+    router.delete_("^/a$", [&](auto /*request*/, auto /*context*/){
+        invoked.push_back("delete");
+    });
+
+    router.all("^/a$", [&](auto /*request*/, auto /*context*/){
+        invoked.push_back("all");
+    });
+
+    procs.provide({verb::get, "/a", 11}, test_session::flesh{});
+    procs.provide({verb::delete_, "/a", 11}, test_session::flesh{});
+    procs.provide({verb::patch, "/a", 11}, test_session::flesh{});
+    procs.provide({verb::unknown, "/a", 11}, test_session::flesh{});
+
+    BOOST_CHECK((invoked == std::vector<std::string>{"get", "delete", "all", "all"}));
+    BOOST_CHECK_EQUAL(router.method_map()->size(), 2);
+
+} // BOOST_AUTO_TEST_CASE(router_no_1)
+
+BOOST_AUTO_TEST_CASE(use_no_1) {
+
+    http::basic_router<test_session> router{regex_flags};
+
+    http::base::request_processor<test_session>
+            procs{router.resource_map(), router.method_map(), router.regex_flags()};
+
+    std::vector<std::string> invoked;
+
+    http::chain_router<test_session> chain{regex_flags};
+    chain.route("/users")
+            .get([&](auto /*request*/, auto /*context*/){
+        invoked.push_back("get");
+    })
+            .put([&](auto /*request*/, auto /*context*/){
+        invoked.push_back("put");
+    });
+
+    router.use("^/api$", chain);
+
+    procs.provide({verb::put, "/api/users", 11}, test_session::flesh{});
+    procs.provide({verb::get, "/api/users", 11}, test_session::flesh{});
+    procs.provide({verb::post, "/api/users", 11}, test_session::flesh{});
+
+    BOOST_CHECK((invoked == std::vector<std::string>{"put", "get"}));
+
+} // BOOST_AUTO_TEST_CASE(use_no_1)